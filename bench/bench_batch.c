@@ -0,0 +1,80 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench_common.h"
+#include "simple_data_ringbuffer.h"
+
+/*
+ * Burst put/get of items through simple_data_ringbuffer_t on one thread: one call per item
+ * ("single") against simple_data_ringbuffer_put_n/get_n ("batch").
+ */
+
+#define BENCH_RING_CNT      1021
+#define BENCH_BURST_CNT     256
+#define BENCH_MAX_ITEM_SIZE 64
+#define BENCH_DEFAULT_COUNT 20000000
+
+static uint8_t bench_storage[BENCH_RING_CNT * BENCH_MAX_ITEM_SIZE];
+static uint8_t bench_in[BENCH_BURST_CNT * BENCH_MAX_ITEM_SIZE];
+static uint8_t bench_out[BENCH_BURST_CNT * BENCH_MAX_ITEM_SIZE];
+
+static void bench_single(simple_data_ringbuffer_t *ringbuf, uint16_t item_size)
+{
+    for (int i = 0; i < BENCH_BURST_CNT; i++)
+    {
+        simple_data_ringbuffer_put(ringbuf, bench_in + i * item_size);
+    }
+    for (int i = 0; i < BENCH_BURST_CNT; i++)
+    {
+        simple_data_ringbuffer_get(ringbuf, bench_out + i * item_size);
+    }
+}
+
+static void bench_batch(simple_data_ringbuffer_t *ringbuf, uint16_t item_size)
+{
+    (void)item_size;
+    simple_data_ringbuffer_put_n(ringbuf, bench_in, BENCH_BURST_CNT);
+    simple_data_ringbuffer_get_n(ringbuf, bench_out, BENCH_BURST_CNT);
+}
+
+static void bench_run(const char *variant, void (*burst)(simple_data_ringbuffer_t *, uint16_t),
+                      uint16_t item_size, uint64_t count)
+{
+    simple_data_ringbuffer_t ringbuf;
+    uint64_t bursts = count / BENCH_BURST_CNT;
+
+    simple_data_ringbuffer_init(&ringbuf, BENCH_RING_CNT, item_size, bench_storage);
+
+    uint64_t begin = bench_now_ns();
+    for (uint64_t i = 0; i < bursts; i++)
+    {
+        bench_in[0] = (uint8_t)i;
+        burst(&ringbuf, item_size);
+        if (bench_out[0] != (uint8_t)i)
+        {
+            printf("batch,%s,%u: data mismatch\n", variant, item_size);
+            exit(1);
+        }
+    }
+    double seconds = (double)(bench_now_ns() - begin) / 1e9;
+    uint64_t ops = bursts * BENCH_BURST_CNT;
+
+    printf("batch,%s,%u,%u,%u,%llu,%.6f,%.3f,%.3f\n", variant, item_size, BENCH_RING_CNT,
+           BENCH_BURST_CNT, (unsigned long long)ops, seconds, ops / seconds / 1e6,
+           ops * item_size / seconds / 1e9);
+}
+
+int main(int argc, char *argv[])
+{
+    uint64_t count = argc > 1 ? strtoull(argv[1], NULL, 0) : BENCH_DEFAULT_COUNT;
+    static const uint16_t item_sizes[] = {4, 8, 16, 32, 64};
+
+    printf("bench,variant,item_size,capacity,burst,items,seconds,mitems_per_sec,gbytes_per_sec\n");
+    for (size_t i = 0; i < sizeof(item_sizes) / sizeof(item_sizes[0]); i++)
+    {
+        bench_run("single", bench_single, item_sizes[i], count);
+        bench_run("batch", bench_batch, item_sizes[i], count);
+    }
+
+    return 0;
+}
@@ -0,0 +1,145 @@
+#ifndef _BENCH_COMMON_H_
+#define _BENCH_COMMON_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+/**
+ * @brief  Monotonic time in nanoseconds.
+ */
+static inline uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief  Timestamp counter: TSC on x86 (constant rate reference cycles), the virtual counter on
+ *         AArch64 (a fixed frequency timer, not core cycles), nanoseconds elsewhere.
+ */
+static inline uint64_t bench_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#elif defined(__aarch64__)
+    uint64_t value;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(value));
+    return value;
+#else
+    return bench_now_ns();
+#endif
+}
+
+/**
+ * @brief  Back off in a spin loop, give the core away once spinning is not paying off.
+ * @param  [inout] spins: Spin counter of the caller, reset it to 0 after progress.
+ */
+static inline void bench_relax(uint32_t *spins)
+{
+    if (++(*spins) >= 64)
+    {
+        *spins = 0;
+        sched_yield();
+    }
+}
+
+/**
+ * @brief  Pin the calling thread to a cpu, ignored when the cpu does not exist.
+ */
+static inline void bench_pin_thread(int cpu)
+{
+#ifdef __linux__
+    cpu_set_t set;
+
+    if (cpu < 0 || cpu >= sysconf(_SC_NPROCESSORS_ONLN))
+    {
+        return;
+    }
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)cpu;
+#endif
+}
+
+#define BENCH_PERF_L1D_MISS 0
+#define BENCH_PERF_LLC_MISS 1
+
+/**
+ * @brief  Open a hardware cache miss counter for the calling thread.
+ * @param  [in] event: BENCH_PERF_L1D_MISS or BENCH_PERF_LLC_MISS.
+ * @return The counter fd, -1 if the counter is not available (no PMU, perf_event_paranoid...).
+ */
+static inline int bench_perf_open(int event)
+{
+#ifdef __linux__
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    if (event == BENCH_PERF_L1D_MISS)
+    {
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    }
+    else
+    {
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    }
+
+    int fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+    if (fd >= 0)
+    {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+    return fd;
+#else
+    (void)event;
+    return -1;
+#endif
+}
+
+/**
+ * @brief  Stop and read a counter opened by bench_perf_open().
+ * @return The counter value, 0 if fd is invalid.
+ */
+static inline uint64_t bench_perf_close(int fd)
+{
+    uint64_t value = 0;
+
+    if (fd < 0)
+    {
+        return 0;
+    }
+#ifdef __linux__
+    ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    if (read(fd, &value, sizeof(value)) != sizeof(value))
+    {
+        value = 0;
+    }
+#endif
+    close(fd);
+    return value;
+}
+
+#endif /* _BENCH_COMMON_H_ */
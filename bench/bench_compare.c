@@ -0,0 +1,532 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <stdatomic.h>
+
+#include "bench_common.h"
+#include "simple_data_ringbuffer.h"
+#include "simple_ringbuffer.h"
+
+#if !SIMPLE_RINGBUFFER_SPSC
+#error "bench_compare needs SIMPLE_RINGBUFFER_SPSC=1"
+#endif
+
+/*
+ * The same workloads against simple_ringbuffer_t ("simple_byte"), simple_data_ringbuffer_t
+ * ("simple_data") and three reimplementations of the designs the README compares with:
+ *   - "kfifo": Linux kfifo, free running unsigned in/out and a power of 2 mask, a capacity
+ *     which is not a power of 2 is rounded up like kfifo_alloc() does,
+ *   - "rtthread": rt-thread rt_ringbuffer, 15 bit indices plus a mirror bit in bitfields, any
+ *     size up to 32 KB, single thread only (no barrier, the bitfields share a word),
+ *   - "mutex": an array of items guarded by a pthread mutex.
+ * Workloads:
+ *   - "single": one thread, BENCH_BURST_CNT puts then BENCH_BURST_CNT gets,
+ *   - "spsc": a producer and a consumer thread.
+ * One op is an item put and get. cycles_per_op is in timestamp counter cycles.
+ */
+
+#define BENCH_BURST_CNT     16
+#define BENCH_MAX_ITEM_SIZE 256
+#define BENCH_MAX_CAPACITY  1024
+#define BENCH_DEFAULT_COUNT 4000000
+
+typedef struct bench_impl
+{
+    const char *name;
+    int spsc; /* Safe with one producer and one consumer thread */
+    /* capacity items of item_size bytes, returns the capacity really used, 0 if not supported */
+    uint32_t (*init)(uint32_t capacity, uint32_t item_size);
+    int (*put)(const void *item);
+    int (*get)(void *item);
+} bench_impl_t;
+
+static uint8_t bench_storage[BENCH_MAX_CAPACITY * BENCH_MAX_ITEM_SIZE];
+static uint32_t bench_item_size;
+
+/* ---- simple_ringbuffer_t, item_size bytes per put ---- */
+
+static simple_ringbuffer_t bench_byte_ring;
+
+static uint32_t simple_byte_init(uint32_t capacity, uint32_t item_size)
+{
+    simple_ringbuffer_init(&bench_byte_ring, capacity * item_size, bench_storage);
+    return capacity;
+}
+
+static int simple_byte_put(const void *item)
+{
+    if (simple_ringbuffer_reserve_size(&bench_byte_ring) < bench_item_size)
+    {
+        return 0;
+    }
+    return simple_ringbuffer_put(&bench_byte_ring, (uint8_t *)item, bench_item_size) != 0;
+}
+
+static int simple_byte_get(void *item)
+{
+    return simple_ringbuffer_get(&bench_byte_ring, item, bench_item_size) != 0;
+}
+
+/* ---- simple_data_ringbuffer_t ---- */
+
+static simple_data_ringbuffer_t bench_data_ring;
+
+static uint32_t simple_data_init(uint32_t capacity, uint32_t item_size)
+{
+    simple_data_ringbuffer_init(&bench_data_ring, capacity, item_size, bench_storage);
+    return capacity;
+}
+
+static int simple_data_put(const void *item)
+{
+    return simple_data_ringbuffer_put(&bench_data_ring, (void *)item);
+}
+
+static int simple_data_get(void *item)
+{
+    return simple_data_ringbuffer_get(&bench_data_ring, item);
+}
+
+/* ---- kfifo: lib/kfifo.c __kfifo_in()/__kfifo_out() with esize elements ---- */
+
+typedef struct kfifo
+{
+    _Alignas(64) atomic_uint in;
+    _Alignas(64) atomic_uint out;
+    _Alignas(64) unsigned int mask;
+    unsigned int esize;
+    uint8_t *data;
+} kfifo_t;
+
+static kfifo_t bench_kfifo;
+
+static uint32_t kfifo_init(uint32_t capacity, uint32_t item_size)
+{
+    uint32_t size = 1;
+
+    /* roundup_pow_of_two() */
+    while (size < capacity)
+    {
+        size <<= 1;
+    }
+    if (size > BENCH_MAX_CAPACITY)
+    {
+        return 0;
+    }
+    atomic_init(&bench_kfifo.in, 0);
+    atomic_init(&bench_kfifo.out, 0);
+    bench_kfifo.mask = size - 1;
+    bench_kfifo.esize = item_size;
+    bench_kfifo.data = bench_storage;
+
+    return size;
+}
+
+static void kfifo_copy_in(kfifo_t *fifo, const void *src, unsigned int len, unsigned int off)
+{
+    unsigned int size = fifo->mask + 1;
+    unsigned int esize = fifo->esize;
+    unsigned int l;
+
+    off &= fifo->mask;
+    if (esize != 1)
+    {
+        off *= esize;
+        size *= esize;
+        len *= esize;
+    }
+    l = len < size - off ? len : size - off;
+
+    memcpy(fifo->data + off, src, l);
+    memcpy(fifo->data, (const uint8_t *)src + l, len - l);
+}
+
+static void kfifo_copy_out(kfifo_t *fifo, void *dst, unsigned int len, unsigned int off)
+{
+    unsigned int size = fifo->mask + 1;
+    unsigned int esize = fifo->esize;
+    unsigned int l;
+
+    off &= fifo->mask;
+    if (esize != 1)
+    {
+        off *= esize;
+        size *= esize;
+        len *= esize;
+    }
+    l = len < size - off ? len : size - off;
+
+    memcpy(dst, fifo->data + off, l);
+    memcpy((uint8_t *)dst + l, fifo->data, len - l);
+}
+
+static unsigned int kfifo_in(kfifo_t *fifo, const void *buf, unsigned int len)
+{
+    unsigned int in = atomic_load_explicit(&fifo->in, memory_order_relaxed);
+    unsigned int out = atomic_load_explicit(&fifo->out, memory_order_acquire);
+    unsigned int l = (fifo->mask + 1) - (in - out);
+
+    if (len > l)
+    {
+        len = l;
+    }
+    kfifo_copy_in(fifo, buf, len, in);
+    /* smp_wmb() then fifo->in += len */
+    atomic_store_explicit(&fifo->in, in + len, memory_order_release);
+
+    return len;
+}
+
+static unsigned int kfifo_out(kfifo_t *fifo, void *buf, unsigned int len)
+{
+    unsigned int out = atomic_load_explicit(&fifo->out, memory_order_relaxed);
+    unsigned int in = atomic_load_explicit(&fifo->in, memory_order_acquire);
+    unsigned int l = in - out;
+
+    if (len > l)
+    {
+        len = l;
+    }
+    kfifo_copy_out(fifo, buf, len, out);
+    /* smp_wmb() then fifo->out += len */
+    atomic_store_explicit(&fifo->out, out + len, memory_order_release);
+
+    return len;
+}
+
+static int kfifo_put(const void *item)
+{
+    return kfifo_in(&bench_kfifo, item, 1) != 0;
+}
+
+static int kfifo_get(void *item)
+{
+    return kfifo_out(&bench_kfifo, item, 1) != 0;
+}
+
+/* ---- rt-thread: components/drivers/ipc/ringbuffer.c, item_size bytes per put ---- */
+
+typedef struct rt_ringbuffer
+{
+    uint8_t *buffer_ptr;
+    uint16_t read_mirror : 1;
+    uint16_t read_index : 15;
+    uint16_t write_mirror : 1;
+    uint16_t write_index : 15;
+    int16_t buffer_size;
+} rt_ringbuffer_t;
+
+static rt_ringbuffer_t bench_rt_ring;
+
+static uint32_t rtthread_init(uint32_t capacity, uint32_t item_size)
+{
+    /* buffer_size is an int16_t, rt_ringbuffer_init() aligns it down to 4 bytes */
+    if (capacity * item_size > 0x7ffc)
+    {
+        return 0;
+    }
+    bench_rt_ring.buffer_ptr = bench_storage;
+    bench_rt_ring.read_mirror = bench_rt_ring.read_index = 0;
+    bench_rt_ring.write_mirror = bench_rt_ring.write_index = 0;
+    bench_rt_ring.buffer_size = (int16_t)((capacity * item_size) & ~3u);
+
+    return capacity;
+}
+
+static uint32_t rt_ringbuffer_data_len(rt_ringbuffer_t *rb)
+{
+    if (rb->read_index == rb->write_index)
+    {
+        return rb->read_mirror == rb->write_mirror ? 0 : (uint32_t)rb->buffer_size;
+    }
+    if (rb->write_index > rb->read_index)
+    {
+        return rb->write_index - rb->read_index;
+    }
+    return rb->buffer_size - (rb->read_index - rb->write_index);
+}
+
+static uint32_t rt_ringbuffer_put(rt_ringbuffer_t *rb, const uint8_t *ptr, uint32_t length)
+{
+    uint32_t space_length = rb->buffer_size - rt_ringbuffer_data_len(rb);
+
+    if (space_length == 0)
+    {
+        return 0;
+    }
+    if (space_length < length)
+    {
+        length = space_length;
+    }
+    if ((uint32_t)rb->buffer_size - rb->write_index > length)
+    {
+        memcpy(&rb->buffer_ptr[rb->write_index], ptr, length);
+        rb->write_index += length;
+        return length;
+    }
+
+    memcpy(&rb->buffer_ptr[rb->write_index], &ptr[0], rb->buffer_size - rb->write_index);
+    memcpy(&rb->buffer_ptr[0], &ptr[rb->buffer_size - rb->write_index],
+           length - (rb->buffer_size - rb->write_index));
+    /* we are going into the other side of the mirror */
+    rb->write_mirror = ~rb->write_mirror;
+    rb->write_index = length - (rb->buffer_size - rb->write_index);
+
+    return length;
+}
+
+static uint32_t rt_ringbuffer_get(rt_ringbuffer_t *rb, uint8_t *ptr, uint32_t length)
+{
+    uint32_t size = rt_ringbuffer_data_len(rb);
+
+    if (size == 0)
+    {
+        return 0;
+    }
+    if (size < length)
+    {
+        length = size;
+    }
+    if ((uint32_t)rb->buffer_size - rb->read_index > length)
+    {
+        memcpy(ptr, &rb->buffer_ptr[rb->read_index], length);
+        rb->read_index += length;
+        return length;
+    }
+
+    memcpy(&ptr[0], &rb->buffer_ptr[rb->read_index], rb->buffer_size - rb->read_index);
+    memcpy(&ptr[rb->buffer_size - rb->read_index], &rb->buffer_ptr[0],
+           length - (rb->buffer_size - rb->read_index));
+    /* we are going into the other side of the mirror */
+    rb->read_mirror = ~rb->read_mirror;
+    rb->read_index = length - (rb->buffer_size - rb->read_index);
+
+    return length;
+}
+
+static int rtthread_put(const void *item)
+{
+    if (bench_rt_ring.buffer_size - rt_ringbuffer_data_len(&bench_rt_ring) < bench_item_size)
+    {
+        return 0;
+    }
+    return rt_ringbuffer_put(&bench_rt_ring, item, bench_item_size) != 0;
+}
+
+static int rtthread_get(void *item)
+{
+    return rt_ringbuffer_get(&bench_rt_ring, item, bench_item_size) != 0;
+}
+
+/* ---- mutex: head, tail and count under one lock ---- */
+
+typedef struct mutex_queue
+{
+    pthread_mutex_t lock;
+    uint32_t head;
+    uint32_t tail;
+    uint32_t count;
+    uint32_t capacity;
+} mutex_queue_t;
+
+static mutex_queue_t bench_mutex_queue = {.lock = PTHREAD_MUTEX_INITIALIZER};
+
+static uint32_t mutex_init(uint32_t capacity, uint32_t item_size)
+{
+    (void)item_size;
+    bench_mutex_queue.head = bench_mutex_queue.tail = bench_mutex_queue.count = 0;
+    bench_mutex_queue.capacity = capacity;
+
+    return capacity;
+}
+
+static int mutex_put(const void *item)
+{
+    int ok = 0;
+
+    pthread_mutex_lock(&bench_mutex_queue.lock);
+    if (bench_mutex_queue.count < bench_mutex_queue.capacity)
+    {
+        memcpy(bench_storage + (size_t)bench_mutex_queue.tail * bench_item_size, item,
+               bench_item_size);
+        if (++bench_mutex_queue.tail == bench_mutex_queue.capacity)
+        {
+            bench_mutex_queue.tail = 0;
+        }
+        bench_mutex_queue.count++;
+        ok = 1;
+    }
+    pthread_mutex_unlock(&bench_mutex_queue.lock);
+
+    return ok;
+}
+
+static int mutex_get(void *item)
+{
+    int ok = 0;
+
+    pthread_mutex_lock(&bench_mutex_queue.lock);
+    if (bench_mutex_queue.count != 0)
+    {
+        memcpy(item, bench_storage + (size_t)bench_mutex_queue.head * bench_item_size,
+               bench_item_size);
+        if (++bench_mutex_queue.head == bench_mutex_queue.capacity)
+        {
+            bench_mutex_queue.head = 0;
+        }
+        bench_mutex_queue.count--;
+        ok = 1;
+    }
+    pthread_mutex_unlock(&bench_mutex_queue.lock);
+
+    return ok;
+}
+
+/* ---- workloads ---- */
+
+static const bench_impl_t bench_impls[] = {
+        {"simple_byte", 1, simple_byte_init, simple_byte_put, simple_byte_get},
+        {"simple_data", 1, simple_data_init, simple_data_put, simple_data_get},
+        {"kfifo", 1, kfifo_init, kfifo_put, kfifo_get},
+        {"rtthread", 0, rtthread_init, rtthread_put, rtthread_get},
+        {"mutex", 1, mutex_init, mutex_put, mutex_get},
+};
+
+static uint64_t bench_check;
+
+static void bench_report(const bench_impl_t *impl, const char *workload, uint32_t capacity,
+                         uint32_t used_capacity, uint64_t ops, uint64_t begin, uint64_t cycles)
+{
+    double seconds = (double)(bench_now_ns() - begin) / 1e9;
+
+    printf("compare,%s,%s,%u,%u,%u,%llu,%.6f,%.3f,%.1f,%llu\n", impl->name, workload,
+           bench_item_size, capacity, used_capacity, (unsigned long long)ops, seconds,
+           (double)ops / seconds / 1e6, (double)cycles / (double)ops,
+           (unsigned long long)bench_check);
+}
+
+static void bench_single(const bench_impl_t *impl, uint32_t capacity, uint64_t count)
+{
+    uint8_t in[BENCH_MAX_ITEM_SIZE];
+    uint8_t out[BENCH_MAX_ITEM_SIZE];
+    uint32_t used_capacity = impl->init(capacity, bench_item_size);
+    uint64_t ops = count / BENCH_BURST_CNT * BENCH_BURST_CNT;
+
+    if (used_capacity == 0)
+    {
+        return;
+    }
+    memset(in, 0x5a, sizeof(in));
+
+    uint64_t begin = bench_now_ns();
+    uint64_t cycles = bench_cycles();
+    for (uint64_t i = 0; i < ops; i += BENCH_BURST_CNT)
+    {
+        for (int j = 0; j < BENCH_BURST_CNT; j++)
+        {
+            in[0] = (uint8_t)j;
+            impl->put(in);
+        }
+        for (int j = 0; j < BENCH_BURST_CNT; j++)
+        {
+            impl->get(out);
+            bench_check += out[0];
+        }
+    }
+    cycles = bench_cycles() - cycles;
+    bench_report(impl, "single", capacity, used_capacity, ops, begin, cycles);
+}
+
+typedef struct bench_spsc_case
+{
+    const bench_impl_t *impl;
+    uint64_t ops;
+    atomic_int start;
+} bench_spsc_case_t;
+
+static void *bench_spsc_producer(void *arg)
+{
+    bench_spsc_case_t *bc = arg;
+    uint8_t in[BENCH_MAX_ITEM_SIZE];
+    uint32_t spins = 0;
+
+    bench_pin_thread(1);
+    memset(in, 0x5a, sizeof(in));
+    while (atomic_load_explicit(&bc->start, memory_order_acquire) == 0)
+    {
+        bench_relax(&spins);
+    }
+    for (uint64_t i = 0; i < bc->ops; i++)
+    {
+        in[0] = (uint8_t)i;
+        while (bc->impl->put(in) == 0)
+        {
+            bench_relax(&spins);
+        }
+    }
+
+    return NULL;
+}
+
+static void bench_spsc(const bench_impl_t *impl, uint32_t capacity, uint64_t count)
+{
+    bench_spsc_case_t bc = {.impl = impl, .ops = count};
+    uint8_t out[BENCH_MAX_ITEM_SIZE];
+    uint32_t used_capacity = impl->init(capacity, bench_item_size);
+    uint32_t spins = 0;
+    pthread_t producer;
+
+    if (used_capacity == 0 || impl->spsc == 0)
+    {
+        return;
+    }
+    atomic_init(&bc.start, 0);
+    if (pthread_create(&producer, NULL, bench_spsc_producer, &bc) != 0)
+    {
+        perror("pthread_create");
+        return;
+    }
+    bench_pin_thread(2);
+
+    uint64_t begin = bench_now_ns();
+    uint64_t cycles = bench_cycles();
+    atomic_store_explicit(&bc.start, 1, memory_order_release);
+    for (uint64_t i = 0; i < bc.ops; i++)
+    {
+        while (impl->get(out) == 0)
+        {
+            bench_relax(&spins);
+        }
+        bench_check += out[0];
+    }
+    cycles = bench_cycles() - cycles;
+    pthread_join(producer, NULL);
+    bench_report(impl, "spsc", capacity, used_capacity, bc.ops, begin, cycles);
+}
+
+int main(int argc, char *argv[])
+{
+    static const uint32_t item_sizes[] = {8, 64, 256};
+    static const uint32_t capacities[] = {1024, 1000, 100};
+    uint64_t count = argc > 1 ? strtoull(argv[1], NULL, 0) : BENCH_DEFAULT_COUNT;
+
+    printf("bench,impl,workload,item_size,capacity,used_capacity,ops,seconds,mops_per_s,"
+           "cycles_per_op,check\n");
+    for (size_t s = 0; s < sizeof(item_sizes) / sizeof(item_sizes[0]); s++)
+    {
+        bench_item_size = item_sizes[s];
+        for (size_t c = 0; c < sizeof(capacities) / sizeof(capacities[0]); c++)
+        {
+            for (size_t i = 0; i < sizeof(bench_impls) / sizeof(bench_impls[0]); i++)
+            {
+                bench_single(&bench_impls[i], capacities[c], count);
+            }
+            for (size_t i = 0; i < sizeof(bench_impls) / sizeof(bench_impls[0]); i++)
+            {
+                bench_spsc(&bench_impls[i], capacities[c], count / 4);
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench_copy.h"
+#include "simple_ringbuffer_copy.h"
+
+/*
+ * The copy kernels against the direct memcpy() of the default build, single thread put/get pairs
+ * per item size, see bench_copy.h for the "data" and "byte" cases. "direct" runs the same loops
+ * built without SIMPLE_RINGBUFFER_COPY_DISPATCH (copy_direct.c), speedup is against it: the
+ * indirect call of the kernels is part of what they must win back. "memcpy" is the memcpy()
+ * kernel behind the indirect call.
+ */
+
+#if !SIMPLE_RINGBUFFER_COPY_DISPATCH
+#error "bench_copy needs SIMPLE_RINGBUFFER_COPY_DISPATCH=1"
+#endif
+
+#define BENCH_DEFAULT_COUNT 4000000
+
+static const char *bench_kernels[] = {"memcpy", "sse2", "avx2", "avx512", "neon"};
+
+static uint64_t bench_check;
+
+int main(int argc, char *argv[])
+{
+    static const uint32_t sizes[] = {8, 16, 24, 32, 48, 64, 100, 128, 192, 256};
+    static const struct
+    {
+        const char *ring;
+        double (*run)(uint32_t size, uint64_t ops, uint64_t *check);
+        double (*direct)(uint32_t size, uint64_t ops, uint64_t *check);
+    } rings[] = {
+            {"data", bench_copy_data, bench_copy_direct_data},
+            {"byte", bench_copy_byte, bench_copy_direct_byte},
+    };
+    uint64_t ops = argc > 1 ? strtoull(argv[1], NULL, 0) : BENCH_DEFAULT_COUNT;
+
+    printf("bench,ring,kernel,size,ops,seconds,mops_per_s,speedup,check\n");
+    for (size_t r = 0; r < sizeof(rings) / sizeof(rings[0]); r++)
+    {
+        for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+        {
+            double baseline = rings[r].direct(sizes[s], ops, &bench_check);
+
+            printf("copy,%s,direct,%u,%llu,%.6f,%.3f,%.2f,%llu\n", rings[r].ring, sizes[s],
+                   (unsigned long long)ops, baseline, (double)ops / baseline / 1e6, 1.0,
+                   (unsigned long long)bench_check);
+            for (size_t k = 0; k < sizeof(bench_kernels) / sizeof(bench_kernels[0]); k++)
+            {
+                if (simple_ringbuffer_copy_select(bench_kernels[k]) != 0)
+                {
+                    continue;
+                }
+                double seconds = rings[r].run(sizes[s], ops, &bench_check);
+
+                printf("copy,%s,%s,%u,%llu,%.6f,%.3f,%.2f,%llu\n", rings[r].ring,
+                       bench_kernels[k], sizes[s], (unsigned long long)ops, seconds,
+                       (double)ops / seconds / 1e6, baseline / seconds,
+                       (unsigned long long)bench_check);
+            }
+        }
+    }
+    simple_ringbuffer_copy_select(NULL);
+
+    return 0;
+}
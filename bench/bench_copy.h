@@ -0,0 +1,69 @@
+#ifndef _BENCH_COPY_H_
+#define _BENCH_COPY_H_
+
+#include <stdint.h>
+
+#include "bench_common.h"
+#include "simple_data_ringbuffer.h"
+#include "simple_ringbuffer.h"
+
+/*
+ * Put/get loops of bench_copy, built twice: in bench_copy.c with the copy kernels, and in
+ * copy_direct.c with the direct memcpy() of the default build, the baseline.
+ */
+
+#define BENCH_RING_CNT 1023
+#define BENCH_MAX_SIZE 256
+
+static uint8_t bench_storage[BENCH_RING_CNT * BENCH_MAX_SIZE];
+static uint8_t bench_in[BENCH_MAX_SIZE];
+static uint8_t bench_out[BENCH_MAX_SIZE];
+
+/**
+ * @brief  simple_data_ringbuffer_put/get of one item, the slot never wraps.
+ */
+static inline double bench_copy_data(uint32_t size, uint64_t ops, uint64_t *check)
+{
+    simple_data_ringbuffer_t ringbuf;
+
+    memset(bench_in, 0x5a, sizeof(bench_in));
+    simple_data_ringbuffer_init(&ringbuf, BENCH_RING_CNT, size, bench_storage);
+    uint64_t begin = bench_now_ns();
+    for (uint64_t i = 0; i < ops; i++)
+    {
+        bench_in[0] = (uint8_t)i;
+        simple_data_ringbuffer_put(&ringbuf, bench_in);
+        simple_data_ringbuffer_get(&ringbuf, bench_out);
+        *check += bench_out[0];
+    }
+
+    return (double)(bench_now_ns() - begin) / 1e9;
+}
+
+/**
+ * @brief  simple_ringbuffer_put/get of size bytes with an odd capacity, so the copies cross the
+ *         end of the storage at every point.
+ */
+static inline double bench_copy_byte(uint32_t size, uint64_t ops, uint64_t *check)
+{
+    simple_ringbuffer_t ringbuf;
+
+    memset(bench_in, 0x5a, sizeof(bench_in));
+    simple_ringbuffer_init(&ringbuf, BENCH_RING_CNT, bench_storage);
+    uint64_t begin = bench_now_ns();
+    for (uint64_t i = 0; i < ops; i++)
+    {
+        bench_in[0] = (uint8_t)i;
+        simple_ringbuffer_put(&ringbuf, bench_in, size);
+        simple_ringbuffer_get(&ringbuf, bench_out, size);
+        *check += bench_out[0];
+    }
+
+    return (double)(bench_now_ns() - begin) / 1e9;
+}
+
+/* the same loops in copy_direct.c, the only global symbols of that object */
+double bench_copy_direct_data(uint32_t size, uint64_t ops, uint64_t *check);
+double bench_copy_direct_byte(uint32_t size, uint64_t ops, uint64_t *check);
+
+#endif /* _BENCH_COPY_H_ */
@@ -0,0 +1,94 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench_common.h"
+#include "simple_data_ringbuffer_file.h"
+
+/*
+ * Spool throughput: put a batch of items, sync, get them back. In memory, then file-backed with
+ * every flush policy, the price of durability is in the sync.
+ */
+
+#define BENCH_RING_CNT      4096
+#define BENCH_ITEM_SIZE     64
+#define BENCH_BATCH         1024
+#define BENCH_DEFAULT_COUNT (1u << 20)
+#define BENCH_PATH          "/tmp/simple_ringbuffer_bench.ring"
+
+static uint8_t bench_storage[BENCH_RING_CNT][BENCH_ITEM_SIZE];
+
+static void bench_run(const char *variant, simple_data_ringbuffer_t *ringbuf,
+                      simple_data_ringbuffer_file_t *file, uint64_t count)
+{
+    uint8_t item[BENCH_ITEM_SIZE];
+    uint64_t check = 0;
+
+    memset(item, 0x5a, sizeof(item));
+    uint64_t begin = bench_now_ns();
+    for (uint64_t done = 0; done < count; done += BENCH_BATCH)
+    {
+        /* the file puts sync by themselves, once per batch */
+        for (uint32_t i = 0; i < BENCH_BATCH; i++)
+        {
+            item[0] = (uint8_t)i;
+            if (file != NULL)
+            {
+                simple_data_ringbuffer_file_put(file, item);
+            }
+            else
+            {
+                simple_data_ringbuffer_put(ringbuf, item);
+            }
+        }
+        for (uint32_t i = 0; i < BENCH_BATCH; i++)
+        {
+            simple_data_ringbuffer_get(ringbuf, item);
+            check += item[0];
+        }
+    }
+    double seconds = (double)(bench_now_ns() - begin) / 1e9;
+
+    printf("file,%s,%u,%llu,%.6f,%.3f,%llu\n", variant, BENCH_BATCH, (unsigned long long)count,
+           seconds, (double)count / seconds / 1e6, (unsigned long long)check);
+}
+
+int main(int argc, char *argv[])
+{
+    uint64_t count = argc > 1 ? strtoull(argv[1], NULL, 0) : BENCH_DEFAULT_COUNT;
+    static const struct
+    {
+        const char *variant;
+        simple_data_ringbuffer_flush_t flush;
+    } policies[] = {
+            {"file_none", SIMPLE_DATA_RINGBUFFER_FLUSH_NONE},
+            {"file_async", SIMPLE_DATA_RINGBUFFER_FLUSH_ASYNC},
+            {"file_sync", SIMPLE_DATA_RINGBUFFER_FLUSH_SYNC},
+    };
+    static simple_data_ringbuffer_t ringbuf;
+
+    printf("bench,variant,batch,items,seconds,mitems_per_s,check\n");
+
+    simple_data_ringbuffer_init(&ringbuf, BENCH_RING_CNT, BENCH_ITEM_SIZE, bench_storage);
+    bench_run("memory", &ringbuf, NULL, count);
+
+    for (size_t i = 0; i < sizeof(policies) / sizeof(policies[0]); i++)
+    {
+        simple_data_ringbuffer_file_t file;
+
+        remove(BENCH_PATH);
+        if (simple_data_ringbuffer_file_open(&file, BENCH_PATH, BENCH_RING_CNT, BENCH_ITEM_SIZE,
+                                             policies[i].flush) != 0)
+        {
+            perror("simple_data_ringbuffer_file_open");
+            return 1;
+        }
+        simple_data_ringbuffer_file_set_flush_interval(&file, BENCH_BATCH);
+        /* the sync policy is slow on real disks, a smaller run says as much */
+        bench_run(policies[i].variant, file.ringbuf, &file,
+                  policies[i].flush == SIMPLE_DATA_RINGBUFFER_FLUSH_SYNC ? count / 16 : count);
+        simple_data_ringbuffer_file_close(&file);
+    }
+    remove(BENCH_PATH);
+
+    return 0;
+}
@@ -0,0 +1,92 @@
+#ifndef _BENCH_HIST_H_
+#define _BENCH_HIST_H_
+
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * Log-linear latency histogram in the HDR style: values below BENCH_HIST_SUB_CNT have a bucket
+ * each, above that every power of 2 is split into BENCH_HIST_SUB_CNT / 2 buckets, so a bucket is
+ * never wider than 1 / 16 of its values (about 6%), from nanoseconds to hours in 1 K buckets.
+ */
+
+#define BENCH_HIST_SUB_BITS 5
+#define BENCH_HIST_SUB_CNT  (1u << BENCH_HIST_SUB_BITS)
+#define BENCH_HIST_HALF_CNT (BENCH_HIST_SUB_CNT >> 1)
+#define BENCH_HIST_BUCKETS  ((64 - BENCH_HIST_SUB_BITS + 2) * BENCH_HIST_HALF_CNT)
+
+typedef struct bench_hist
+{
+    uint64_t counts[BENCH_HIST_BUCKETS];
+    uint64_t total;
+    uint64_t sum;
+    uint64_t max;
+} bench_hist_t;
+
+static inline void bench_hist_init(bench_hist_t *hist)
+{
+    memset(hist, 0, sizeof(*hist));
+}
+
+static inline uint32_t bench_hist_bucket(uint64_t value)
+{
+    uint32_t exp;
+
+    if (value < BENCH_HIST_SUB_CNT)
+    {
+        return (uint32_t)value;
+    }
+    /* value >> exp is in [HALF_CNT, SUB_CNT) */
+    exp = (uint32_t)(63 - __builtin_clzll(value)) - (BENCH_HIST_SUB_BITS - 1);
+
+    return exp * BENCH_HIST_HALF_CNT + (uint32_t)(value >> exp);
+}
+
+/**
+ * @brief  Highest value of a bucket, what the percentiles report.
+ */
+static inline uint64_t bench_hist_bucket_max(uint32_t bucket)
+{
+    uint32_t exp;
+
+    if (bucket < BENCH_HIST_SUB_CNT)
+    {
+        return bucket;
+    }
+    exp = bucket / BENCH_HIST_HALF_CNT - 1;
+
+    return (((uint64_t)(bucket - exp * BENCH_HIST_HALF_CNT) + 1) << exp) - 1;
+}
+
+static inline void bench_hist_record(bench_hist_t *hist, uint64_t value)
+{
+    hist->counts[bench_hist_bucket(value)]++;
+    hist->total++;
+    hist->sum += value;
+    hist->max = value > hist->max ? value : hist->max;
+}
+
+/**
+ * @brief  Value at or below which the given fraction of the recorded values are.
+ * @param  [in] fraction: In [0, 1], 0.99 for p99.
+ */
+static inline uint64_t bench_hist_percentile(bench_hist_t *hist, double fraction)
+{
+    uint64_t rank = (uint64_t)(fraction * (double)hist->total + 0.999999);
+    uint64_t seen = 0;
+
+    rank = rank == 0 ? 1 : rank;
+    for (uint32_t i = 0; i < BENCH_HIST_BUCKETS; i++)
+    {
+        seen += hist->counts[i];
+        if (seen >= rank)
+        {
+            uint64_t value = bench_hist_bucket_max(i);
+            return value < hist->max ? value : hist->max;
+        }
+    }
+
+    return hist->max;
+}
+
+#endif /* _BENCH_HIST_H_ */
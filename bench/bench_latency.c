@@ -0,0 +1,269 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <stdatomic.h>
+
+#include "bench_common.h"
+#include "bench_hist.h"
+#include "simple_data_ringbuffer.h"
+#include "simple_pool.h"
+#include "simple_ringbuffer.h"
+
+#if !SIMPLE_RINGBUFFER_SPSC
+#error "bench_latency needs SIMPLE_RINGBUFFER_SPSC=1"
+#endif
+
+/*
+ * Handoff latency between two pinned threads: the producer stamps each item with
+ * CLOCK_MONOTONIC right before the put, the consumer takes the time right after the get and
+ * records the difference in a histogram. Rings:
+ *   - "byte": a BENCH_MSG_SIZE message through simple_ringbuffer_t,
+ *   - "data": a BENCH_MSG_SIZE item through simple_data_ringbuffer_t,
+ *   - "pool": a block from simple_pool_t, its pointer through simple_data_ringbuffer_t and
+ *     back to the pool by the consumer.
+ * The load is one item every gap_ns, 0 sends flat out and measures a loaded RINGBUF.
+ *
+ * usage: bench_latency [count] [gap_ns] [producer_cpu] [consumer_cpu]
+ */
+
+#define BENCH_MSG_SIZE      64
+#define BENCH_RING_CNT      1024
+#define BENCH_POOL_CNT      1024
+#define BENCH_DEFAULT_COUNT 1000000
+#define BENCH_DEFAULT_GAP   1000
+
+typedef struct bench_msg
+{
+    uint64_t stamp;
+    uint64_t seq;
+    uint8_t payload[BENCH_MSG_SIZE - 2 * sizeof(uint64_t)];
+} bench_msg_t;
+
+typedef struct bench_latency_case
+{
+    const char *ring;
+    void *(*producer)(void *arg);
+    void (*consumer)(struct bench_latency_case *bc);
+    uint64_t count;
+    uint64_t gap_ns;
+    int producer_cpu;
+    int consumer_cpu;
+    atomic_int start;
+    bench_hist_t hist;
+} bench_latency_case_t;
+
+static uint8_t bench_byte_storage[BENCH_RING_CNT * BENCH_MSG_SIZE];
+static bench_msg_t bench_data_storage[BENCH_RING_CNT];
+static simple_ringbuffer_t bench_byte_ring;
+static simple_data_ringbuffer_t bench_data_ring;
+
+static void *bench_ptr_storage[BENCH_POOL_CNT];
+static void *bench_pool_fifo_storage[BENCH_POOL_CNT];
+static bench_msg_t bench_pool_blocks[BENCH_POOL_CNT];
+static simple_data_ringbuffer_t bench_ptr_ring;
+static simple_pool_t bench_pool;
+
+/**
+ * @brief  Wait for the consumer, then pace the producer: returns once the next item is due.
+ */
+static void bench_pace(bench_latency_case_t *bc, uint64_t *next)
+{
+    uint32_t spins = 0;
+
+    if (*next == 0)
+    {
+        while (atomic_load_explicit(&bc->start, memory_order_acquire) == 0)
+        {
+            bench_relax(&spins);
+        }
+        *next = bench_now_ns();
+    }
+    while (bc->gap_ns != 0 && bench_now_ns() < *next)
+    {
+        bench_relax(&spins);
+    }
+    *next += bc->gap_ns;
+}
+
+static void *bench_byte_producer(void *arg)
+{
+    bench_latency_case_t *bc = arg;
+    bench_msg_t msg;
+    uint64_t next = 0;
+
+    bench_pin_thread(bc->producer_cpu);
+    memset(&msg, 0x5a, sizeof(msg));
+    for (uint64_t i = 0; i < bc->count; i++)
+    {
+        uint32_t spins = 0;
+
+        bench_pace(bc, &next);
+        msg.seq = i;
+        msg.stamp = bench_now_ns();
+        while (simple_ringbuffer_reserve_size(&bench_byte_ring) < sizeof(msg))
+        {
+            bench_relax(&spins);
+        }
+        simple_ringbuffer_put(&bench_byte_ring, (uint8_t *)&msg, sizeof(msg));
+    }
+
+    return NULL;
+}
+
+static void bench_byte_consumer(bench_latency_case_t *bc)
+{
+    bench_msg_t msg;
+
+    for (uint64_t i = 0; i < bc->count; i++)
+    {
+        uint32_t spins = 0;
+
+        while (simple_ringbuffer_size(&bench_byte_ring) < sizeof(msg))
+        {
+            bench_relax(&spins);
+        }
+        simple_ringbuffer_get(&bench_byte_ring, (uint8_t *)&msg, sizeof(msg));
+        bench_hist_record(&bc->hist, bench_now_ns() - msg.stamp);
+    }
+}
+
+static void *bench_data_producer(void *arg)
+{
+    bench_latency_case_t *bc = arg;
+    bench_msg_t msg;
+    uint64_t next = 0;
+
+    bench_pin_thread(bc->producer_cpu);
+    memset(&msg, 0x5a, sizeof(msg));
+    for (uint64_t i = 0; i < bc->count; i++)
+    {
+        uint32_t spins = 0;
+
+        bench_pace(bc, &next);
+        msg.seq = i;
+        msg.stamp = bench_now_ns();
+        while (simple_data_ringbuffer_put(&bench_data_ring, &msg) == 0)
+        {
+            bench_relax(&spins);
+        }
+    }
+
+    return NULL;
+}
+
+static void bench_data_consumer(bench_latency_case_t *bc)
+{
+    bench_msg_t msg;
+
+    for (uint64_t i = 0; i < bc->count; i++)
+    {
+        uint32_t spins = 0;
+
+        while (simple_data_ringbuffer_get(&bench_data_ring, &msg) == 0)
+        {
+            bench_relax(&spins);
+        }
+        bench_hist_record(&bc->hist, bench_now_ns() - msg.stamp);
+    }
+}
+
+static void *bench_pool_producer(void *arg)
+{
+    bench_latency_case_t *bc = arg;
+    uint64_t next = 0;
+
+    bench_pin_thread(bc->producer_cpu);
+    for (uint64_t i = 0; i < bc->count; i++)
+    {
+        bench_msg_t *block;
+        uint32_t spins = 0;
+
+        bench_pace(bc, &next);
+        /* the pool refills as the consumer frees the blocks */
+        while (SIMPLE_POOL_DEQUEUE(&bench_pool, block) == 0)
+        {
+            bench_relax(&spins);
+        }
+        block->seq = i;
+        block->stamp = bench_now_ns();
+        while (simple_data_ringbuffer_put(&bench_ptr_ring, &block) == 0)
+        {
+            bench_relax(&spins);
+        }
+    }
+
+    return NULL;
+}
+
+static void bench_pool_consumer(bench_latency_case_t *bc)
+{
+    for (uint64_t i = 0; i < bc->count; i++)
+    {
+        bench_msg_t *block;
+        uint32_t spins = 0;
+
+        while (simple_data_ringbuffer_get(&bench_ptr_ring, &block) == 0)
+        {
+            bench_relax(&spins);
+        }
+        bench_hist_record(&bc->hist, bench_now_ns() - block->stamp);
+        SIMPLE_POOL_ENQUEUE(&bench_pool, block);
+    }
+}
+
+static void bench_run(bench_latency_case_t *bc)
+{
+    pthread_t producer;
+
+    bench_hist_init(&bc->hist);
+    atomic_store(&bc->start, 0);
+    if (pthread_create(&producer, NULL, bc->producer, bc) != 0)
+    {
+        perror("pthread_create");
+        return;
+    }
+    bench_pin_thread(bc->consumer_cpu);
+    atomic_store_explicit(&bc->start, 1, memory_order_release);
+    bc->consumer(bc);
+    pthread_join(producer, NULL);
+
+    printf("latency,%s,%llu,%llu,%llu,%llu,%llu,%llu,%.1f\n", bc->ring,
+           (unsigned long long)bc->gap_ns, (unsigned long long)bc->hist.total,
+           (unsigned long long)bench_hist_percentile(&bc->hist, 0.5),
+           (unsigned long long)bench_hist_percentile(&bc->hist, 0.99),
+           (unsigned long long)bench_hist_percentile(&bc->hist, 0.999),
+           (unsigned long long)bc->hist.max, (double)bc->hist.sum / (double)bc->hist.total);
+}
+
+int main(int argc, char *argv[])
+{
+    static bench_latency_case_t cases[] = {
+            {"byte", bench_byte_producer, bench_byte_consumer},
+            {"data", bench_data_producer, bench_data_consumer},
+            {"pool", bench_pool_producer, bench_pool_consumer},
+    };
+    uint64_t count = argc > 1 ? strtoull(argv[1], NULL, 0) : BENCH_DEFAULT_COUNT;
+    uint64_t gap_ns = argc > 2 ? strtoull(argv[2], NULL, 0) : BENCH_DEFAULT_GAP;
+    int producer_cpu = argc > 3 ? atoi(argv[3]) : 1;
+    int consumer_cpu = argc > 4 ? atoi(argv[4]) : 2;
+
+    simple_ringbuffer_init(&bench_byte_ring, sizeof(bench_byte_storage), bench_byte_storage);
+    simple_data_ringbuffer_init(&bench_data_ring, BENCH_RING_CNT, sizeof(bench_msg_t),
+                                bench_data_storage);
+    simple_data_ringbuffer_init(&bench_ptr_ring, BENCH_POOL_CNT, sizeof(void *),
+                                bench_ptr_storage);
+    simple_pool_init(&bench_pool, bench_pool_fifo_storage, (uint8_t *)bench_pool_blocks,
+                     BENCH_POOL_CNT, sizeof(bench_msg_t));
+
+    printf("bench,ring,gap_ns,items,p50_ns,p99_ns,p999_ns,max_ns,mean_ns\n");
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        cases[i].count = count;
+        cases[i].gap_ns = gap_ns;
+        cases[i].producer_cpu = producer_cpu;
+        cases[i].consumer_cpu = consumer_cpu;
+        bench_run(&cases[i]);
+    }
+
+    return 0;
+}
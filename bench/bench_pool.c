@@ -0,0 +1,184 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <stdatomic.h>
+
+#include "bench_common.h"
+#include "simple_mpmc_pool.h"
+
+/*
+ * Multi-thread alloc/free of fixed size blocks: malloc/free against simple_mpmc_pool_t, once
+ * through the shared RINGBUF only ("shared") and once through per-thread caches ("cache").
+ * Every thread allocates a burst of blocks, touches them, and frees them again.
+ */
+
+#define BENCH_BLOCK_SIZE     64
+#define BENCH_POOL_CNT       4096
+#define BENCH_BURST_CNT      16
+#define BENCH_MAX_THREADS    64
+#define BENCH_DEFAULT_COUNT  2000000
+#define BENCH_DEFAULT_THREAD 4
+
+SIMPLE_MPMC_POOL_DEFINE(bench_pool, BENCH_POOL_CNT, BENCH_BLOCK_SIZE);
+
+typedef struct bench_pool_case
+{
+    const char *variant;
+    void *(*thread)(void *arg);
+    uint64_t count; /* alloc/free pairs per thread */
+    atomic_int start;
+} bench_pool_case_t;
+
+static void bench_wait_start(bench_pool_case_t *bc)
+{
+    uint32_t spins = 0;
+
+    while (!atomic_load_explicit(&bc->start, memory_order_acquire))
+    {
+        bench_relax(&spins);
+    }
+}
+
+static void *bench_malloc_thread(void *arg)
+{
+    bench_pool_case_t *bc = arg;
+    void *burst[BENCH_BURST_CNT];
+
+    bench_wait_start(bc);
+    for (uint64_t i = 0; i < bc->count; i += BENCH_BURST_CNT)
+    {
+        for (int j = 0; j < BENCH_BURST_CNT; j++)
+        {
+            burst[j] = malloc(BENCH_BLOCK_SIZE);
+            *(volatile uint64_t *)burst[j] = i;
+        }
+        for (int j = 0; j < BENCH_BURST_CNT; j++)
+        {
+            free(burst[j]);
+        }
+    }
+
+    return NULL;
+}
+
+static void *bench_shared_thread(void *arg)
+{
+    bench_pool_case_t *bc = arg;
+    void *burst[BENCH_BURST_CNT];
+    uint32_t spins = 0;
+
+    bench_wait_start(bc);
+    for (uint64_t i = 0; i < bc->count; i += BENCH_BURST_CNT)
+    {
+        for (int j = 0; j < BENCH_BURST_CNT; j++)
+        {
+            while (!simple_mpmc_data_ringbuffer_get(&bench_pool.ringbuf, &burst[j]))
+            {
+                bench_relax(&spins);
+            }
+            *(volatile uint64_t *)burst[j] = i;
+        }
+        for (int j = 0; j < BENCH_BURST_CNT; j++)
+        {
+            /* a slot may still be busy with a reader which claimed it */
+            while (!simple_mpmc_data_ringbuffer_put(&bench_pool.ringbuf, &burst[j]))
+            {
+                bench_relax(&spins);
+            }
+        }
+    }
+
+    return NULL;
+}
+
+static void *bench_cache_thread(void *arg)
+{
+    bench_pool_case_t *bc = arg;
+    void *burst[BENCH_BURST_CNT];
+    uint32_t spins = 0;
+    simple_mpmc_pool_cache_t cache;
+
+    simple_mpmc_pool_cache_init(&cache, &bench_pool);
+    bench_wait_start(bc);
+    for (uint64_t i = 0; i < bc->count; i += BENCH_BURST_CNT)
+    {
+        for (int j = 0; j < BENCH_BURST_CNT; j++)
+        {
+            while ((burst[j] = simple_mpmc_pool_alloc(&cache)) == NULL)
+            {
+                bench_relax(&spins);
+            }
+            *(volatile uint64_t *)burst[j] = i;
+        }
+        for (int j = 0; j < BENCH_BURST_CNT; j++)
+        {
+            simple_mpmc_pool_free(&cache, burst[j]);
+        }
+    }
+    simple_mpmc_pool_cache_flush(&cache);
+
+    return NULL;
+}
+
+static void bench_run(bench_pool_case_t *bc, int threads)
+{
+    pthread_t tid[BENCH_MAX_THREADS];
+
+    SIMPLE_MPMC_POOL_INIT(bench_pool, BENCH_POOL_CNT, BENCH_BLOCK_SIZE);
+    atomic_init(&bc->start, 0);
+    for (int i = 0; i < threads; i++)
+    {
+        pthread_create(&tid[i], NULL, bc->thread, bc);
+    }
+
+    uint64_t begin = bench_now_ns();
+    atomic_store_explicit(&bc->start, 1, memory_order_release);
+    for (int i = 0; i < threads; i++)
+    {
+        pthread_join(tid[i], NULL);
+    }
+    double seconds = (double)(bench_now_ns() - begin) / 1e9;
+    uint64_t ops = bc->count * threads;
+
+    printf("pool,%s,%u,%u,%d,%llu,%.6f,%.3f,%.2f\n", bc->variant, BENCH_BLOCK_SIZE,
+           BENCH_POOL_CNT, threads, (unsigned long long)ops, seconds, ops / seconds / 1e6,
+           seconds * 1e9 * threads / ops);
+
+    if (bc->thread != bench_malloc_thread &&
+        SIMPLE_MPMC_POOL_SIZE(&bench_pool) != BENCH_POOL_CNT)
+    {
+        printf("pool,%s: blocks lost\n", bc->variant);
+        exit(1);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    uint64_t count = argc > 1 ? strtoull(argv[1], NULL, 0) : BENCH_DEFAULT_COUNT;
+    int threads = argc > 2 ? atoi(argv[2]) : BENCH_DEFAULT_THREAD;
+
+    static bench_pool_case_t cases[] = {
+            {"malloc", bench_malloc_thread},
+            {"shared", bench_shared_thread},
+            {"cache", bench_cache_thread},
+    };
+
+    if (threads < 1 || threads > BENCH_MAX_THREADS)
+    {
+        threads = BENCH_DEFAULT_THREAD;
+    }
+    /* every thread may keep a full magazine plus a burst */
+    if (threads * (SIMPLE_MPMC_POOL_CACHE_SIZE + BENCH_BURST_CNT) > BENCH_POOL_CNT)
+    {
+        threads = BENCH_POOL_CNT / (SIMPLE_MPMC_POOL_CACHE_SIZE + BENCH_BURST_CNT);
+    }
+
+    printf("bench,variant,block_size,pool_cnt,threads,ops,seconds,mops_per_sec,ns_per_op\n");
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        cases[i].count = count;
+        bench_run(&cases[i], threads);
+    }
+
+    return 0;
+}
@@ -0,0 +1,112 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench_common.h"
+#include "simple_data_ringbuffer.h"
+#include "simple_ringbuffer.h"
+
+/*
+ * Index wrap cost on one thread, for simple_ringbuffer_t (small put/get of bytes) and
+ * simple_data_ringbuffer_t (single item put/get): a power of 2 capacity using the mask path
+ * ("mask"), the same capacity with index_mask cleared so the generic compare and subtract path
+ * runs ("generic"), and an odd capacity ("odd").
+ */
+
+#define BENCH_POW2_CNT      1024
+#define BENCH_ODD_CNT       1023
+#define BENCH_CHUNK_SIZE    8
+#define BENCH_ITEM_SIZE     8
+#define BENCH_BURST_CNT     64
+#define BENCH_DEFAULT_COUNT 20000000
+
+static uint8_t bench_storage[BENCH_POW2_CNT * BENCH_ITEM_SIZE];
+static uint8_t bench_in[BENCH_BURST_CNT * BENCH_ITEM_SIZE];
+static uint8_t bench_out[BENCH_BURST_CNT * BENCH_ITEM_SIZE];
+
+static void bench_report(const char *ring, const char *variant, uint32_t capacity, uint64_t ops,
+                         uint64_t begin)
+{
+    double seconds = (double)(bench_now_ns() - begin) / 1e9;
+
+    printf("pow2,%s,%s,%u,%llu,%.6f,%.3f,%.2f\n", ring, variant, capacity,
+           (unsigned long long)ops, seconds, ops / seconds / 1e6, seconds * 1e9 / ops);
+}
+
+static void bench_bytes(const char *variant, uint32_t capacity, int generic, uint64_t count)
+{
+    simple_ringbuffer_t ringbuf;
+    uint64_t bursts = count / BENCH_BURST_CNT;
+
+    simple_ringbuffer_init(&ringbuf, capacity, bench_storage);
+    if (generic)
+    {
+        ringbuf.index_mask = 0;
+    }
+
+    uint64_t begin = bench_now_ns();
+    for (uint64_t i = 0; i < bursts; i++)
+    {
+        bench_in[0] = (uint8_t)i;
+        for (int j = 0; j < BENCH_BURST_CNT; j++)
+        {
+            simple_ringbuffer_put(&ringbuf, bench_in + j * BENCH_CHUNK_SIZE, BENCH_CHUNK_SIZE);
+        }
+        for (int j = 0; j < BENCH_BURST_CNT; j++)
+        {
+            simple_ringbuffer_get(&ringbuf, bench_out + j * BENCH_CHUNK_SIZE, BENCH_CHUNK_SIZE);
+        }
+        if (bench_out[0] != (uint8_t)i)
+        {
+            printf("pow2,bytes,%s: data mismatch\n", variant);
+            exit(1);
+        }
+    }
+    bench_report("bytes", variant, capacity, bursts * BENCH_BURST_CNT, begin);
+}
+
+static void bench_data(const char *variant, uint16_t capacity, int generic, uint64_t count)
+{
+    simple_data_ringbuffer_t ringbuf;
+    uint64_t bursts = count / BENCH_BURST_CNT;
+
+    simple_data_ringbuffer_init(&ringbuf, capacity, BENCH_ITEM_SIZE, bench_storage);
+    if (generic)
+    {
+        ringbuf.index_mask = 0;
+    }
+
+    uint64_t begin = bench_now_ns();
+    for (uint64_t i = 0; i < bursts; i++)
+    {
+        bench_in[0] = (uint8_t)i;
+        for (int j = 0; j < BENCH_BURST_CNT; j++)
+        {
+            simple_data_ringbuffer_put(&ringbuf, bench_in + j * BENCH_ITEM_SIZE);
+        }
+        for (int j = 0; j < BENCH_BURST_CNT; j++)
+        {
+            simple_data_ringbuffer_get(&ringbuf, bench_out + j * BENCH_ITEM_SIZE);
+        }
+        if (bench_out[0] != (uint8_t)i)
+        {
+            printf("pow2,data,%s: data mismatch\n", variant);
+            exit(1);
+        }
+    }
+    bench_report("data", variant, capacity, bursts * BENCH_BURST_CNT, begin);
+}
+
+int main(int argc, char *argv[])
+{
+    uint64_t count = argc > 1 ? strtoull(argv[1], NULL, 0) : BENCH_DEFAULT_COUNT;
+
+    printf("bench,ring,variant,capacity,ops,seconds,mops_per_sec,ns_per_op\n");
+    bench_bytes("mask", BENCH_POW2_CNT * BENCH_CHUNK_SIZE, 0, count);
+    bench_bytes("generic", BENCH_POW2_CNT * BENCH_CHUNK_SIZE, 1, count);
+    bench_bytes("odd", BENCH_ODD_CNT * BENCH_CHUNK_SIZE, 0, count);
+    bench_data("mask", BENCH_POW2_CNT, 0, count);
+    bench_data("generic", BENCH_POW2_CNT, 1, count);
+    bench_data("odd", BENCH_ODD_CNT, 0, count);
+
+    return 0;
+}
@@ -0,0 +1,137 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <sys/wait.h>
+
+#include "bench_common.h"
+#include "simple_shm_ringbuffer.h"
+
+/*
+ * Bulk bytes from a child process to its parent: through a pipe (two kernel copies) and through
+ * a shared memory RINGBUF attached by name (the consumer reads in place).
+ */
+
+#define BENCH_RING_SIZE     (1u << 20)
+#define BENCH_CHUNK         4096
+#define BENCH_DEFAULT_BYTES (1ull << 30)
+
+static uint8_t bench_chunk[BENCH_CHUNK];
+
+static void bench_report(const char *variant, uint64_t bytes, uint64_t begin, uint64_t check)
+{
+    double seconds = (double)(bench_now_ns() - begin) / 1e9;
+
+    printf("shm,%s,%u,%llu,%.6f,%.1f,%llu\n", variant, BENCH_CHUNK, (unsigned long long)bytes,
+           seconds, (double)bytes / seconds / 1e6, (unsigned long long)check);
+}
+
+static void bench_pipe(uint64_t bytes)
+{
+    int fds[2];
+    uint64_t check = 0;
+
+    if (pipe(fds) != 0)
+    {
+        return;
+    }
+
+    uint64_t begin = bench_now_ns();
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        close(fds[0]);
+        for (uint64_t done = 0; done < bytes;)
+        {
+            ssize_t len = write(fds[1], bench_chunk, BENCH_CHUNK);
+            done += len > 0 ? (uint64_t)len : 0;
+        }
+        _exit(0);
+    }
+    close(fds[1]);
+
+    for (uint64_t done = 0; done < bytes;)
+    {
+        static uint8_t buffer[BENCH_CHUNK];
+        ssize_t len = read(fds[0], buffer, sizeof(buffer));
+        if (len <= 0)
+        {
+            break;
+        }
+        check += buffer[0];
+        done += (uint64_t)len;
+    }
+    waitpid(pid, NULL, 0);
+    close(fds[0]);
+    bench_report("pipe", bytes, begin, check);
+}
+
+static void bench_ring(uint64_t bytes)
+{
+    simple_shm_ringbuffer_t consumer;
+    uint64_t check = 0;
+    char name[64];
+
+    snprintf(name, sizeof(name), "/simple_ringbuffer_bench_%ld", (long)getpid());
+    if (simple_shm_ringbuffer_create(&consumer, name, BENCH_RING_SIZE) != 0)
+    {
+        perror("simple_shm_ringbuffer_create");
+        return;
+    }
+
+    uint64_t begin = bench_now_ns();
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        simple_shm_ringbuffer_t producer;
+        uint32_t spins = 0;
+
+        simple_shm_ringbuffer_detach(&consumer);
+        if (simple_shm_ringbuffer_attach(&producer, name) != 0)
+        {
+            _exit(1);
+        }
+        for (uint64_t done = 0; done < bytes;)
+        {
+            uint32_t len = simple_shm_ringbuffer_put(&producer, bench_chunk, BENCH_CHUNK);
+            done += len;
+            if (len == 0)
+            {
+                bench_relax(&spins);
+            }
+        }
+        _exit(0);
+    }
+
+    uint32_t spins = 0;
+    for (uint64_t done = 0; done < bytes;)
+    {
+        simple_ringbuffer_span_t span[2];
+        uint32_t len = simple_shm_ringbuffer_peek(&consumer, span);
+
+        if (len == 0)
+        {
+            bench_relax(&spins);
+            continue;
+        }
+        /* in place, touch the data like the pipe reader does */
+        check += span[0].data[0];
+        simple_shm_ringbuffer_consume(&consumer, len);
+        done += len;
+    }
+    waitpid(pid, NULL, 0);
+    simple_shm_ringbuffer_detach(&consumer);
+    simple_shm_ringbuffer_unlink(name);
+    bench_report("shm_ring", bytes, begin, check);
+}
+
+int main(int argc, char *argv[])
+{
+    uint64_t bytes = argc > 1 ? strtoull(argv[1], NULL, 0) : BENCH_DEFAULT_BYTES;
+
+    memset(bench_chunk, 0x5a, sizeof(bench_chunk));
+    printf("bench,variant,chunk,bytes,seconds,mb_per_s,check\n");
+    bench_pipe(bytes);
+    bench_ring(bytes);
+
+    return 0;
+}
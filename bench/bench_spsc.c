@@ -0,0 +1,325 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <stdatomic.h>
+
+#include "bench_common.h"
+#include "simple_ringbuffer.h"
+#include "simple_data_ringbuffer.h"
+
+#if !SIMPLE_RINGBUFFER_SPSC
+#error "bench_spsc needs SIMPLE_RINGBUFFER_SPSC=1"
+#endif
+
+/*
+ * Cross-thread put/get of small items, with the cached remote index of the library against the
+ * previous protocol which loads the remote index on every call ("uncached" below).
+ */
+
+#define BENCH_ITEM_SIZE     8
+/*
+ * Not powers of 2: the library takes the same compare and subtract wrap as the references, the
+ * cached index is the only difference. The byte ring is a multiple of the item size, a put never
+ * splits an item.
+ */
+#define BENCH_BYTE_RING     (511 * BENCH_ITEM_SIZE)
+#define BENCH_DATA_RING     1023
+#define BENCH_DEFAULT_COUNT 4000000
+
+#define RINGBUFFER_INDEX_TO_PTR(_index, _total_size)                                               \
+    ((_index >= _total_size) ? (_index - _total_size) : (_index))
+
+#define RINGBUFFER_USED_SIZE(_write_index, _read_index, _total_size)                               \
+    ((_write_index >= _read_index) ? (_write_index - _read_index)                                  \
+                                   : ((_total_size << 1) - (_read_index - _write_index)))
+
+/* Reference: byte ring put/get that reads the remote index every time. */
+static uint32_t uncached_ringbuffer_put(simple_ringbuffer_t *ringbuf, uint8_t *buffer,
+                                        uint32_t len)
+{
+    uint32_t write_index = SIMPLE_RINGBUFFER_LOAD_RELAXED(ringbuf->write_index);
+    uint32_t read_index = SIMPLE_RINGBUFFER_LOAD_ACQUIRE(ringbuf->read_index);
+    uint32_t wptr = RINGBUFFER_INDEX_TO_PTR(write_index, ringbuf->total_size);
+    uint32_t free = ringbuf->total_size -
+                    RINGBUFFER_USED_SIZE(write_index, read_index, ringbuf->total_size);
+    uint32_t l;
+
+    len = len < free ? len : free;
+    l = len < ringbuf->total_size - wptr ? len : ringbuf->total_size - wptr;
+    memcpy(ringbuf->buffer + wptr, buffer, l);
+    memcpy(ringbuf->buffer, buffer + l, len - l);
+
+    write_index += len;
+    if (write_index >= (ringbuf->total_size << 1))
+    {
+        write_index -= (ringbuf->total_size << 1);
+    }
+    SIMPLE_RINGBUFFER_STORE_RELEASE(ringbuf->write_index, write_index);
+
+    return len;
+}
+
+static uint32_t uncached_ringbuffer_get(simple_ringbuffer_t *ringbuf, uint8_t *buffer,
+                                        uint32_t len)
+{
+    uint32_t read_index = SIMPLE_RINGBUFFER_LOAD_RELAXED(ringbuf->read_index);
+    uint32_t write_index = SIMPLE_RINGBUFFER_LOAD_ACQUIRE(ringbuf->write_index);
+    uint32_t rptr = RINGBUFFER_INDEX_TO_PTR(read_index, ringbuf->total_size);
+    uint32_t used = RINGBUFFER_USED_SIZE(write_index, read_index, ringbuf->total_size);
+    uint32_t l;
+
+    len = len < used ? len : used;
+    l = len < ringbuf->total_size - rptr ? len : ringbuf->total_size - rptr;
+    memcpy(buffer, ringbuf->buffer + rptr, l);
+    memcpy(buffer + l, ringbuf->buffer, len - l);
+
+    read_index += len;
+    if (read_index >= (ringbuf->total_size << 1))
+    {
+        read_index -= (ringbuf->total_size << 1);
+    }
+    SIMPLE_RINGBUFFER_STORE_RELEASE(ringbuf->read_index, read_index);
+
+    return len;
+}
+
+/* Reference: data ring put/get that reads the remote index every time. */
+static int uncached_data_ringbuffer_put(simple_data_ringbuffer_t *ringbuf, void *buffer)
+{
+    uint16_t write_index = SIMPLE_RINGBUFFER_LOAD_RELAXED(ringbuf->write_index);
+    uint16_t read_index = SIMPLE_RINGBUFFER_LOAD_ACQUIRE(ringbuf->read_index);
+    uint16_t wptr;
+
+    if (RINGBUFFER_USED_SIZE(write_index, read_index, ringbuf->total_size) == ringbuf->total_size)
+    {
+        return 0;
+    }
+
+    wptr = RINGBUFFER_INDEX_TO_PTR(write_index, ringbuf->total_size);
+    memcpy(ringbuf->buffer + wptr * ringbuf->item_size, buffer, ringbuf->item_size);
+
+    write_index++;
+    if (write_index >= (ringbuf->total_size << 1))
+    {
+        write_index -= (ringbuf->total_size << 1);
+    }
+    SIMPLE_RINGBUFFER_STORE_RELEASE(ringbuf->write_index, write_index);
+
+    return 1;
+}
+
+static int uncached_data_ringbuffer_get(simple_data_ringbuffer_t *ringbuf, void *buffer)
+{
+    uint16_t read_index = SIMPLE_RINGBUFFER_LOAD_RELAXED(ringbuf->read_index);
+    uint16_t write_index = SIMPLE_RINGBUFFER_LOAD_ACQUIRE(ringbuf->write_index);
+    uint16_t rptr;
+
+    if (read_index == write_index)
+    {
+        return 0;
+    }
+
+    rptr = RINGBUFFER_INDEX_TO_PTR(read_index, ringbuf->total_size);
+    memcpy(buffer, ringbuf->buffer + rptr * ringbuf->item_size, ringbuf->item_size);
+
+    read_index++;
+    if (read_index >= (ringbuf->total_size << 1))
+    {
+        read_index -= (ringbuf->total_size << 1);
+    }
+    SIMPLE_RINGBUFFER_STORE_RELEASE(ringbuf->read_index, read_index);
+
+    return 1;
+}
+
+static int cached_put(void *ring, uint8_t *item)
+{
+    return simple_ringbuffer_put(ring, item, BENCH_ITEM_SIZE) != 0;
+}
+
+static int cached_get(void *ring, uint8_t *item)
+{
+    return simple_ringbuffer_get(ring, item, BENCH_ITEM_SIZE) != 0;
+}
+
+static int uncached_put(void *ring, uint8_t *item)
+{
+    return uncached_ringbuffer_put(ring, item, BENCH_ITEM_SIZE) != 0;
+}
+
+static int uncached_get(void *ring, uint8_t *item)
+{
+    return uncached_ringbuffer_get(ring, item, BENCH_ITEM_SIZE) != 0;
+}
+
+static int cached_data_put(void *ring, uint8_t *item)
+{
+    return simple_data_ringbuffer_put(ring, item);
+}
+
+static int cached_data_get(void *ring, uint8_t *item)
+{
+    return simple_data_ringbuffer_get(ring, item);
+}
+
+static int uncached_data_put(void *ring, uint8_t *item)
+{
+    return uncached_data_ringbuffer_put(ring, item);
+}
+
+static int uncached_data_get(void *ring, uint8_t *item)
+{
+    return uncached_data_ringbuffer_get(ring, item);
+}
+
+typedef struct bench_spsc_case
+{
+    const char *ring_name;
+    const char *variant;
+    uint32_t capacity;
+    int (*put)(void *ring, uint8_t *item);
+    int (*get)(void *ring, uint8_t *item);
+    void *ring;
+    uint64_t count;
+    atomic_int start;
+    uint64_t misses[2][2]; /* [producer/consumer][l1d/llc] */
+    uint64_t checksum;
+} bench_spsc_case_t;
+
+static void *bench_producer(void *arg)
+{
+    bench_spsc_case_t *bc = arg;
+    uint8_t item[BENCH_ITEM_SIZE] = {0};
+    uint32_t spins = 0;
+
+    bench_pin_thread(0);
+    while (!atomic_load_explicit(&bc->start, memory_order_acquire))
+    {
+    }
+
+    int l1d = bench_perf_open(BENCH_PERF_L1D_MISS);
+    int llc = bench_perf_open(BENCH_PERF_LLC_MISS);
+    for (uint64_t i = 0; i < bc->count; i++)
+    {
+        memcpy(item, &i, sizeof(i));
+        while (!bc->put(bc->ring, item))
+        {
+            bench_relax(&spins);
+        }
+    }
+    bc->misses[0][0] = bench_perf_close(l1d);
+    bc->misses[0][1] = bench_perf_close(llc);
+
+    return NULL;
+}
+
+static void *bench_consumer(void *arg)
+{
+    bench_spsc_case_t *bc = arg;
+    uint8_t item[BENCH_ITEM_SIZE];
+    uint64_t checksum = 0;
+    uint32_t spins = 0;
+
+    bench_pin_thread(1);
+    while (!atomic_load_explicit(&bc->start, memory_order_acquire))
+    {
+    }
+
+    int l1d = bench_perf_open(BENCH_PERF_L1D_MISS);
+    int llc = bench_perf_open(BENCH_PERF_LLC_MISS);
+    for (uint64_t i = 0; i < bc->count; i++)
+    {
+        while (!bc->get(bc->ring, item))
+        {
+            bench_relax(&spins);
+        }
+        uint64_t value;
+        memcpy(&value, item, sizeof(value));
+        checksum += value;
+    }
+    bc->misses[1][0] = bench_perf_close(l1d);
+    bc->misses[1][1] = bench_perf_close(llc);
+    bc->checksum = checksum;
+
+    return NULL;
+}
+
+static void print_per_op(uint64_t misses, int valid, uint64_t count)
+{
+    if (valid)
+    {
+        printf(",%.3f", (double)misses / (double)count);
+    }
+    else
+    {
+        printf(",-");
+    }
+}
+
+static void bench_run(bench_spsc_case_t *bc)
+{
+    pthread_t producer, consumer;
+
+    atomic_init(&bc->start, 0);
+    pthread_create(&producer, NULL, bench_producer, bc);
+    pthread_create(&consumer, NULL, bench_consumer, bc);
+
+    uint64_t begin = bench_now_ns();
+    atomic_store_explicit(&bc->start, 1, memory_order_release);
+    pthread_join(producer, NULL);
+    pthread_join(consumer, NULL);
+    double seconds = (double)(bench_now_ns() - begin) / 1e9;
+
+    /* a counter that failed to open reads back 0 on both sides */
+    int l1d_valid = (bc->misses[0][0] | bc->misses[1][0]) != 0;
+    int llc_valid = (bc->misses[0][1] | bc->misses[1][1]) != 0;
+
+    printf("spsc,%s,%s,%u,%u,%llu,%.6f,%.3f", bc->ring_name, bc->variant, BENCH_ITEM_SIZE,
+           bc->capacity, (unsigned long long)bc->count, seconds, bc->count / seconds / 1e6);
+    print_per_op(bc->misses[0][0] + bc->misses[1][0], l1d_valid, bc->count);
+    print_per_op(bc->misses[0][1] + bc->misses[1][1], llc_valid, bc->count);
+    printf("\n");
+
+    if (bc->checksum != bc->count * (bc->count - 1) / 2)
+    {
+        printf("spsc,%s,%s: checksum mismatch\n", bc->ring_name, bc->variant);
+        exit(1);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    static uint8_t byte_storage[BENCH_BYTE_RING];
+    static uint8_t data_storage[BENCH_DATA_RING][BENCH_ITEM_SIZE];
+    static simple_ringbuffer_t byte_ring;
+    static simple_data_ringbuffer_t data_ring;
+    uint64_t count = argc > 1 ? strtoull(argv[1], NULL, 0) : BENCH_DEFAULT_COUNT;
+
+    static bench_spsc_case_t cases[] = {
+            {"ringbuffer", "uncached", BENCH_BYTE_RING, uncached_put, uncached_get},
+            {"ringbuffer", "cached", BENCH_BYTE_RING, cached_put, cached_get},
+            {"data_ringbuffer", "uncached", BENCH_DATA_RING, uncached_data_put, uncached_data_get},
+            {"data_ringbuffer", "cached", BENCH_DATA_RING, cached_data_put, cached_data_get},
+    };
+
+    printf("bench,ring,variant,item_size,capacity,ops,seconds,mops_per_sec,l1d_miss_per_op,"
+           "llc_miss_per_op\n");
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        if (strcmp(cases[i].ring_name, "ringbuffer") == 0)
+        {
+            simple_ringbuffer_init(&byte_ring, BENCH_BYTE_RING, byte_storage);
+            cases[i].ring = &byte_ring;
+        }
+        else
+        {
+            simple_data_ringbuffer_init(&data_ring, BENCH_DATA_RING, BENCH_ITEM_SIZE,
+                                        data_storage);
+            cases[i].ring = &data_ring;
+        }
+        cases[i].count = count;
+        bench_run(&cases[i]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,205 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench_common.h"
+#include "simple_data_ringbuffer.h"
+#include "simple_pool.h"
+#include "simple_ringbuffer.h"
+
+/*
+ * Single thread throughput of the three RINGBUF APIs, the reference numbers to compare any
+ * change of the library against:
+ *   - simple_ringbuffer_t put/get of 1 byte to 64 KB,
+ *   - simple_ringbuffer_t framed messages (8 byte header, body, 4 byte trailer) of a 16 byte to
+ *     4 KB body, three puts and gets against one putv/getv,
+ *   - simple_data_ringbuffer_t put/get (copy) and enqueue_get/dequeue_peek (in place) of 4 to
+ *     1024 byte items,
+ *   - simple_pool_t alloc/free bursts.
+ * Every case runs with a power of 2 and an odd capacity. One op is a put and its get (an
+ * alloc and its free), mb_per_s counts the item bytes handed over, copied or in place.
+ */
+
+#define BENCH_BYTE_POW2_CNT  (128u * 1024)
+#define BENCH_BYTE_ODD_CNT   (128u * 1024 - 1)
+#define BENCH_BYTE_MAX_SIZE  (64u * 1024)
+#define BENCH_DATA_POW2_CNT  1024
+#define BENCH_DATA_ODD_CNT   1023
+#define BENCH_DATA_MAX_SIZE  1024
+#define BENCH_POOL_BURST_CNT 16
+#define BENCH_BUDGET_BYTES   (1ull << 30)
+#define BENCH_DEFAULT_COUNT  4000000
+
+static uint8_t bench_storage[BENCH_BYTE_POW2_CNT > BENCH_DATA_POW2_CNT * BENCH_DATA_MAX_SIZE
+                                     ? BENCH_BYTE_POW2_CNT
+                                     : BENCH_DATA_POW2_CNT * BENCH_DATA_MAX_SIZE];
+static uint8_t bench_in[BENCH_BYTE_MAX_SIZE];
+static uint8_t bench_out[BENCH_BYTE_MAX_SIZE];
+static void *bench_fifo_storage[BENCH_DATA_POW2_CNT];
+
+static uint64_t bench_check;
+
+/**
+ * @brief  Number of ops of a case, count at most and no more than the byte budget.
+ */
+static uint64_t bench_ops(uint64_t count, uint32_t size)
+{
+    uint64_t ops = BENCH_BUDGET_BYTES / size;
+
+    return ops < count ? ops : count;
+}
+
+static void bench_report(const char *api, const char *variant, uint32_t capacity, uint32_t size,
+                         uint64_t ops, uint64_t begin)
+{
+    double seconds = (double)(bench_now_ns() - begin) / 1e9;
+
+    printf("suite,%s,%s,%u,%u,%llu,%.6f,%.3f,%.1f,%llu\n", api, variant, capacity, size,
+           (unsigned long long)ops, seconds, (double)ops / seconds / 1e6,
+           (double)ops * size / seconds / 1e6, (unsigned long long)bench_check);
+}
+
+static void bench_byte(uint32_t capacity, uint64_t count)
+{
+    simple_ringbuffer_t ringbuf;
+
+    for (uint32_t size = 1; size <= BENCH_BYTE_MAX_SIZE; size <<= 1)
+    {
+        uint64_t ops = bench_ops(count, size);
+
+        simple_ringbuffer_init(&ringbuf, capacity, bench_storage);
+        uint64_t begin = bench_now_ns();
+        for (uint64_t i = 0; i < ops; i++)
+        {
+            bench_in[0] = (uint8_t)i;
+            simple_ringbuffer_put(&ringbuf, bench_in, size);
+            simple_ringbuffer_get(&ringbuf, bench_out, size);
+            bench_check += bench_out[0];
+        }
+        bench_report("byte", "put_get", capacity, size, ops, begin);
+    }
+}
+
+static void bench_byte_iov(uint32_t capacity, uint64_t count)
+{
+    simple_ringbuffer_t ringbuf;
+    uint8_t header[8], trailer[4];
+
+    memset(header, 0x5a, sizeof(header));
+    memset(trailer, 0xa5, sizeof(trailer));
+    for (uint32_t size = 16; size <= 4096; size <<= 2)
+    {
+        simple_ringbuffer_span_t iov[3] = {{header, 8}, {bench_in, size}, {trailer, 4}};
+        simple_ringbuffer_span_t riov[3] = {{header, 8}, {bench_out, size}, {trailer, 4}};
+        uint64_t ops = bench_ops(count, size + 12);
+
+        simple_ringbuffer_init(&ringbuf, capacity, bench_storage);
+        uint64_t begin = bench_now_ns();
+        for (uint64_t i = 0; i < ops; i++)
+        {
+            bench_in[0] = (uint8_t)i;
+            simple_ringbuffer_put(&ringbuf, header, 8);
+            simple_ringbuffer_put(&ringbuf, bench_in, size);
+            simple_ringbuffer_put(&ringbuf, trailer, 4);
+            simple_ringbuffer_get(&ringbuf, header, 8);
+            simple_ringbuffer_get(&ringbuf, bench_out, size);
+            simple_ringbuffer_get(&ringbuf, trailer, 4);
+            bench_check += bench_out[0];
+        }
+        bench_report("byte", "put3_get3", capacity, size + 12, ops, begin);
+
+        simple_ringbuffer_init(&ringbuf, capacity, bench_storage);
+        begin = bench_now_ns();
+        for (uint64_t i = 0; i < ops; i++)
+        {
+            bench_in[0] = (uint8_t)i;
+            simple_ringbuffer_putv(&ringbuf, iov, 3);
+            simple_ringbuffer_getv(&ringbuf, riov, 3);
+            bench_check += bench_out[0];
+        }
+        bench_report("byte", "putv_getv", capacity, size + 12, ops, begin);
+    }
+}
+
+static void bench_data(uint32_t capacity, uint64_t count)
+{
+    simple_data_ringbuffer_t ringbuf;
+
+    for (uint32_t size = 4; size <= BENCH_DATA_MAX_SIZE; size <<= 1)
+    {
+        uint64_t ops = bench_ops(count, size);
+
+        simple_data_ringbuffer_init(&ringbuf, capacity, size, bench_storage);
+        uint64_t begin = bench_now_ns();
+        for (uint64_t i = 0; i < ops; i++)
+        {
+            bench_in[0] = (uint8_t)i;
+            simple_data_ringbuffer_put(&ringbuf, bench_in);
+            simple_data_ringbuffer_get(&ringbuf, bench_out);
+            bench_check += bench_out[0];
+        }
+        bench_report("data", "put_get", capacity, size, ops, begin);
+
+        simple_data_ringbuffer_init(&ringbuf, capacity, size, bench_storage);
+        begin = bench_now_ns();
+        for (uint64_t i = 0; i < ops; i++)
+        {
+            uint8_t *item;
+            int index = simple_data_ringbuffer_enqueue_get(&ringbuf, (void **)&item);
+
+            /* in place, write and read the first word like a header would be */
+            *(uint32_t *)item = (uint32_t)i;
+            simple_data_ringbuffer_enqueue(&ringbuf, index);
+            item = simple_data_ringbuffer_dequeue_peek(&ringbuf);
+            bench_check += *(uint32_t *)item;
+            simple_data_ringbuffer_dequeue(&ringbuf);
+        }
+        bench_report("data", "enqueue_dequeue", capacity, size, ops, begin);
+    }
+}
+
+static void bench_pool(uint32_t capacity, uint64_t count)
+{
+    simple_pool_t spool;
+    uint8_t *blocks[BENCH_POOL_BURST_CNT];
+
+    for (uint32_t size = 16; size <= BENCH_DATA_MAX_SIZE; size <<= 2)
+    {
+        /* no copy, the block size does not count against the byte budget */
+        uint64_t ops = count / BENCH_POOL_BURST_CNT * BENCH_POOL_BURST_CNT;
+
+        simple_pool_init(&spool, bench_fifo_storage, bench_storage, capacity, size);
+        uint64_t begin = bench_now_ns();
+        for (uint64_t i = 0; i < ops; i += BENCH_POOL_BURST_CNT)
+        {
+            for (int j = 0; j < BENCH_POOL_BURST_CNT; j++)
+            {
+                SIMPLE_POOL_DEQUEUE(&spool, blocks[j]);
+                blocks[j][0] = (uint8_t)j;
+            }
+            for (int j = 0; j < BENCH_POOL_BURST_CNT; j++)
+            {
+                bench_check += blocks[j][0];
+                SIMPLE_POOL_ENQUEUE(&spool, blocks[j]);
+            }
+        }
+        bench_report("pool", "alloc_free", capacity, size, ops, begin);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    uint64_t count = argc > 1 ? strtoull(argv[1], NULL, 0) : BENCH_DEFAULT_COUNT;
+
+    memset(bench_in, 0x5a, sizeof(bench_in));
+    printf("bench,api,variant,capacity,size,ops,seconds,mops_per_s,mb_per_s,check\n");
+    bench_byte(BENCH_BYTE_POW2_CNT, count);
+    bench_byte(BENCH_BYTE_ODD_CNT, count);
+    bench_byte_iov(BENCH_BYTE_POW2_CNT, count);
+    bench_byte_iov(BENCH_BYTE_ODD_CNT, count);
+    bench_data(BENCH_DATA_POW2_CNT, count);
+    bench_data(BENCH_DATA_ODD_CNT, count);
+    bench_pool(BENCH_DATA_POW2_CNT, count);
+    bench_pool(BENCH_DATA_ODD_CNT, count);
+
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench_common.h"
+#include "simple_data_ringbuffer.h"
+#include "simple_data_ringbuffer_typed.h"
+
+/*
+ * Burst put/get of small structs on one thread: simple_data_ringbuffer_t, where item size and
+ * count are runtime fields ("generic"), against SIMPLE_DATA_RINGBUFFER_DECLARE_TYPED, where
+ * they are compile-time constants ("typed").
+ */
+
+#define BENCH_RING_CNT      1024
+#define BENCH_BURST_CNT     256
+#define BENCH_DEFAULT_COUNT 20000000
+
+typedef struct
+{
+    uint64_t word[1];
+} bench_item8_t;
+
+typedef struct
+{
+    uint64_t word[2];
+} bench_item16_t;
+
+typedef struct
+{
+    uint64_t word[4];
+} bench_item32_t;
+
+static uint8_t bench_storage[BENCH_RING_CNT * sizeof(bench_item32_t)];
+
+#define BENCH_TYPED(_item)                                                                         \
+    SIMPLE_DATA_RINGBUFFER_DECLARE_TYPED(bench_ring_##_item, _item, BENCH_RING_CNT)                \
+                                                                                                   \
+    static _item bench_in_##_item[BENCH_BURST_CNT];                                                \
+    static _item bench_out_##_item[BENCH_BURST_CNT];                                               \
+                                                                                                   \
+    static void bench_generic_##_item(uint64_t count)                                              \
+    {                                                                                              \
+        simple_data_ringbuffer_t ringbuf;                                                          \
+        uint64_t bursts = count / BENCH_BURST_CNT;                                                 \
+                                                                                                   \
+        simple_data_ringbuffer_init(&ringbuf, BENCH_RING_CNT, sizeof(_item), bench_storage);       \
+                                                                                                   \
+        uint64_t begin = bench_now_ns();                                                           \
+        for (uint64_t i = 0; i < bursts; i++)                                                      \
+        {                                                                                          \
+            bench_in_##_item[0].word[0] = i;                                                       \
+            for (int j = 0; j < BENCH_BURST_CNT; j++)                                              \
+            {                                                                                      \
+                simple_data_ringbuffer_put(&ringbuf, &bench_in_##_item[j]);                        \
+            }                                                                                      \
+            for (int j = 0; j < BENCH_BURST_CNT; j++)                                              \
+            {                                                                                      \
+                simple_data_ringbuffer_get(&ringbuf, &bench_out_##_item[j]);                       \
+            }                                                                                      \
+            bench_check(bench_out_##_item[0].word[0], i, "generic", sizeof(_item));                \
+        }                                                                                          \
+        bench_report("generic", sizeof(_item), bursts * BENCH_BURST_CNT, begin);                   \
+    }                                                                                              \
+                                                                                                   \
+    static void bench_typed_##_item(uint64_t count)                                                \
+    {                                                                                              \
+        static bench_ring_##_item##_t ringbuf;                                                     \
+        uint64_t bursts = count / BENCH_BURST_CNT;                                                 \
+                                                                                                   \
+        bench_ring_##_item##_init(&ringbuf);                                                       \
+                                                                                                   \
+        uint64_t begin = bench_now_ns();                                                           \
+        for (uint64_t i = 0; i < bursts; i++)                                                      \
+        {                                                                                          \
+            bench_in_##_item[0].word[0] = i;                                                       \
+            for (int j = 0; j < BENCH_BURST_CNT; j++)                                              \
+            {                                                                                      \
+                bench_ring_##_item##_put(&ringbuf, &bench_in_##_item[j]);                          \
+            }                                                                                      \
+            for (int j = 0; j < BENCH_BURST_CNT; j++)                                              \
+            {                                                                                      \
+                bench_ring_##_item##_get(&ringbuf, &bench_out_##_item[j]);                         \
+            }                                                                                      \
+            bench_check(bench_out_##_item[0].word[0], i, "typed", sizeof(_item));                  \
+        }                                                                                          \
+        bench_report("typed", sizeof(_item), bursts * BENCH_BURST_CNT, begin);                     \
+    }
+
+static void bench_check(uint64_t got, uint64_t expect, const char *variant, size_t item_size)
+{
+    if (got != expect)
+    {
+        printf("typed,%s,%zu: data mismatch\n", variant, item_size);
+        exit(1);
+    }
+}
+
+static void bench_report(const char *variant, size_t item_size, uint64_t ops, uint64_t begin)
+{
+    double seconds = (double)(bench_now_ns() - begin) / 1e9;
+
+    printf("typed,%s,%zu,%u,%u,%llu,%.6f,%.3f,%.2f\n", variant, item_size, BENCH_RING_CNT,
+           BENCH_BURST_CNT, (unsigned long long)ops, seconds, ops / seconds / 1e6,
+           seconds * 1e9 / ops);
+}
+
+BENCH_TYPED(bench_item8_t)
+BENCH_TYPED(bench_item16_t)
+BENCH_TYPED(bench_item32_t)
+
+int main(int argc, char *argv[])
+{
+    uint64_t count = argc > 1 ? strtoull(argv[1], NULL, 0) : BENCH_DEFAULT_COUNT;
+
+    printf("bench,variant,item_size,capacity,burst,items,seconds,mitems_per_sec,ns_per_item\n");
+    bench_generic_bench_item8_t(count);
+    bench_typed_bench_item8_t(count);
+    bench_generic_bench_item16_t(count);
+    bench_typed_bench_item16_t(count);
+    bench_generic_bench_item32_t(count);
+    bench_typed_bench_item32_t(count);
+
+    return 0;
+}
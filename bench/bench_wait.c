@@ -0,0 +1,111 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench_common.h"
+#include "simple_ringbuffer_wait.h"
+
+#if !SIMPLE_RINGBUFFER_SPSC
+#error "bench_wait needs SIMPLE_RINGBUFFER_SPSC=1"
+#endif
+
+/*
+ * Blocking get on a mostly idle RINGBUF: the producer sends a timestamp every BENCH_GAP_US, the
+ * consumer waits for it with every wait strategy. Reports the delivery latency and the cpu time
+ * burnt by the consumer thread while waiting.
+ */
+
+#define BENCH_RING_CNT      256
+#define BENCH_GAP_US        50
+#define BENCH_DEFAULT_COUNT 20000
+
+typedef struct bench_wait_case
+{
+    const char *variant;
+    simple_ringbuffer_wait_strategy_t strategy;
+    simple_data_ringbuffer_t ringbuf;
+    simple_ringbuffer_waiter_t waiter;
+    uint64_t count;
+} bench_wait_case_t;
+
+static uint64_t bench_storage[BENCH_RING_CNT];
+
+static uint64_t bench_thread_cpu_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void *bench_producer(void *arg)
+{
+    bench_wait_case_t *bc = arg;
+
+    bench_pin_thread(1);
+    for (uint64_t i = 0; i < bc->count; i++)
+    {
+        uint64_t next = bench_now_ns() + BENCH_GAP_US * 1000u;
+        uint32_t spins = 0;
+
+        while (bench_now_ns() < next)
+        {
+            bench_relax(&spins);
+        }
+        uint64_t stamp = bench_now_ns();
+        simple_data_ringbuffer_put_wait(&bc->ringbuf, &bc->waiter, &stamp, -1);
+    }
+
+    return NULL;
+}
+
+static void bench_run(bench_wait_case_t *bc)
+{
+    pthread_t producer;
+    uint64_t total = 0;
+    uint64_t max = 0;
+
+    simple_data_ringbuffer_init(&bc->ringbuf, BENCH_RING_CNT, sizeof(uint64_t), bench_storage);
+    simple_ringbuffer_waiter_init(&bc->waiter, bc->strategy);
+
+    bench_pin_thread(0);
+    pthread_create(&producer, NULL, bench_producer, bc);
+
+    uint64_t cpu = bench_thread_cpu_ns();
+    uint64_t begin = bench_now_ns();
+    for (uint64_t i = 0; i < bc->count; i++)
+    {
+        uint64_t stamp;
+
+        simple_data_ringbuffer_get_wait(&bc->ringbuf, &bc->waiter, &stamp, -1);
+        uint64_t latency = bench_now_ns() - stamp;
+        total += latency;
+        max = latency > max ? latency : max;
+    }
+    double seconds = (double)(bench_now_ns() - begin) / 1e9;
+    double cpu_seconds = (double)(bench_thread_cpu_ns() - cpu) / 1e9;
+    pthread_join(producer, NULL);
+
+    printf("wait,%s,%u,%llu,%.6f,%.1f,%.1f,%.6f,%.1f\n", bc->variant, BENCH_GAP_US,
+           (unsigned long long)bc->count, seconds, (double)total / bc->count, (double)max / 1e3,
+           cpu_seconds, cpu_seconds * 100 / seconds);
+}
+
+int main(int argc, char *argv[])
+{
+    uint64_t count = argc > 1 ? strtoull(argv[1], NULL, 0) : BENCH_DEFAULT_COUNT;
+
+    static bench_wait_case_t cases[] = {
+            {"spin", SIMPLE_RINGBUFFER_WAIT_SPIN},
+            {"yield", SIMPLE_RINGBUFFER_WAIT_YIELD},
+            {"futex", SIMPLE_RINGBUFFER_WAIT_FUTEX},
+    };
+
+    printf("bench,variant,gap_us,items,seconds,avg_latency_ns,max_latency_us,consumer_cpu_seconds,"
+           "consumer_cpu_pct\n");
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        cases[i].count = count;
+        bench_run(&cases[i]);
+    }
+
+    return 0;
+}
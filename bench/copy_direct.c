@@ -0,0 +1,24 @@
+#include <string.h>
+
+#include "bench_copy.h"
+
+/*
+ * The baseline of bench_copy: its loops built with SIMPLE_RINGBUFFER_COPY_DISPATCH=0 and linked
+ * into one object with a copy of the library built the same way, the inline memcpy() of the
+ * default build. The Makefile keeps only the two functions below global in that object, so the
+ * two copies of the library do not clash.
+ */
+
+#if SIMPLE_RINGBUFFER_COPY_DISPATCH
+#error "copy_direct.c is the SIMPLE_RINGBUFFER_COPY_DISPATCH=0 baseline"
+#endif
+
+double bench_copy_direct_data(uint32_t size, uint64_t ops, uint64_t *check)
+{
+    return bench_copy_data(size, ops, check);
+}
+
+double bench_copy_direct_byte(uint32_t size, uint64_t ops, uint64_t *check)
+{
+    return bench_copy_byte(size, ops, check);
+}
@@ -4,6 +4,16 @@
 extern void test_ringbuffer(void);
 extern void test_data_ringbuffer(void);
 extern void test_pool_ringbuffer(void);
+extern void test_spsc_ringbuffer(void);
+extern void test_mpmc_data_ringbuffer(void);
+extern void test_mpmc_pool(void);
+extern void test_typed_ringbuffer(void);
+extern void test_msg_ringbuffer(void);
+extern void test_wait_ringbuffer(void);
+extern void test_notify_ringbuffer(void);
+extern void test_shm_ringbuffer(void);
+extern void test_file_ringbuffer(void);
+extern void test_copy_ringbuffer(void);
 
 /**
  * @brief  Main program.
@@ -15,4 +25,14 @@ int main(void)
     test_ringbuffer();
     test_data_ringbuffer();
     test_pool_ringbuffer();
+    test_spsc_ringbuffer();
+    test_mpmc_data_ringbuffer();
+    test_mpmc_pool();
+    test_typed_ringbuffer();
+    test_msg_ringbuffer();
+    test_wait_ringbuffer();
+    test_notify_ringbuffer();
+    test_shm_ringbuffer();
+    test_file_ringbuffer();
+    test_copy_ringbuffer();
 }
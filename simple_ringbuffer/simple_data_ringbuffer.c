@@ -1,69 +1,472 @@
 #include <string.h>
 
 #include "simple_data_ringbuffer.h"
+#include "simple_ringbuffer_copy.h"
 
 #ifndef MIN
 #define MIN(a, b) (((a) < (b)) ? (a) : (b))
 #endif
 
-#define DATA_RINGBUFFER_INDEX_TO_PTR(_index, _total_size)                                          \
-    ((_index >= _total_size) ? (_index - _total_size) : (_index))
+#ifndef MAX
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
+#endif
 
-int simple_data_ringbuffer_put(simple_data_ringbuffer_t *ringbuf, void *buffer)
+/*
+ * _mask is the index_mask of the RINGBUF, 2 * total_size - 1 for a power of 2 size and 0
+ * otherwise. With a power of 2 size the index wraps with a mask instead of compare and subtract,
+ * the index values are the same in both cases.
+ */
+#define DATA_RINGBUFFER_INDEX_TO_PTR(_index, _total_size, _mask)                                   \
+    ((_mask) ? ((_index) & ((_mask) >> 1))                                                         \
+             : ((_index >= _total_size) ? (_index - _total_size) : (_index)))
+
+#define DATA_RINGBUFFER_USED_SIZE(_write_index, _read_index, _total_size, _mask)                   \
+    ((_mask) ? ((_write_index - _read_index) & (_mask))                                            \
+     : (_write_index >= _read_index) ? (_write_index - _read_index)                                \
+                                     : ((_total_size << 1) - (_read_index - _write_index)))
+
+/**
+ * @brief  Copy one item, an item never wraps.
+ */
+static inline void data_ringbuffer_copy(void *dst, const void *src, uint32_t item_size)
+{
+    simple_ringbuffer_copy(dst, src, NULL, NULL, item_size, item_size);
+}
+
+#if SIMPLE_DATA_RINGBUFFER_WIDE
+/**
+ * @brief  Copy n items of one segment, in pieces of at most 1 GB, each a multiple of item_size.
+ */
+static void data_ringbuffer_copy_pieces(uint8_t *dst, const uint8_t *src, simple_data_index_t n,
+                                        uint32_t item_size)
 {
-    uint16_t write_index;
-    uint16_t wptr;
+    simple_data_index_t piece = MAX(1, 0x40000000 / item_size);
 
-    if (simple_data_ringbuffer_reserve_size(ringbuf) == 0)
+    while (n != 0)
     {
-        return 0;
+        simple_data_index_t cnt = MIN(piece, n);
+
+        simple_ringbuffer_copy(dst, src, NULL, NULL, cnt * item_size, cnt * item_size);
+        dst += (size_t)cnt * item_size;
+        src += (size_t)cnt * item_size;
+        n -= cnt;
+    }
+}
+#endif
+
+/**
+ * @brief  Copy n items, the first l from src to dst, the rest from src2 to dst2.
+ * @details In WIDE mode n * item_size may not fit the 32 bit byte count of a copy, the items
+ *   then go in pieces.
+ */
+static inline void data_ringbuffer_copy_n(uint8_t *dst, const uint8_t *src, uint8_t *dst2,
+                                          const uint8_t *src2, simple_data_index_t l,
+                                          simple_data_index_t n, uint32_t item_size)
+{
+#if SIMPLE_DATA_RINGBUFFER_WIDE
+    if ((uint64_t)n * item_size > UINT32_MAX)
+    {
+        data_ringbuffer_copy_pieces(dst, src, l, item_size);
+        data_ringbuffer_copy_pieces(dst2, src2, n - l, item_size);
+        return;
+    }
+#endif
+    simple_ringbuffer_copy(dst, src, dst2, src2, (uint32_t)l * item_size,
+                           (uint32_t)n * item_size);
+}
+
+/**
+ * @brief  Producer side view of read_index.
+ * @details In SPSC mode the producer works on its own copy of read_index, and only loads the
+ *   consumer cache line again when that copy does not leave room for n items.
+ */
+static inline simple_data_index_t
+data_ringbuffer_producer_read_index(simple_data_ringbuffer_t *ringbuf,
+                                    simple_data_index_t write_index, simple_data_index_t n,
+                                    simple_data_index_t mask)
+{
+#if SIMPLE_RINGBUFFER_SPSC
+    simple_data_index_t read_index = ringbuf->read_index_cache;
+
+    if (ringbuf->total_size - DATA_RINGBUFFER_USED_SIZE(write_index, read_index,
+                                                        ringbuf->total_size, mask) <
+        n)
+    {
+        read_index = SIMPLE_RINGBUFFER_LOAD_ACQUIRE(ringbuf->read_index);
+        ringbuf->read_index_cache = read_index;
+    }
+
+    return read_index;
+#else
+    return SIMPLE_RINGBUFFER_LOAD_ACQUIRE(ringbuf->read_index);
+#endif
+}
+
+/**
+ * @brief  Consumer side view of write_index.
+ * @details In SPSC mode the consumer works on its own copy of write_index, and only loads the
+ *   producer cache line again when that copy does not hold n items.
+ */
+static inline simple_data_index_t
+data_ringbuffer_consumer_write_index(simple_data_ringbuffer_t *ringbuf,
+                                     simple_data_index_t read_index, simple_data_index_t n,
+                                     simple_data_index_t mask)
+{
+#if SIMPLE_RINGBUFFER_SPSC
+    simple_data_index_t write_index = ringbuf->write_index_cache;
+
+    if (DATA_RINGBUFFER_USED_SIZE(write_index, read_index, ringbuf->total_size, mask) < n)
+    {
+        write_index = SIMPLE_RINGBUFFER_LOAD_ACQUIRE(ringbuf->write_index);
+        ringbuf->write_index_cache = write_index;
+    }
+
+    return write_index;
+#else
+    return SIMPLE_RINGBUFFER_LOAD_ACQUIRE(ringbuf->write_index);
+#endif
+}
+
+/**
+ * @brief  Move an index n items forward, in [0, 2 * total_size).
+ */
+static inline simple_data_index_t data_ringbuffer_index_add(simple_data_index_t index,
+                                                            simple_data_index_t n,
+                                                            simple_data_index_t total_size,
+                                                            simple_data_index_t mask)
+{
+    uint32_t next = (uint32_t)index + n;
+
+    if (mask)
+    {
+        next &= mask;
     }
+    else if (next >= ((uint32_t)total_size << 1))
+    {
+        next -= ((uint32_t)total_size << 1);
+    }
+
+    return (simple_data_index_t)next;
+}
+
+/**
+ * @brief  Count n items put at write_index, nothing without SIMPLE_RINGBUFFER_STATS.
+ * @details read_index is the producer view of it. In SPSC mode that is a cached copy which may
+ *   be far behind, it is only reloaded when it would raise high_water.
+ */
+static inline void data_ringbuffer_stats_put(simple_data_ringbuffer_t *ringbuf,
+                                             simple_data_index_t write_index,
+                                             simple_data_index_t read_index,
+                                             simple_data_index_t n, simple_data_index_t mask)
+{
+#if SIMPLE_RINGBUFFER_STATS
+    uint32_t high_water = SIMPLE_RINGBUFFER_LOAD_RELAXED(ringbuf->put_stats.high_water);
+    uint32_t used;
 
-    wptr = DATA_RINGBUFFER_INDEX_TO_PTR(ringbuf->write_index, ringbuf->total_size);
-    memcpy(ringbuf->buffer + wptr * ringbuf->item_size, buffer, ringbuf->item_size);
+    if (n == 0)
+    {
+        return;
+    }
+    SIMPLE_RINGBUFFER_STATS_ADD(ringbuf->put_stats.items, n);
+    SIMPLE_RINGBUFFER_STATS_ADD(ringbuf->put_stats.bytes, (uint64_t)n * ringbuf->item_size);
+    SIMPLE_RINGBUFFER_STATS_ADD(ringbuf->put_stats.wraps,
+                                (uint32_t)DATA_RINGBUFFER_INDEX_TO_PTR(write_index,
+                                                                       ringbuf->total_size,
+                                                                       mask) +
+                                                n >=
+                                        ringbuf->total_size);
 
-    write_index = ringbuf->write_index + 1;
-    if (write_index >= (ringbuf->total_size << 1))
+    used = DATA_RINGBUFFER_USED_SIZE(write_index, read_index, ringbuf->total_size, mask) + n;
+#if SIMPLE_RINGBUFFER_SPSC
+    if (used > high_water)
     {
-        write_index -= (ringbuf->total_size << 1);
+        read_index = SIMPLE_RINGBUFFER_LOAD_ACQUIRE(ringbuf->read_index);
+        ringbuf->read_index_cache = read_index;
+        used = DATA_RINGBUFFER_USED_SIZE(write_index, read_index, ringbuf->total_size, mask) + n;
     }
-    ringbuf->write_index = write_index;
+#endif
+    if (used > high_water)
+    {
+        SIMPLE_RINGBUFFER_STORE_RELAXED(ringbuf->put_stats.high_water, used);
+    }
+#endif
+}
+
+/**
+ * @brief  Count a put which found no room for all of its items.
+ */
+static inline void data_ringbuffer_stats_full(simple_data_ringbuffer_t *ringbuf, int full)
+{
+#if SIMPLE_RINGBUFFER_STATS
+    SIMPLE_RINGBUFFER_STATS_ADD(ringbuf->put_stats.full, full != 0);
+#endif
+}
+
+/**
+ * @brief  Count n items get, and a get which found the RINGBUF empty.
+ */
+static inline void data_ringbuffer_stats_get(simple_data_ringbuffer_t *ringbuf,
+                                             simple_data_index_t n, int empty)
+{
+#if SIMPLE_RINGBUFFER_STATS
+    SIMPLE_RINGBUFFER_STATS_ADD(ringbuf->get_stats.items, n);
+    SIMPLE_RINGBUFFER_STATS_ADD(ringbuf->get_stats.bytes, (uint64_t)n * ringbuf->item_size);
+    SIMPLE_RINGBUFFER_STATS_ADD(ringbuf->get_stats.empty, empty != 0);
+#endif
+}
+
+/**
+ * @brief  Body of simple_data_ringbuffer_put(), inlined once for each kind of size.
+ */
+static inline int data_ringbuffer_put(simple_data_ringbuffer_t *ringbuf, void *buffer,
+                                      simple_data_index_t mask)
+{
+    simple_data_index_t write_index = SIMPLE_RINGBUFFER_LOAD_RELAXED(ringbuf->write_index);
+    simple_data_index_t read_index =
+            data_ringbuffer_producer_read_index(ringbuf, write_index, 1, mask);
+    simple_data_index_t wptr;
+
+    if (DATA_RINGBUFFER_USED_SIZE(write_index, read_index, ringbuf->total_size, mask) ==
+        ringbuf->total_size)
+    {
+        data_ringbuffer_stats_full(ringbuf, 1);
+        return 0;
+    }
+    data_ringbuffer_stats_put(ringbuf, write_index, read_index, 1, mask);
+
+    wptr = DATA_RINGBUFFER_INDEX_TO_PTR(write_index, ringbuf->total_size, mask);
+    data_ringbuffer_copy(ringbuf->buffer + (size_t)wptr * ringbuf->item_size, buffer,
+                         ringbuf->item_size);
+
+    write_index = data_ringbuffer_index_add(write_index, 1, ringbuf->total_size, mask);
+    /* publish the item to the consumer */
+    SIMPLE_RINGBUFFER_STORE_RELEASE(ringbuf->write_index, write_index);
 
     return 1;
 }
 
-int simple_data_ringbuffer_get(simple_data_ringbuffer_t *ringbuf, void *buffer)
+/**
+ * @brief  Body of simple_data_ringbuffer_get(), inlined once for each kind of size.
+ */
+static inline int data_ringbuffer_get(simple_data_ringbuffer_t *ringbuf, void *buffer,
+                                      simple_data_index_t mask)
 {
-    uint16_t read_index;
-    uint16_t rptr;
-    if (simple_data_ringbuffer_size(ringbuf) == 0)
+    simple_data_index_t read_index = SIMPLE_RINGBUFFER_LOAD_RELAXED(ringbuf->read_index);
+    simple_data_index_t write_index =
+            data_ringbuffer_consumer_write_index(ringbuf, read_index, 1, mask);
+    simple_data_index_t rptr;
+    if (read_index == write_index)
     {
+        data_ringbuffer_stats_get(ringbuf, 0, 1);
         return 0;
     }
+    data_ringbuffer_stats_get(ringbuf, 1, 0);
 
     if (buffer != NULL)
     {
-        rptr = DATA_RINGBUFFER_INDEX_TO_PTR(ringbuf->read_index, ringbuf->total_size);
-        memcpy(buffer, ringbuf->buffer + rptr * ringbuf->item_size, ringbuf->item_size);
+        rptr = DATA_RINGBUFFER_INDEX_TO_PTR(read_index, ringbuf->total_size, mask);
+        data_ringbuffer_copy(buffer, ringbuf->buffer + (size_t)rptr * ringbuf->item_size,
+                             ringbuf->item_size);
+    }
+
+    read_index = data_ringbuffer_index_add(read_index, 1, ringbuf->total_size, mask);
+    /* release the slot to the producer */
+    SIMPLE_RINGBUFFER_STORE_RELEASE(ringbuf->read_index, read_index);
+
+    return 1;
+}
+
+int simple_data_ringbuffer_put(simple_data_ringbuffer_t *ringbuf, void *buffer)
+{
+    /* power of 2 size, every wrap is a mask */
+    if (ringbuf->index_mask)
+    {
+        return data_ringbuffer_put(ringbuf, buffer, ringbuf->index_mask);
     }
 
-    read_index = ringbuf->read_index + 1;
-    if (read_index >= (ringbuf->total_size << 1))
+    return data_ringbuffer_put(ringbuf, buffer, 0);
+}
+
+int simple_data_ringbuffer_get(simple_data_ringbuffer_t *ringbuf, void *buffer)
+{
+    /* power of 2 size, every wrap is a mask */
+    if (ringbuf->index_mask)
     {
-        read_index -= (ringbuf->total_size << 1);
+        return data_ringbuffer_get(ringbuf, buffer, ringbuf->index_mask);
     }
-    ringbuf->read_index = read_index;
 
-    return 1;
+    return data_ringbuffer_get(ringbuf, buffer, 0);
+}
+
+int simple_data_ringbuffer_put_overwrite(simple_data_ringbuffer_t *ringbuf, void *buffer)
+{
+    simple_data_index_t mask = ringbuf->index_mask;
+    simple_data_index_t write_index = SIMPLE_RINGBUFFER_LOAD_RELAXED(ringbuf->write_index);
+    simple_data_index_t read_index =
+            data_ringbuffer_producer_read_index(ringbuf, write_index, 1, mask);
+    simple_data_index_t wptr;
+    int dropped = 0;
+
+    /* full: push the oldest item out, unless the consumer takes it first */
+    while (DATA_RINGBUFFER_USED_SIZE(write_index, read_index, ringbuf->total_size, mask) ==
+           ringbuf->total_size)
+    {
+        simple_data_index_t next =
+                data_ringbuffer_index_add(read_index, 1, ringbuf->total_size, mask);
+
+        if (SIMPLE_RINGBUFFER_CAS(ringbuf->read_index, &read_index, next))
+        {
+            dropped = 1;
+            read_index = next;
+        }
+    }
+#if SIMPLE_RINGBUFFER_SPSC
+    ringbuf->read_index_cache = read_index;
+#endif
+    data_ringbuffer_stats_put(ringbuf, write_index, read_index, 1, mask);
+
+    if (dropped != 0)
+    {
+        /* a consumer copying the dropped item sees the count change, the item is written after */
+        SIMPLE_RINGBUFFER_STORE_RELAXED(ringbuf->overwritten,
+                                        SIMPLE_RINGBUFFER_LOAD_RELAXED(ringbuf->overwritten) + 1);
+        SIMPLE_RINGBUFFER_FENCE_RELEASE();
+    }
+
+    wptr = DATA_RINGBUFFER_INDEX_TO_PTR(write_index, ringbuf->total_size, mask);
+    data_ringbuffer_copy(ringbuf->buffer + (size_t)wptr * ringbuf->item_size, buffer,
+                         ringbuf->item_size);
+
+    /* publish the item to the consumer */
+    SIMPLE_RINGBUFFER_STORE_RELEASE(
+            ringbuf->write_index,
+            data_ringbuffer_index_add(write_index, 1, ringbuf->total_size, mask));
+
+    return dropped;
+}
+
+int simple_data_ringbuffer_get_overwrite(simple_data_ringbuffer_t *ringbuf, void *buffer)
+{
+    simple_data_index_t mask = ringbuf->index_mask;
+
+    while (1)
+    {
+        /* the producer moves read_index too, the cached write_index may be behind it */
+        uint32_t overwritten = SIMPLE_RINGBUFFER_LOAD_ACQUIRE(ringbuf->overwritten);
+        simple_data_index_t read_index = SIMPLE_RINGBUFFER_LOAD_ACQUIRE(ringbuf->read_index);
+        simple_data_index_t write_index = SIMPLE_RINGBUFFER_LOAD_ACQUIRE(ringbuf->write_index);
+        simple_data_index_t rptr;
+
+        /*
+         * Seqlock read: the producer may be overwriting this item right now. That is on purpose,
+         * the copy is only kept if overwritten did not move meanwhile, checked below. Do not
+         * drop the retry loop, it is what makes the result untorn.
+         */
+        if (read_index != write_index && buffer != NULL)
+        {
+            rptr = DATA_RINGBUFFER_INDEX_TO_PTR(read_index, ringbuf->total_size, mask);
+            data_ringbuffer_copy(buffer, ringbuf->buffer + (size_t)rptr * ringbuf->item_size,
+                                 ringbuf->item_size);
+        }
+
+        /* lapped during the copy: the producer overwrote the oldest item, it may be torn */
+        SIMPLE_RINGBUFFER_FENCE_ACQUIRE();
+        if (SIMPLE_RINGBUFFER_LOAD_RELAXED(ringbuf->overwritten) != overwritten)
+        {
+            continue;
+        }
+        if (read_index == write_index)
+        {
+            data_ringbuffer_stats_get(ringbuf, 0, 1);
+            return 0;
+        }
+        /* release the slot, unless the producer pushed read_index meanwhile */
+        if (SIMPLE_RINGBUFFER_CAS(ringbuf->read_index, &read_index,
+                                  data_ringbuffer_index_add(read_index, 1, ringbuf->total_size,
+                                                            mask)))
+        {
+            data_ringbuffer_stats_get(ringbuf, 1, 0);
+            return 1;
+        }
+    }
+}
+
+simple_data_index_t simple_data_ringbuffer_put_n(simple_data_ringbuffer_t *ringbuf, void *buffer,
+                                                 simple_data_index_t n)
+{
+    simple_data_index_t mask = ringbuf->index_mask;
+    simple_data_index_t write_index = SIMPLE_RINGBUFFER_LOAD_RELAXED(ringbuf->write_index);
+    simple_data_index_t read_index =
+            data_ringbuffer_producer_read_index(ringbuf, write_index, n, mask);
+    simple_data_index_t wptr = DATA_RINGBUFFER_INDEX_TO_PTR(write_index, ringbuf->total_size, mask);
+    simple_data_index_t l;
+
+    data_ringbuffer_stats_full(ringbuf,
+                               ringbuf->total_size - DATA_RINGBUFFER_USED_SIZE(
+                                                             write_index, read_index,
+                                                             ringbuf->total_size, mask) <
+                                       n);
+    n = MIN(n, ringbuf->total_size - DATA_RINGBUFFER_USED_SIZE(write_index, read_index,
+                                                               ringbuf->total_size, mask));
+    data_ringbuffer_stats_put(ringbuf, write_index, read_index, n, mask);
+
+    /* the items from wptr to buffer end, then the rest (if any) at the beginning of the buffer */
+    l = MIN(n, ringbuf->total_size - wptr);
+    data_ringbuffer_copy_n(ringbuf->buffer + (size_t)wptr * ringbuf->item_size, buffer,
+                           ringbuf->buffer, (uint8_t *)buffer + (size_t)l * ringbuf->item_size, l,
+                           n, ringbuf->item_size);
+
+    /* publish all the items to the consumer at once */
+    SIMPLE_RINGBUFFER_STORE_RELEASE(
+            ringbuf->write_index,
+            data_ringbuffer_index_add(write_index, n, ringbuf->total_size, mask));
+
+    return n;
+}
+
+simple_data_index_t simple_data_ringbuffer_get_n(simple_data_ringbuffer_t *ringbuf, void *buffer,
+                                                 simple_data_index_t n)
+{
+    simple_data_index_t mask = ringbuf->index_mask;
+    simple_data_index_t read_index = SIMPLE_RINGBUFFER_LOAD_RELAXED(ringbuf->read_index);
+    simple_data_index_t write_index =
+            data_ringbuffer_consumer_write_index(ringbuf, read_index, n, mask);
+    simple_data_index_t rptr = DATA_RINGBUFFER_INDEX_TO_PTR(read_index, ringbuf->total_size, mask);
+    simple_data_index_t l;
+
+    n = MIN(n, DATA_RINGBUFFER_USED_SIZE(write_index, read_index, ringbuf->total_size, mask));
+    data_ringbuffer_stats_get(ringbuf, n, read_index == write_index);
+
+    if (buffer != NULL)
+    {
+        /* the items from rptr to buffer end, then the rest (if any) from the beginning */
+        l = MIN(n, ringbuf->total_size - rptr);
+        data_ringbuffer_copy_n(buffer, ringbuf->buffer + (size_t)rptr * ringbuf->item_size,
+                               (uint8_t *)buffer + (size_t)l * ringbuf->item_size,
+                               ringbuf->buffer, l, n, ringbuf->item_size);
+    }
+
+    /* release all the slots to the producer at once */
+    SIMPLE_RINGBUFFER_STORE_RELEASE(
+            ringbuf->read_index,
+            data_ringbuffer_index_add(read_index, n, ringbuf->total_size, mask));
+
+    return n;
 }
 
 int simple_data_ringbuffer_enqueue_get(simple_data_ringbuffer_t *ringbuf, void **mem)
 {
-    uint16_t wptr = DATA_RINGBUFFER_INDEX_TO_PTR(ringbuf->write_index, ringbuf->total_size);
+    simple_data_index_t mask = ringbuf->index_mask;
+    simple_data_index_t write_index = SIMPLE_RINGBUFFER_LOAD_RELAXED(ringbuf->write_index);
+    simple_data_index_t read_index =
+            data_ringbuffer_producer_read_index(ringbuf, write_index, 1, mask);
+    simple_data_index_t wptr = DATA_RINGBUFFER_INDEX_TO_PTR(write_index, ringbuf->total_size, mask);
 
-    if (simple_data_ringbuffer_reserve_size(ringbuf) == 0)
+    if (DATA_RINGBUFFER_USED_SIZE(write_index, read_index, ringbuf->total_size, mask) ==
+        ringbuf->total_size)
     {
         /* Buffer could not be allocated */
+        data_ringbuffer_stats_full(ringbuf, 1);
         *mem = NULL; /* Signal the failure */
         return 0;    // full
     }
@@ -72,36 +475,106 @@ int simple_data_ringbuffer_enqueue_get(simple_data_ringbuffer_t *ringbuf, void *
      * buffer (last). Recall that last has not been updated,
      * so idx != last
      */
-    *mem = ringbuf->buffer + wptr * ringbuf->item_size; /* preceding buffer */
+    *mem = ringbuf->buffer + (size_t)wptr * ringbuf->item_size; /* preceding buffer */
 
-    uint16_t write_index = ringbuf->write_index + 1;
-    if (write_index >= (ringbuf->total_size << 1))
-    {
-        write_index -= (ringbuf->total_size << 1);
-    }
-
-    return write_index;
+    return data_ringbuffer_index_add(write_index, 1, ringbuf->total_size, mask);
 }
 
-void simple_data_ringbuffer_enqueue(simple_data_ringbuffer_t *ringbuf, uint16_t write_index)
+void simple_data_ringbuffer_enqueue(simple_data_ringbuffer_t *ringbuf,
+                                    simple_data_index_t write_index)
 {
-    ringbuf->write_index = write_index; /* Commit: Update write index */
+#if SIMPLE_RINGBUFFER_STATS
+    simple_data_index_t mask = ringbuf->index_mask;
+    simple_data_index_t prev = SIMPLE_RINGBUFFER_LOAD_RELAXED(ringbuf->write_index);
+
+    data_ringbuffer_stats_put(ringbuf, prev,
+                              data_ringbuffer_producer_read_index(ringbuf, prev, 0, mask),
+                              DATA_RINGBUFFER_USED_SIZE(write_index, prev, ringbuf->total_size,
+                                                        mask),
+                              mask);
+#endif
+    /* Commit: Update write index */
+    SIMPLE_RINGBUFFER_STORE_RELEASE(ringbuf->write_index, write_index);
 }
 
 void *simple_data_ringbuffer_dequeue_peek(simple_data_ringbuffer_t *ringbuf)
 {
-    uint16_t read_index;
-    uint16_t rptr;
-    if (simple_data_ringbuffer_size(ringbuf) == 0)
+    simple_data_index_t mask = ringbuf->index_mask;
+    simple_data_index_t read_index = SIMPLE_RINGBUFFER_LOAD_RELAXED(ringbuf->read_index);
+    simple_data_index_t write_index =
+            data_ringbuffer_consumer_write_index(ringbuf, read_index, 1, mask);
+    simple_data_index_t rptr;
+    if (read_index == write_index)
     {
+        data_ringbuffer_stats_get(ringbuf, 0, 1);
         return NULL;
     }
 
-    rptr = DATA_RINGBUFFER_INDEX_TO_PTR(ringbuf->read_index, ringbuf->total_size);
-    return ringbuf->buffer + rptr * ringbuf->item_size;
+    rptr = DATA_RINGBUFFER_INDEX_TO_PTR(read_index, ringbuf->total_size, mask);
+    return ringbuf->buffer + (size_t)rptr * ringbuf->item_size;
 }
 
 void simple_data_ringbuffer_dequeue(simple_data_ringbuffer_t *ringbuf)
 {
     simple_data_ringbuffer_get(ringbuf, NULL);
 }
+
+simple_data_index_t simple_data_ringbuffer_enqueue_get_n(simple_data_ringbuffer_t *ringbuf,
+                                                         void **mem, simple_data_index_t n)
+{
+    simple_data_index_t mask = ringbuf->index_mask;
+    simple_data_index_t write_index = SIMPLE_RINGBUFFER_LOAD_RELAXED(ringbuf->write_index);
+    simple_data_index_t read_index =
+            data_ringbuffer_producer_read_index(ringbuf, write_index, n, mask);
+    simple_data_index_t wptr = DATA_RINGBUFFER_INDEX_TO_PTR(write_index, ringbuf->total_size, mask);
+
+    /* free slots in a row, up to the end of the buffer */
+    n = MIN(n, ringbuf->total_size - DATA_RINGBUFFER_USED_SIZE(write_index, read_index,
+                                                               ringbuf->total_size, mask));
+    data_ringbuffer_stats_full(ringbuf, n == 0);
+    n = MIN(n, ringbuf->total_size - wptr);
+
+    *mem = n ? ringbuf->buffer + (size_t)wptr * ringbuf->item_size : NULL;
+
+    return n;
+}
+
+void simple_data_ringbuffer_enqueue_n(simple_data_ringbuffer_t *ringbuf, simple_data_index_t n)
+{
+    simple_data_index_t mask = ringbuf->index_mask;
+    simple_data_index_t write_index = SIMPLE_RINGBUFFER_LOAD_RELAXED(ringbuf->write_index);
+
+#if SIMPLE_RINGBUFFER_STATS
+    data_ringbuffer_stats_put(ringbuf, write_index,
+                              data_ringbuffer_producer_read_index(ringbuf, write_index, 0, mask),
+                              n, mask);
+#endif
+    /* Commit: Update write index once for all the slots */
+    SIMPLE_RINGBUFFER_STORE_RELEASE(
+            ringbuf->write_index,
+            data_ringbuffer_index_add(write_index, n, ringbuf->total_size, mask));
+}
+
+simple_data_index_t simple_data_ringbuffer_dequeue_peek_n(simple_data_ringbuffer_t *ringbuf,
+                                                          void **mem, simple_data_index_t n)
+{
+    simple_data_index_t mask = ringbuf->index_mask;
+    simple_data_index_t read_index = SIMPLE_RINGBUFFER_LOAD_RELAXED(ringbuf->read_index);
+    simple_data_index_t write_index =
+            data_ringbuffer_consumer_write_index(ringbuf, read_index, n, mask);
+    simple_data_index_t rptr = DATA_RINGBUFFER_INDEX_TO_PTR(read_index, ringbuf->total_size, mask);
+
+    /* items in a row, up to the end of the buffer */
+    n = MIN(n, DATA_RINGBUFFER_USED_SIZE(write_index, read_index, ringbuf->total_size, mask));
+    data_ringbuffer_stats_get(ringbuf, 0, read_index == write_index);
+    n = MIN(n, ringbuf->total_size - rptr);
+
+    *mem = n ? ringbuf->buffer + (size_t)rptr * ringbuf->item_size : NULL;
+
+    return n;
+}
+
+void simple_data_ringbuffer_dequeue_n(simple_data_ringbuffer_t *ringbuf, simple_data_index_t n)
+{
+    simple_data_ringbuffer_get_n(ringbuf, NULL, n);
+}
@@ -3,6 +3,31 @@
 
 #include <stdint.h>
 #include <stddef.h>
+
+#include "simple_ringbuffer_port.h"
+
+/**
+ * @brief   Width of the simple_data_ringbuffer_t fields.
+ * @details
+ *   SIMPLE_DATA_RINGBUFFER_WIDE = 0 (default):
+ *     Compact layout for memory constrained builds, total_size, item_size, the indices and the
+ *     item counts of the API are uint16_t. Indices run up to 2 * total_size, so a RINGBUF holds
+ *     at most 0x7fff items of at most 0xffff bytes.
+ *   SIMPLE_DATA_RINGBUFFER_WIDE = 1:
+ *     The same fields are uint32_t, a RINGBUF holds up to 0x40000000 items of any size. A batch
+ *     put or get of more than 4 GB is copied in pieces.
+ *     simple_pool_t follows the same setting.
+ */
+#ifndef SIMPLE_DATA_RINGBUFFER_WIDE
+#define SIMPLE_DATA_RINGBUFFER_WIDE 0
+#endif
+
+#if SIMPLE_DATA_RINGBUFFER_WIDE
+typedef uint32_t simple_data_index_t;
+#else
+typedef uint16_t simple_data_index_t;
+#endif
+
 /**
  * @brief   Define a Memory RINGBUF thread safe, and can full use pool.
  * @details API 1 and 2.
@@ -14,11 +39,31 @@
  */
 typedef struct simple_data_ringbuffer
 {
-    uint16_t total_size;  /* Number of buffers */
-    uint16_t item_size;   /* Stride between elements */
-    uint16_t read_index;  /* Read. Read index */
-    uint16_t write_index; /* Write. Write index */
+    simple_data_index_t total_size; /* Number of buffers */
+    simple_data_index_t item_size;  /* Stride between elements */
+    simple_data_index_t index_mask; /* SIMPLE_RINGBUFFER_INDEX_MASK(total_size) */
     uint8_t *buffer;
+
+    /* Consumer side, on its own cache line in SPSC mode */
+    SIMPLE_RINGBUFFER_CACHE_ALIGNED
+    SIMPLE_RINGBUFFER_ATOMIC(simple_data_index_t) read_index; /* Read. Read index */
+#if SIMPLE_RINGBUFFER_SPSC
+    simple_data_index_t write_index_cache; /* Read. Last write_index seen by consumer */
+#endif
+#if SIMPLE_RINGBUFFER_STATS
+    simple_ringbuffer_get_stats_t get_stats; /* Read. Consumer counters */
+#endif
+
+    /* Producer side, on its own cache line in SPSC mode */
+    SIMPLE_RINGBUFFER_CACHE_ALIGNED
+    SIMPLE_RINGBUFFER_ATOMIC(simple_data_index_t) write_index; /* Write. Write index */
+    SIMPLE_RINGBUFFER_ATOMIC(uint32_t) overwritten; /* Write. Items dropped by put_overwrite */
+#if SIMPLE_RINGBUFFER_SPSC
+    simple_data_index_t read_index_cache; /* Write. Last read_index seen by producer */
+#endif
+#if SIMPLE_RINGBUFFER_STATS
+    simple_ringbuffer_put_stats_t put_stats; /* Write. Producer counters */
+#endif
 } simple_data_ringbuffer_t;
 
 #ifndef MROUND
@@ -49,6 +94,7 @@ typedef struct simple_data_ringbuffer
     static uint8_t _name##_data_storage[_num][MROUND(_data_size)];                                 \
     static simple_data_ringbuffer_t _name = {.total_size = _num,                                   \
                                              .item_size = _data_size,                              \
+                                             .index_mask = SIMPLE_RINGBUFFER_INDEX_MASK(_num),     \
                                              .write_index = 0,                                     \
                                              .read_index = 0,                                      \
                                              .buffer = (void *)_name##_data_storage}
@@ -82,25 +128,45 @@ static inline uint32_t simple_data_ringbuffer_item_size(simple_data_ringbuffer_t
  */
 static inline void simple_data_ringbuffer_reset(simple_data_ringbuffer_t *ringbuf)
 {
-    ringbuf->write_index = 0;
-    ringbuf->read_index = 0;
+    SIMPLE_RINGBUFFER_STORE_RELAXED(ringbuf->write_index, 0);
+    SIMPLE_RINGBUFFER_STORE_RELAXED(ringbuf->read_index, 0);
+    SIMPLE_RINGBUFFER_STORE_RELAXED(ringbuf->overwritten, 0);
+#if SIMPLE_RINGBUFFER_SPSC
+    ringbuf->write_index_cache = 0;
+    ringbuf->read_index_cache = 0;
+#endif
+#if SIMPLE_RINGBUFFER_STATS
+    simple_ringbuffer_stats_clear(&ringbuf->put_stats, &ringbuf->get_stats);
+#endif
 }
 
 /**
  * @brief  Initialize the RINGBUF.
+ * @details A power of 2 total_size selects the mask based index wrap, any other size the
+ *   generic one.
  * @param  [in] ringbuf: The ringbuf to be used.
  * @param  [in] total_size: The total size of the RINGBUF.
  * @param  [in] buffer: The buffer to be used.
  */
 static inline void simple_data_ringbuffer_init(simple_data_ringbuffer_t *ringbuf,
-                                               uint16_t total_size, uint16_t item_size,
+                                               simple_data_index_t total_size,
+                                               simple_data_index_t item_size,
                                                void *buffer)
 {
     ringbuf->total_size = total_size;
     ringbuf->item_size = item_size;
-    ringbuf->write_index = 0;
-    ringbuf->read_index = 0;
+    ringbuf->index_mask = (simple_data_index_t)SIMPLE_RINGBUFFER_INDEX_MASK(total_size);
     ringbuf->buffer = buffer;
+    SIMPLE_RINGBUFFER_STORE_RELAXED(ringbuf->write_index, 0);
+    SIMPLE_RINGBUFFER_STORE_RELAXED(ringbuf->read_index, 0);
+    SIMPLE_RINGBUFFER_STORE_RELAXED(ringbuf->overwritten, 0);
+#if SIMPLE_RINGBUFFER_SPSC
+    ringbuf->write_index_cache = 0;
+    ringbuf->read_index_cache = 0;
+#endif
+#if SIMPLE_RINGBUFFER_STATS
+    simple_ringbuffer_stats_clear(&ringbuf->put_stats, &ringbuf->get_stats);
+#endif
 }
 
 /**
@@ -110,7 +176,8 @@ static inline void simple_data_ringbuffer_init(simple_data_ringbuffer_t *ringbuf
  */
 static inline int simple_data_ringbuffer_is_empty(simple_data_ringbuffer_t *ringbuf)
 {
-    return ringbuf->read_index == ringbuf->write_index;
+    return SIMPLE_RINGBUFFER_LOAD_ACQUIRE(ringbuf->read_index) ==
+           SIMPLE_RINGBUFFER_LOAD_ACQUIRE(ringbuf->write_index);
 }
 
 /**
@@ -118,11 +185,13 @@ static inline int simple_data_ringbuffer_is_empty(simple_data_ringbuffer_t *ring
  * @param  [in] ringbuf: The ringbuf to be used.
  * @return The used size of the RINGBUF in bytes.
  */
-static inline uint16_t simple_data_ringbuffer_size(simple_data_ringbuffer_t *ringbuf)
+static inline simple_data_index_t simple_data_ringbuffer_size(simple_data_ringbuffer_t *ringbuf)
 {
-    return ringbuf->write_index >= ringbuf->read_index
-                   ? ringbuf->write_index - ringbuf->read_index
-                   : (ringbuf->total_size << 1) - (ringbuf->read_index - ringbuf->write_index);
+    simple_data_index_t read_index = SIMPLE_RINGBUFFER_LOAD_ACQUIRE(ringbuf->read_index);
+    simple_data_index_t write_index = SIMPLE_RINGBUFFER_LOAD_ACQUIRE(ringbuf->write_index);
+
+    return write_index >= read_index ? write_index - read_index
+                                     : (ringbuf->total_size << 1) - (read_index - write_index);
 }
 
 /**
@@ -130,7 +199,8 @@ static inline uint16_t simple_data_ringbuffer_size(simple_data_ringbuffer_t *rin
  * @param  [in] ringbuf: The ringbuf to be used.
  * @return The free size of the RINGBUF in bytes.
  */
-static inline uint16_t simple_data_ringbuffer_reserve_size(simple_data_ringbuffer_t *ringbuf)
+static inline simple_data_index_t
+simple_data_ringbuffer_reserve_size(simple_data_ringbuffer_t *ringbuf)
 {
     return ringbuf->total_size - simple_data_ringbuffer_size(ringbuf);
 }
@@ -160,6 +230,75 @@ int simple_data_ringbuffer_put(simple_data_ringbuffer_t *ringbuf, void *buffer);
  */
 int simple_data_ringbuffer_get(simple_data_ringbuffer_t *ringbuf, void *buffer);
 
+/**
+ * @brief   Put an item into the RINGBUF, overwriting the oldest item when it is full.
+ * @details Overwrite (lossy) mode, the newest items are kept and a slow consumer falls behind:
+ *   the producer moves read_index forward itself. In SPSC mode the consumer must then use
+ *   simple_data_ringbuffer_get_overwrite(), not get/dequeue.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @param  [in] buffer: The item.
+ * @return The number of items overwritten, 0 or 1.
+ */
+int simple_data_ringbuffer_put_overwrite(simple_data_ringbuffer_t *ringbuf, void *buffer);
+
+/**
+ * @brief   Get an item from a RINGBUF fed by simple_data_ringbuffer_put_overwrite().
+ * @details When the producer overwrote the item while it was copied, the consumer was lapped:
+ *   the copy is dropped and done again from the new oldest item, so no torn item is returned.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @param  [out] buffer: The destination of the item.
+ * @return 1 if an item was get, 0 if the RINGBUF is empty.
+ */
+int simple_data_ringbuffer_get_overwrite(simple_data_ringbuffer_t *ringbuf, void *buffer);
+
+/**
+ * @brief  Returns the number of items dropped by simple_data_ringbuffer_put_overwrite() since init.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @return The number of items overwritten, wraps at 2^32.
+ */
+static inline uint32_t simple_data_ringbuffer_overwritten(simple_data_ringbuffer_t *ringbuf)
+{
+    return SIMPLE_RINGBUFFER_LOAD_ACQUIRE(ringbuf->overwritten);
+}
+
+#if SIMPLE_RINGBUFFER_STATS
+/**
+ * @brief  Take a snapshot of the counters of the RINGBUF, 'make STATS=1'.
+ * @details May be called from any thread. The counters are not updated together, a snapshot
+ *   taken while the RINGBUF is used may miss the operations in flight. high_water is in items.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @param  [out] stats: The counters since init or reset.
+ */
+static inline void
+simple_data_ringbuffer_stats_snapshot(simple_data_ringbuffer_t *ringbuf,
+                                      simple_ringbuffer_stats_t *stats)
+{
+    simple_ringbuffer_stats_load(&ringbuf->put_stats, &ringbuf->get_stats, stats);
+}
+#endif
+
+/**
+ * @brief  Put up to n items into the RINGBUF.
+ * @details At most two memcpy and one write_index update for the whole batch.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @param  [in] buffer: n items, packed by item_size.
+ * @param  [in] n: The number of items.
+ * @return The number of items put into the RINGBUF.
+ */
+simple_data_index_t simple_data_ringbuffer_put_n(simple_data_ringbuffer_t *ringbuf, void *buffer,
+                                                 simple_data_index_t n);
+
+/**
+ * @brief  Get up to n items from the RINGBUF.
+ * @details At most two memcpy and one read_index update for the whole batch.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @param  [out] buffer: Room for n items packed by item_size, NULL to drop them.
+ * @param  [in] n: The number of items.
+ * @return The number of items get from the RINGBUF.
+ */
+simple_data_index_t simple_data_ringbuffer_get_n(simple_data_ringbuffer_t *ringbuf, void *buffer,
+                                                 simple_data_index_t n);
+
 /**
  * @brief   Non-destructive: Allocate buffer from named queue
  * @details API 1.
@@ -175,7 +314,8 @@ int simple_data_ringbuffer_enqueue_get(simple_data_ringbuffer_t *ringbuf, void *
  *   The buffer should have been allocated using MRINGBUF_ENQUEUE_GET
  * @param idx[in]  Index one-ahead of previously allocated buffer
  */
-void simple_data_ringbuffer_enqueue(simple_data_ringbuffer_t *ringbuf, uint16_t write_index);
+void simple_data_ringbuffer_enqueue(simple_data_ringbuffer_t *ringbuf,
+                                    simple_data_index_t write_index);
 
 /**
  * @brief  Peek data from the RINGBUF, but not dequeue.
@@ -190,4 +330,47 @@ void *simple_data_ringbuffer_dequeue_peek(simple_data_ringbuffer_t *ringbuf);
  */
 void simple_data_ringbuffer_dequeue(simple_data_ringbuffer_t *ringbuf);
 
+/**
+ * @brief   Non-destructive: Allocate up to n slots in a row from the RINGBUF.
+ * @details API 2.
+ *   The slots are contiguous, from the write position up to the end of buffer at most, so they
+ *   can be filled as one array. They exist in limbo until committed with
+ *   simple_data_ringbuffer_enqueue_n().
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @param  [out] mem: The first slot, NULL if the RINGBUF is full.
+ * @param  [in] n: The number of slots wanted.
+ * @return The number of slots allocated.
+ */
+simple_data_index_t simple_data_ringbuffer_enqueue_get_n(simple_data_ringbuffer_t *ringbuf,
+                                                         void **mem, simple_data_index_t n);
+
+/**
+ * @brief   Commit n slots allocated by simple_data_ringbuffer_enqueue_get_n(), with one
+ *          write_index update.
+ * @details API 2.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @param  [in] n: The number of slots to commit, at most the number allocated.
+ */
+void simple_data_ringbuffer_enqueue_n(simple_data_ringbuffer_t *ringbuf, simple_data_index_t n);
+
+/**
+ * @brief  Peek up to n items in a row from the RINGBUF, but not dequeue.
+ * @details API 2.
+ *   The items are contiguous, from the read position up to the end of buffer at most.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @param  [out] mem: The first item, NULL if the RINGBUF is empty.
+ * @param  [in] n: The number of items wanted.
+ * @return The number of items peeked.
+ */
+simple_data_index_t simple_data_ringbuffer_dequeue_peek_n(simple_data_ringbuffer_t *ringbuf,
+                                                          void **mem, simple_data_index_t n);
+
+/**
+ * @brief  Dequeue n items from the RINGBUF, with one read_index update.
+ * @details API 2.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @param  [in] n: The number of items to dequeue, at most the number peeked.
+ */
+void simple_data_ringbuffer_dequeue_n(simple_data_ringbuffer_t *ringbuf, simple_data_index_t n);
+
 #endif /* _SIMPLE_DATA_RINGBUFFER_H_ */
\ No newline at end of file
@@ -0,0 +1,253 @@
+#if defined(__linux__)
+/* sync_file_range(), ftruncate() */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <errno.h>
+#include <string.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "simple_data_ringbuffer_file.h"
+
+#define DATA_RINGBUFFER_FILE_MAGIC   0x53524446u /* "SRDF" */
+#define DATA_RINGBUFFER_FILE_VERSION 1
+
+/* the fields of simple_data_ringbuffer_t depend on the build, so does the file */
+#define DATA_RINGBUFFER_FILE_LAYOUT                                                                \
+    ((uint32_t)sizeof(simple_data_ringbuffer_t) | ((uint32_t)SIMPLE_RINGBUFFER_SPSC << 16) |       \
+     ((uint32_t)SIMPLE_DATA_RINGBUFFER_WIDE << 17) | ((uint32_t)SIMPLE_RINGBUFFER_STATS << 18))
+
+/* the RINGBUF struct follows the header, on its own cache line */
+#define DATA_RINGBUFFER_FILE_RINGBUF_OFFSET                                                        \
+    ((sizeof(data_ringbuffer_file_header_t) + SIMPLE_RINGBUFFER_CACHE_LINE_SIZE - 1) /             \
+     SIMPLE_RINGBUFFER_CACHE_LINE_SIZE * SIMPLE_RINGBUFFER_CACHE_LINE_SIZE)
+
+/**
+ * @brief  First page of the file, the RINGBUF struct follows, the storage starts on the next page.
+ */
+typedef struct data_ringbuffer_file_header
+{
+    uint32_t magic; /* DATA_RINGBUFFER_FILE_MAGIC, written last at creation */
+    uint32_t version;
+    uint32_t layout; /* DATA_RINGBUFFER_FILE_LAYOUT of the build which created it */
+    uint32_t total_size;
+    uint32_t item_size;
+    uint32_t data_offset; /* Offset of the storage, a page size */
+} data_ringbuffer_file_header_t;
+
+/**
+ * @brief  Check a recovered header and RINGBUF against the parameters of the open call.
+ * @details A torn or corrupt file must not be trusted: both indices must be in
+ *   [0, 2 * total_size) and hold at most total_size items between them, else the free size
+ *   underflows and puts overwrite unread items.
+ */
+static int data_ringbuffer_file_check(data_ringbuffer_file_header_t *header,
+                                      simple_data_ringbuffer_t *ringbuf, size_t data_offset,
+                                      simple_data_index_t total_size,
+                                      simple_data_index_t item_size)
+{
+    uint32_t read_index = SIMPLE_RINGBUFFER_LOAD_RELAXED(ringbuf->read_index);
+    uint32_t write_index = SIMPLE_RINGBUFFER_LOAD_RELAXED(ringbuf->write_index);
+    uint32_t index_size = (uint32_t)total_size << 1;
+
+    if (read_index >= index_size || write_index >= index_size ||
+        (write_index >= read_index ? write_index - read_index
+                                   : index_size - (read_index - write_index)) > total_size)
+    {
+        return 0;
+    }
+
+    return header->version == DATA_RINGBUFFER_FILE_VERSION &&
+           header->layout == DATA_RINGBUFFER_FILE_LAYOUT && header->total_size == total_size &&
+           header->item_size == item_size && header->data_offset == data_offset &&
+           ringbuf->total_size == total_size && ringbuf->item_size == item_size;
+}
+
+/**
+ * @brief  Map the open file, then create or recover the RINGBUF in it.
+ */
+static int data_ringbuffer_file_map(simple_data_ringbuffer_file_t *file, int fd,
+                                    simple_data_index_t total_size,
+                                    simple_data_index_t item_size)
+{
+    size_t data_offset = (size_t)sysconf(_SC_PAGESIZE);
+    size_t map_size = data_offset + (size_t)total_size * item_size;
+    data_ringbuffer_file_header_t *header;
+    simple_data_ringbuffer_t *ringbuf;
+    struct stat st;
+
+    if (fstat(fd, &st) != 0 || (st.st_size == 0 && ftruncate(fd, (off_t)map_size) != 0))
+    {
+        return -1;
+    }
+    if (st.st_size != 0 && (size_t)st.st_size != map_size)
+    {
+        errno = EINVAL;
+        return -1;
+    }
+    file->base = mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (file->base == MAP_FAILED)
+    {
+        return -1;
+    }
+    file->map_size = map_size;
+
+    header = file->base;
+    ringbuf = (simple_data_ringbuffer_t *)((uint8_t *)file->base +
+                                           DATA_RINGBUFFER_FILE_RINGBUF_OFFSET);
+    if (header->magic == 0)
+    {
+        /* new file, or its creation did not complete: start empty */
+        header->version = DATA_RINGBUFFER_FILE_VERSION;
+        header->layout = DATA_RINGBUFFER_FILE_LAYOUT;
+        header->total_size = total_size;
+        header->item_size = item_size;
+        header->data_offset = (uint32_t)data_offset;
+        simple_data_ringbuffer_init(ringbuf, total_size, item_size,
+                                    (uint8_t *)file->base + data_offset);
+        header->magic = DATA_RINGBUFFER_FILE_MAGIC;
+    }
+    else if (header->magic != DATA_RINGBUFFER_FILE_MAGIC ||
+             !data_ringbuffer_file_check(header, ringbuf, data_offset, total_size, item_size))
+    {
+        munmap(file->base, map_size);
+        errno = EINVAL;
+        return -1;
+    }
+    else
+    {
+        /* recover: the indices are kept, the storage moved with the mapping */
+        ringbuf->buffer = (uint8_t *)file->base + data_offset;
+        ringbuf->index_mask = (simple_data_index_t)SIMPLE_RINGBUFFER_INDEX_MASK(total_size);
+#if SIMPLE_RINGBUFFER_SPSC
+        ringbuf->write_index_cache = SIMPLE_RINGBUFFER_LOAD_RELAXED(ringbuf->write_index);
+        ringbuf->read_index_cache = SIMPLE_RINGBUFFER_LOAD_RELAXED(ringbuf->read_index);
+#endif
+    }
+    file->ringbuf = ringbuf;
+
+    return 0;
+}
+
+int simple_data_ringbuffer_file_open(simple_data_ringbuffer_file_t *file, const char *path,
+                                     simple_data_index_t total_size,
+                                     simple_data_index_t item_size,
+                                     simple_data_ringbuffer_flush_t flush)
+{
+    int fd;
+
+    if (total_size == 0 || item_size == 0 ||
+        DATA_RINGBUFFER_FILE_RINGBUF_OFFSET + sizeof(simple_data_ringbuffer_t) >
+                (size_t)sysconf(_SC_PAGESIZE))
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+        return -1;
+    }
+    if (data_ringbuffer_file_map(file, fd, total_size, item_size) != 0)
+    {
+        int err = errno;
+        close(fd);
+        errno = err;
+        return -1;
+    }
+    file->fd = fd;
+    file->flush = flush;
+    file->flush_interval = 1;
+    file->unflushed = 0;
+
+    return 0;
+}
+
+int simple_data_ringbuffer_file_sync(simple_data_ringbuffer_file_t *file)
+{
+    size_t data_offset = ((data_ringbuffer_file_header_t *)file->base)->data_offset;
+
+    file->unflushed = 0;
+    if (file->flush == SIMPLE_DATA_RINGBUFFER_FLUSH_ASYNC)
+    {
+        return sync_file_range(file->fd, 0, 0, SYNC_FILE_RANGE_WRITE);
+    }
+    if (file->flush == SIMPLE_DATA_RINGBUFFER_FLUSH_SYNC)
+    {
+        /* the items first, so that the indices on disk never cover an item which is not */
+        if (msync((uint8_t *)file->base + data_offset, file->map_size - data_offset, MS_SYNC) !=
+            0)
+        {
+            return -1;
+        }
+        return msync(file->base, data_offset, MS_SYNC);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief  Count n items put, sync once flush_interval of them went in.
+ */
+static int data_ringbuffer_file_flush_after(simple_data_ringbuffer_file_t *file,
+                                            simple_data_index_t n)
+{
+    file->unflushed += n;
+    if (file->flush_interval == 0 || file->unflushed < file->flush_interval)
+    {
+        return 0;
+    }
+
+    return simple_data_ringbuffer_file_sync(file);
+}
+
+int simple_data_ringbuffer_file_put(simple_data_ringbuffer_file_t *file, void *buffer)
+{
+    if (simple_data_ringbuffer_put(file->ringbuf, buffer) == 0)
+    {
+        return 0;
+    }
+
+    return data_ringbuffer_file_flush_after(file, 1) == 0 ? 1 : -1;
+}
+
+simple_data_index_t simple_data_ringbuffer_file_put_n(simple_data_ringbuffer_file_t *file,
+                                                      void *buffer, simple_data_index_t n,
+                                                      int *err)
+{
+    int ret;
+
+    n = simple_data_ringbuffer_put_n(file->ringbuf, buffer, n);
+    ret = n ? data_ringbuffer_file_flush_after(file, n) : 0;
+    if (err != NULL)
+    {
+        *err = ret;
+    }
+
+    return n;
+}
+
+int simple_data_ringbuffer_file_enqueue_n(simple_data_ringbuffer_file_t *file,
+                                          simple_data_index_t n)
+{
+    simple_data_ringbuffer_enqueue_n(file->ringbuf, n);
+
+    return n ? data_ringbuffer_file_flush_after(file, n) : 0;
+}
+
+void simple_data_ringbuffer_file_close(simple_data_ringbuffer_file_t *file)
+{
+    simple_data_ringbuffer_file_sync(file);
+    munmap(file->base, file->map_size);
+    close(file->fd);
+    file->ringbuf = NULL;
+    file->base = NULL;
+    file->fd = -1;
+}
+#endif
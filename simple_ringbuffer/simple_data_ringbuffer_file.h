@@ -0,0 +1,121 @@
+#ifndef _SIMPLE_DATA_RINGBUFFER_FILE_H_
+#define _SIMPLE_DATA_RINGBUFFER_FILE_H_
+
+#if defined(__linux__)
+#include <stdint.h>
+#include <stddef.h>
+
+#include "simple_data_ringbuffer.h"
+
+/**
+ * @brief   What simple_data_ringbuffer_file_sync() does, throughput against durability.
+ * @details The file put calls run it by themselves every flush_interval items.
+ */
+typedef enum simple_data_ringbuffer_flush
+{
+    SIMPLE_DATA_RINGBUFFER_FLUSH_NONE = 0, /* Nothing, the kernel writes back when it wants */
+    SIMPLE_DATA_RINGBUFFER_FLUSH_ASYNC,    /* Start the write back, do not wait for it */
+    SIMPLE_DATA_RINGBUFFER_FLUSH_SYNC,     /* Items, then indices, on disk before returning */
+} simple_data_ringbuffer_flush_t;
+
+/**
+ * @brief   A simple_data_ringbuffer_t whose struct and storage live in a mmap'd file.
+ * @details
+ *   ringbuf points into the mapping and is used with the usual put/get and enqueue/dequeue
+ *   calls, so the indices are in the file as well. Only committed items are covered by
+ *   write_index, so whatever the process restarts or crashes at, the next
+ *   simple_data_ringbuffer_file_open() finds exactly the items put and not yet get.
+ *   The page cache survives a process crash, not a host crash: simple_data_ringbuffer_file_sync()
+ *   makes the state durable according to the flush policy, between two syncs the kernel may
+ *   write the pages back in any order. simple_data_ringbuffer_file_put(), _put_n() and
+ *   _enqueue_n() sync by themselves once flush_interval items went in since the last sync, the
+ *   ringbuf calls never do.
+ */
+typedef struct simple_data_ringbuffer_file
+{
+    simple_data_ringbuffer_t *ringbuf; /* In the mapping */
+    void *base;                        /* Mapping of the whole file */
+    size_t map_size;
+    int fd;
+    simple_data_ringbuffer_flush_t flush;
+    uint32_t flush_interval; /* Items put between two syncs, 0 for explicit syncs only */
+    uint32_t unflushed;      /* Items put since the last sync */
+} simple_data_ringbuffer_file_t;
+
+/**
+ * @brief  Open a file-backed RINGBUF, create it if the file is empty or does not exist.
+ * @details An existing file is recovered with its items, it must have been created with the
+ *   same total_size and item_size, and by a build with the same SIMPLE_RINGBUFFER_SPSC,
+ *   SIMPLE_DATA_RINGBUFFER_WIDE and SIMPLE_RINGBUFFER_STATS.
+ * @param  [in] file: The handle to be used.
+ * @param  [in] path: Path of the file.
+ * @param  [in] total_size: The number of items.
+ * @param  [in] item_size: The stride between items.
+ * @param  [in] flush: The policy of simple_data_ringbuffer_file_sync(), applied after every file
+ *   put, see simple_data_ringbuffer_file_set_flush_interval().
+ * @return 0 on success, -1 on failure (errno is set, EINVAL if the file does not match).
+ */
+int simple_data_ringbuffer_file_open(simple_data_ringbuffer_file_t *file, const char *path,
+                                     simple_data_index_t total_size,
+                                     simple_data_index_t item_size,
+                                     simple_data_ringbuffer_flush_t flush);
+
+/**
+ * @brief  Make the state of the RINGBUF durable, according to the flush policy.
+ * @details With SIMPLE_DATA_RINGBUFFER_FLUSH_SYNC the items are written back before the
+ *   indices, the indices on disk never cover an item which is not.
+ * @param  [in] file: The handle to be used.
+ * @return 0 on success, -1 on failure (errno is set).
+ */
+int simple_data_ringbuffer_file_sync(simple_data_ringbuffer_file_t *file);
+
+/**
+ * @brief  Set how many items the file put calls let through between two syncs.
+ * @param  [in] file: The handle to be used.
+ * @param  [in] items: 1 (the default) to sync after every put, N to sync every N items, 0 to
+ *   only sync in simple_data_ringbuffer_file_sync() and _close().
+ */
+static inline void simple_data_ringbuffer_file_set_flush_interval(
+        simple_data_ringbuffer_file_t *file, uint32_t items)
+{
+    file->flush_interval = items;
+}
+
+/**
+ * @brief  simple_data_ringbuffer_put() on the file RINGBUF, then sync per the flush policy.
+ * @param  [in] file: The handle to be used.
+ * @param  [in] buffer: The item to be put.
+ * @return 1 if the item was put, 0 if the RINGBUF is full, -1 if it was put but the sync
+ *   failed (errno is set).
+ */
+int simple_data_ringbuffer_file_put(simple_data_ringbuffer_file_t *file, void *buffer);
+
+/**
+ * @brief  simple_data_ringbuffer_put_n() on the file RINGBUF, then sync per the flush policy.
+ * @param  [in] file: The handle to be used.
+ * @param  [in] buffer: n items, packed by item_size.
+ * @param  [in] n: The number of items.
+ * @param  [out] err: 0, or -1 if the sync failed (errno is set), may be NULL.
+ * @return The number of items put.
+ */
+simple_data_index_t simple_data_ringbuffer_file_put_n(simple_data_ringbuffer_file_t *file,
+                                                      void *buffer, simple_data_index_t n,
+                                                      int *err);
+
+/**
+ * @brief  simple_data_ringbuffer_enqueue_n() on the file RINGBUF, then sync per the flush policy.
+ * @param  [in] file: The handle to be used.
+ * @param  [in] n: The number of slots to commit.
+ * @return 0 on success, -1 if the sync failed (errno is set).
+ */
+int simple_data_ringbuffer_file_enqueue_n(simple_data_ringbuffer_file_t *file,
+                                          simple_data_index_t n);
+
+/**
+ * @brief  Sync the RINGBUF according to the flush policy, then unmap and close the file.
+ * @param  [in] file: The handle to be used.
+ */
+void simple_data_ringbuffer_file_close(simple_data_ringbuffer_file_t *file);
+#endif
+
+#endif /* _SIMPLE_DATA_RINGBUFFER_FILE_H_ */
@@ -0,0 +1,174 @@
+#ifndef _SIMPLE_DATA_RINGBUFFER_TYPED_H_
+#define _SIMPLE_DATA_RINGBUFFER_TYPED_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "simple_ringbuffer_port.h"
+
+/*
+ * Index helpers of the typed RINGBUF, _num is a compile-time constant so the wrap folds to a
+ * mask for a power of 2 count and to a compare with an immediate otherwise. Indices are in
+ * [0, 2 * _num) like simple_data_ringbuffer_t.
+ */
+#define SIMPLE_TYPED_RINGBUFFER_INDEX_TO_PTR(_index, _num)                                         \
+    (SIMPLE_RINGBUFFER_INDEX_MASK(_num) ? ((_index) & ((uint32_t)(_num) - 1))                      \
+     : ((_index) >= (_num))             ? ((_index) - (_num))                                      \
+                                        : (_index))
+
+#define SIMPLE_TYPED_RINGBUFFER_USED_SIZE(_write_index, _read_index, _num)                         \
+    (SIMPLE_RINGBUFFER_INDEX_MASK(_num)                                                            \
+             ? (((_write_index) - (_read_index)) & SIMPLE_RINGBUFFER_INDEX_MASK(_num))             \
+     : ((_write_index) >= (_read_index))                                                           \
+             ? ((_write_index) - (_read_index))                                                    \
+             : (((uint32_t)(_num) << 1) - ((_read_index) - (_write_index))))
+
+#define SIMPLE_TYPED_RINGBUFFER_INDEX_NEXT(_index, _num)                                           \
+    (SIMPLE_RINGBUFFER_INDEX_MASK(_num) ? (((_index) + 1) & SIMPLE_RINGBUFFER_INDEX_MASK(_num))    \
+     : ((_index) + 1 >= ((uint32_t)(_num) << 1)) ? 0                                               \
+                                                 : ((_index) + 1))
+
+/**
+ * @brief   Declare a typed RINGBUF of _num items of _type, with its inline API.
+ * @details
+ *   Same behavior as simple_data_ringbuffer_t (API 1 and SIMPLE_RINGBUFFER_SPSC mode), but the
+ *   item size and the count are compile-time constants: an item is copied by assignment, which
+ *   the compiler turns into register moves for small structs, and the index wrap uses
+ *   immediates instead of fields loaded from the RINGBUF.
+ *   Declares the type _name##_t and the functions:
+ *     void   _name##_init(_name##_t *ringbuf);
+ *     uint32_t _name##_size(_name##_t *ringbuf);
+ *     int    _name##_is_empty(_name##_t *ringbuf);
+ *     int    _name##_is_full(_name##_t *ringbuf);
+ *     int    _name##_put(_name##_t *ringbuf, const _type *item);
+ *     int    _name##_get(_name##_t *ringbuf, _type *item); item may be NULL to drop it
+ *     _type *_name##_peek(_name##_t *ringbuf);
+ *   A static _name##_t is ready to use without _name##_init().
+ *
+ *   Example:
+ *     SIMPLE_DATA_RINGBUFFER_DECLARE_TYPED(msg_ring, struct msg, 64)
+ *     static msg_ring_t ring;
+ *     msg_ring_put(&ring, &msg);
+ */
+#define SIMPLE_DATA_RINGBUFFER_DECLARE_TYPED(_name, _type, _num)                                   \
+    _Static_assert((_num) > 0 && (_num) <= 0x7fffffff, #_name ": invalid item count");            \
+                                                                                                   \
+    typedef struct _name                                                                           \
+    {                                                                                              \
+        /* Consumer side, on its own cache line in SPSC mode */                                    \
+        SIMPLE_RINGBUFFER_CACHE_ALIGNED                                                            \
+        SIMPLE_RINGBUFFER_ATOMIC(uint32_t) read_index;                                             \
+        uint32_t write_index_cache; /* SPSC mode only */                                           \
+                                                                                                   \
+        /* Producer side, on its own cache line in SPSC mode */                                    \
+        SIMPLE_RINGBUFFER_CACHE_ALIGNED                                                            \
+        SIMPLE_RINGBUFFER_ATOMIC(uint32_t) write_index;                                            \
+        uint32_t read_index_cache; /* SPSC mode only */                                            \
+                                                                                                   \
+        SIMPLE_RINGBUFFER_CACHE_ALIGNED                                                            \
+        _type buffer[_num];                                                                        \
+    } _name##_t;                                                                                   \
+                                                                                                   \
+    static inline void _name##_init(_name##_t *ringbuf)                                            \
+    {                                                                                              \
+        SIMPLE_RINGBUFFER_STORE_RELAXED(ringbuf->write_index, 0);                                  \
+        SIMPLE_RINGBUFFER_STORE_RELAXED(ringbuf->read_index, 0);                                   \
+        ringbuf->write_index_cache = 0;                                                            \
+        ringbuf->read_index_cache = 0;                                                             \
+    }                                                                                              \
+                                                                                                   \
+    static inline uint32_t _name##_size(_name##_t *ringbuf)                                        \
+    {                                                                                              \
+        uint32_t read_index = SIMPLE_RINGBUFFER_LOAD_ACQUIRE(ringbuf->read_index);                 \
+        uint32_t write_index = SIMPLE_RINGBUFFER_LOAD_ACQUIRE(ringbuf->write_index);               \
+        return SIMPLE_TYPED_RINGBUFFER_USED_SIZE(write_index, read_index, _num);                   \
+    }                                                                                              \
+                                                                                                   \
+    static inline int _name##_is_empty(_name##_t *ringbuf)                                         \
+    {                                                                                              \
+        return _name##_size(ringbuf) == 0;                                                         \
+    }                                                                                              \
+                                                                                                   \
+    static inline int _name##_is_full(_name##_t *ringbuf)                                          \
+    {                                                                                              \
+        return _name##_size(ringbuf) == (_num);                                                    \
+    }                                                                                              \
+                                                                                                   \
+    static inline int _name##_put(_name##_t *ringbuf, const _type *item)                           \
+    {                                                                                              \
+        uint32_t write_index = SIMPLE_RINGBUFFER_LOAD_RELAXED(ringbuf->write_index);               \
+        uint32_t read_index = SIMPLE_RINGBUFFER_SPSC                                               \
+                                      ? ringbuf->read_index_cache                                  \
+                                      : SIMPLE_RINGBUFFER_LOAD_ACQUIRE(ringbuf->read_index);       \
+                                                                                                   \
+        if (SIMPLE_TYPED_RINGBUFFER_USED_SIZE(write_index, read_index, _num) == (_num))            \
+        {                                                                                          \
+            if (!SIMPLE_RINGBUFFER_SPSC)                                                           \
+            {                                                                                      \
+                return 0;                                                                          \
+            }                                                                                      \
+            /* the copy of read_index is stale, load the consumer cache line again */              \
+            read_index = SIMPLE_RINGBUFFER_LOAD_ACQUIRE(ringbuf->read_index);                      \
+            ringbuf->read_index_cache = read_index;                                                \
+            if (SIMPLE_TYPED_RINGBUFFER_USED_SIZE(write_index, read_index, _num) == (_num))        \
+            {                                                                                      \
+                return 0;                                                                          \
+            }                                                                                      \
+        }                                                                                          \
+                                                                                                   \
+        ringbuf->buffer[SIMPLE_TYPED_RINGBUFFER_INDEX_TO_PTR(write_index, _num)] = *item;          \
+        /* publish the item to the consumer */                                                     \
+        SIMPLE_RINGBUFFER_STORE_RELEASE(ringbuf->write_index,                                      \
+                                        SIMPLE_TYPED_RINGBUFFER_INDEX_NEXT(write_index, _num));    \
+                                                                                                   \
+        return 1;                                                                                  \
+    }                                                                                              \
+                                                                                                   \
+    static inline _type *_name##_peek(_name##_t *ringbuf)                                          \
+    {                                                                                              \
+        uint32_t read_index = SIMPLE_RINGBUFFER_LOAD_RELAXED(ringbuf->read_index);                 \
+        uint32_t write_index = SIMPLE_RINGBUFFER_SPSC                                              \
+                                       ? ringbuf->write_index_cache                                \
+                                       : SIMPLE_RINGBUFFER_LOAD_ACQUIRE(ringbuf->write_index);     \
+                                                                                                   \
+        if (read_index == write_index)                                                             \
+        {                                                                                          \
+            if (!SIMPLE_RINGBUFFER_SPSC)                                                           \
+            {                                                                                      \
+                return NULL;                                                                       \
+            }                                                                                      \
+            /* the copy of write_index is stale, load the producer cache line again */             \
+            write_index = SIMPLE_RINGBUFFER_LOAD_ACQUIRE(ringbuf->write_index);                    \
+            ringbuf->write_index_cache = write_index;                                              \
+            if (read_index == write_index)                                                         \
+            {                                                                                      \
+                return NULL;                                                                       \
+            }                                                                                      \
+        }                                                                                          \
+                                                                                                   \
+        return &ringbuf->buffer[SIMPLE_TYPED_RINGBUFFER_INDEX_TO_PTR(read_index, _num)];           \
+    }                                                                                              \
+                                                                                                   \
+    static inline int _name##_get(_name##_t *ringbuf, _type *item)                                 \
+    {                                                                                              \
+        uint32_t read_index;                                                                       \
+        _type *head = _name##_peek(ringbuf);                                                       \
+                                                                                                   \
+        if (head == NULL)                                                                          \
+        {                                                                                          \
+            return 0;                                                                              \
+        }                                                                                          \
+        if (item != NULL)                                                                          \
+        {                                                                                          \
+            *item = *head;                                                                         \
+        }                                                                                          \
+                                                                                                   \
+        read_index = SIMPLE_RINGBUFFER_LOAD_RELAXED(ringbuf->read_index);                          \
+        /* release the slot to the producer */                                                     \
+        SIMPLE_RINGBUFFER_STORE_RELEASE(ringbuf->read_index,                                       \
+                                        SIMPLE_TYPED_RINGBUFFER_INDEX_NEXT(read_index, _num));     \
+                                                                                                   \
+        return 1;                                                                                  \
+    }
+
+#endif /* _SIMPLE_DATA_RINGBUFFER_TYPED_H_ */
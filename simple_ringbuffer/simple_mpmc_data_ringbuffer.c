@@ -0,0 +1,395 @@
+#include <string.h>
+
+#include "simple_mpmc_data_ringbuffer.h"
+
+#define MPMC_POS_INDEX(_pos) ((_pos) & 0xFFFF)
+
+/* Set in a sequence stamp when the slot holds the item of that position */
+#define MPMC_SLOT_FULL 0x80000000U
+
+#define MPMC_INDEX_TO_PTR(_index, _total_size)                                                     \
+    ((_index >= _total_size) ? (_index - _total_size) : (_index))
+
+/**
+ * @brief  Move a position n steps forward, n <= total_size.
+ * @details The index wraps in [0, 2 * total_size), and the lap counter is bumped on every wrap.
+ */
+static inline uint32_t mpmc_pos_add(uint32_t pos, uint32_t n, uint16_t total_size)
+{
+    uint32_t index = MPMC_POS_INDEX(pos) + n;
+    uint32_t lap = pos >> 16;
+
+    if (index >= ((uint32_t)total_size << 1))
+    {
+        index -= ((uint32_t)total_size << 1);
+        lap++;
+    }
+
+    return ((lap & 0x7FFF) << 16) | index;
+}
+
+static inline _Atomic uint32_t *mpmc_slot(simple_mpmc_data_ringbuffer_t *ringbuf, uint32_t pos)
+{
+    uint32_t ptr = MPMC_INDEX_TO_PTR(MPMC_POS_INDEX(pos), ringbuf->total_size);
+
+    return (_Atomic uint32_t *)(ringbuf->buffer + ptr * ringbuf->slot_size);
+}
+
+/**
+ * @brief  Count n items claimed from pos, nothing without SIMPLE_RINGBUFFER_STATS.
+ * @details Called before the slots are published, so no reader is past pos yet.
+ */
+static inline void mpmc_stats_put(simple_mpmc_data_ringbuffer_t *ringbuf, uint32_t pos,
+                                  uint32_t n)
+{
+#if SIMPLE_RINGBUFFER_STATS
+    uint32_t total_size = ringbuf->total_size;
+    uint32_t write_index = MPMC_POS_INDEX(mpmc_pos_add(pos, n, total_size));
+    uint32_t read_index =
+            MPMC_POS_INDEX(atomic_load_explicit(&ringbuf->read_pos, memory_order_relaxed));
+    uint32_t high_water = atomic_load_explicit(&ringbuf->high_water, memory_order_relaxed);
+    uint32_t used = write_index >= read_index ? write_index - read_index
+                                              : (total_size << 1) - (read_index - write_index);
+
+    atomic_fetch_add_explicit(&ringbuf->put_items, n, memory_order_relaxed);
+    if (MPMC_INDEX_TO_PTR(MPMC_POS_INDEX(pos), total_size) + n >= total_size)
+    {
+        atomic_fetch_add_explicit(&ringbuf->wraps, 1, memory_order_relaxed);
+    }
+
+    /* read_pos may be stale, a larger size is not possible */
+    used = used > total_size ? total_size : used;
+    while (used > high_water &&
+           !atomic_compare_exchange_weak_explicit(&ringbuf->high_water, &high_water, used,
+                                                  memory_order_relaxed, memory_order_relaxed))
+    {
+    }
+#endif
+}
+
+/**
+ * @brief  Count a put which found no room for all of its items.
+ */
+static inline void mpmc_stats_full(simple_mpmc_data_ringbuffer_t *ringbuf)
+{
+#if SIMPLE_RINGBUFFER_STATS
+    atomic_fetch_add_explicit(&ringbuf->put_full, 1, memory_order_relaxed);
+#endif
+}
+
+/**
+ * @brief  Count n items get, a get of none found the RINGBUF empty.
+ */
+static inline void mpmc_stats_get(simple_mpmc_data_ringbuffer_t *ringbuf, uint32_t n)
+{
+#if SIMPLE_RINGBUFFER_STATS
+    if (n == 0)
+    {
+        atomic_fetch_add_explicit(&ringbuf->get_empty, 1, memory_order_relaxed);
+        return;
+    }
+    atomic_fetch_add_explicit(&ringbuf->get_items, n, memory_order_relaxed);
+#endif
+}
+
+void simple_mpmc_data_ringbuffer_init(simple_mpmc_data_ringbuffer_t *ringbuf, uint16_t total_size,
+                                      uint16_t item_size, void *buffer)
+{
+    ringbuf->total_size = total_size;
+    ringbuf->item_size = item_size;
+    ringbuf->slot_size = SIMPLE_MPMC_DATA_RINGBUFFER_SLOT_SIZE(item_size);
+    ringbuf->buffer = buffer;
+
+    /* slot i is free for the writer at position i */
+    for (uint32_t i = 0; i < total_size; i++)
+    {
+        atomic_init(mpmc_slot(ringbuf, i), i);
+    }
+
+    atomic_init(&ringbuf->read_pos, 0);
+    atomic_init(&ringbuf->write_pos, 0);
+#if SIMPLE_RINGBUFFER_STATS
+    simple_mpmc_data_ringbuffer_stats_reset(ringbuf);
+#endif
+    atomic_thread_fence(memory_order_release);
+}
+
+/**
+ * @brief  Claim the next free slot for a writer.
+ * @param  [out] pos: Position of the claimed slot.
+ * @return The sequence stamp of the slot, NULL if the RINGBUF is full.
+ */
+static _Atomic uint32_t *mpmc_claim_write(simple_mpmc_data_ringbuffer_t *ringbuf, uint32_t *pos)
+{
+    uint32_t now;
+    _Atomic uint32_t *slot;
+
+    *pos = atomic_load_explicit(&ringbuf->write_pos, memory_order_relaxed);
+    for (;;)
+    {
+        slot = mpmc_slot(ringbuf, *pos);
+
+        if (atomic_load_explicit(slot, memory_order_acquire) == *pos)
+        {
+            /* slot is free for this position, try to claim it */
+            if (atomic_compare_exchange_weak_explicit(
+                        &ringbuf->write_pos, pos, mpmc_pos_add(*pos, 1, ringbuf->total_size),
+                        memory_order_relaxed, memory_order_relaxed))
+            {
+                return slot;
+            }
+        }
+        else
+        {
+            now = atomic_load_explicit(&ringbuf->write_pos, memory_order_relaxed);
+            if (now == *pos)
+            {
+                /* the reader of the previous lap did not free the slot yet */
+                return NULL;
+            }
+            *pos = now;
+        }
+    }
+}
+
+int simple_mpmc_data_ringbuffer_put(simple_mpmc_data_ringbuffer_t *ringbuf, const void *buffer)
+{
+    uint32_t pos;
+    _Atomic uint32_t *slot = mpmc_claim_write(ringbuf, &pos);
+
+    if (slot == NULL)
+    {
+        mpmc_stats_full(ringbuf);
+        return 0;
+    }
+
+    memcpy((uint8_t *)(slot + 1), buffer, ringbuf->item_size);
+    mpmc_stats_put(ringbuf, pos, 1);
+
+    /* publish the item to the reader at this position */
+    atomic_store_explicit(slot, pos | MPMC_SLOT_FULL, memory_order_release);
+
+    return 1;
+}
+
+int simple_mpmc_data_ringbuffer_get(simple_mpmc_data_ringbuffer_t *ringbuf, void *buffer)
+{
+    uint32_t pos = atomic_load_explicit(&ringbuf->read_pos, memory_order_relaxed);
+    _Atomic uint32_t *slot;
+
+    for (;;)
+    {
+        slot = mpmc_slot(ringbuf, pos);
+
+        if (atomic_load_explicit(slot, memory_order_acquire) == (pos | MPMC_SLOT_FULL))
+        {
+            /* slot holds the item of this position, try to claim it */
+            if (atomic_compare_exchange_weak_explicit(
+                        &ringbuf->read_pos, &pos, mpmc_pos_add(pos, 1, ringbuf->total_size),
+                        memory_order_relaxed, memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else
+        {
+            uint32_t now = atomic_load_explicit(&ringbuf->read_pos, memory_order_relaxed);
+            if (now == pos)
+            {
+                /* the writer of this position did not publish yet */
+                mpmc_stats_get(ringbuf, 0);
+                return 0;
+            }
+            pos = now;
+        }
+    }
+
+    if (buffer != NULL)
+    {
+        memcpy(buffer, (uint8_t *)(slot + 1), ringbuf->item_size);
+    }
+
+    /* free the slot for the writer of the next lap */
+    atomic_store_explicit(slot, mpmc_pos_add(pos, ringbuf->total_size, ringbuf->total_size),
+                          memory_order_release);
+    mpmc_stats_get(ringbuf, 1);
+
+    return 1;
+}
+
+uint32_t simple_mpmc_data_ringbuffer_put_n(simple_mpmc_data_ringbuffer_t *ringbuf,
+                                           const void *buffer, uint32_t n)
+{
+    uint32_t pos = atomic_load_explicit(&ringbuf->write_pos, memory_order_relaxed);
+    uint32_t want = n;
+    uint32_t cnt;
+
+    n = n < ringbuf->total_size ? n : ringbuf->total_size;
+    if (n == 0)
+    {
+        return 0;
+    }
+
+    for (;;)
+    {
+        /* count the free slots in a row from pos, they can only be taken by a CAS on pos */
+        for (cnt = 0; cnt < n; cnt++)
+        {
+            uint32_t slot_pos = mpmc_pos_add(pos, cnt, ringbuf->total_size);
+            if (atomic_load_explicit(mpmc_slot(ringbuf, slot_pos), memory_order_acquire) !=
+                slot_pos)
+            {
+                break;
+            }
+        }
+
+        if (cnt > 0)
+        {
+            if (atomic_compare_exchange_weak_explicit(
+                        &ringbuf->write_pos, &pos, mpmc_pos_add(pos, cnt, ringbuf->total_size),
+                        memory_order_relaxed, memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else
+        {
+            uint32_t now = atomic_load_explicit(&ringbuf->write_pos, memory_order_relaxed);
+            if (now == pos)
+            {
+                mpmc_stats_full(ringbuf);
+                return 0;
+            }
+            pos = now;
+        }
+    }
+
+    if (cnt < want)
+    {
+        mpmc_stats_full(ringbuf);
+    }
+    mpmc_stats_put(ringbuf, pos, cnt);
+
+    for (uint32_t i = 0; i < cnt; i++)
+    {
+        uint32_t slot_pos = mpmc_pos_add(pos, i, ringbuf->total_size);
+        _Atomic uint32_t *slot = mpmc_slot(ringbuf, slot_pos);
+
+        memcpy((uint8_t *)(slot + 1), (const uint8_t *)buffer + i * ringbuf->item_size,
+               ringbuf->item_size);
+        atomic_store_explicit(slot, slot_pos | MPMC_SLOT_FULL, memory_order_release);
+    }
+
+    return cnt;
+}
+
+uint32_t simple_mpmc_data_ringbuffer_get_n(simple_mpmc_data_ringbuffer_t *ringbuf, void *buffer,
+                                           uint32_t n)
+{
+    uint32_t pos = atomic_load_explicit(&ringbuf->read_pos, memory_order_relaxed);
+    uint32_t cnt;
+
+    n = n < ringbuf->total_size ? n : ringbuf->total_size;
+    if (n == 0)
+    {
+        return 0;
+    }
+
+    for (;;)
+    {
+        /* count the published slots in a row from pos */
+        for (cnt = 0; cnt < n; cnt++)
+        {
+            uint32_t slot_pos = mpmc_pos_add(pos, cnt, ringbuf->total_size);
+            if (atomic_load_explicit(mpmc_slot(ringbuf, slot_pos), memory_order_acquire) !=
+                (slot_pos | MPMC_SLOT_FULL))
+            {
+                break;
+            }
+        }
+
+        if (cnt > 0)
+        {
+            if (atomic_compare_exchange_weak_explicit(
+                        &ringbuf->read_pos, &pos, mpmc_pos_add(pos, cnt, ringbuf->total_size),
+                        memory_order_relaxed, memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else
+        {
+            uint32_t now = atomic_load_explicit(&ringbuf->read_pos, memory_order_relaxed);
+            if (now == pos)
+            {
+                mpmc_stats_get(ringbuf, 0);
+                return 0;
+            }
+            pos = now;
+        }
+    }
+
+    for (uint32_t i = 0; i < cnt; i++)
+    {
+        uint32_t slot_pos = mpmc_pos_add(pos, i, ringbuf->total_size);
+        _Atomic uint32_t *slot = mpmc_slot(ringbuf, slot_pos);
+
+        if (buffer != NULL)
+        {
+            memcpy((uint8_t *)buffer + i * ringbuf->item_size, (uint8_t *)(slot + 1),
+                   ringbuf->item_size);
+        }
+        atomic_store_explicit(slot,
+                              mpmc_pos_add(slot_pos, ringbuf->total_size, ringbuf->total_size),
+                              memory_order_release);
+    }
+    mpmc_stats_get(ringbuf, cnt);
+
+    return cnt;
+}
+
+uint32_t simple_mpmc_data_ringbuffer_enqueue_get(simple_mpmc_data_ringbuffer_t *ringbuf,
+                                                 void **mem)
+{
+    uint32_t pos;
+    _Atomic uint32_t *slot = mpmc_claim_write(ringbuf, &pos);
+
+    if (slot == NULL)
+    {
+        *mem = NULL; /* Signal the failure */
+        mpmc_stats_full(ringbuf);
+        return 0;
+    }
+
+    /* The slot stays invisible to readers until its stamp is published */
+    *mem = (uint8_t *)(slot + 1);
+
+    return pos | MPMC_SLOT_FULL;
+}
+
+void simple_mpmc_data_ringbuffer_enqueue(simple_mpmc_data_ringbuffer_t *ringbuf, uint32_t commit)
+{
+    mpmc_stats_put(ringbuf, commit & ~MPMC_SLOT_FULL, 1);
+
+    /* Commit: publish the stamp, the reader stops at the first slot not committed */
+    atomic_store_explicit(mpmc_slot(ringbuf, commit), commit, memory_order_release);
+}
+
+void *simple_mpmc_data_ringbuffer_dequeue_peek(simple_mpmc_data_ringbuffer_t *ringbuf)
+{
+    uint32_t pos = atomic_load_explicit(&ringbuf->read_pos, memory_order_relaxed);
+    _Atomic uint32_t *slot = mpmc_slot(ringbuf, pos);
+
+    if (atomic_load_explicit(slot, memory_order_acquire) != (pos | MPMC_SLOT_FULL))
+    {
+        mpmc_stats_get(ringbuf, 0);
+        return NULL;
+    }
+
+    return (uint8_t *)(slot + 1);
+}
+
+void simple_mpmc_data_ringbuffer_dequeue(simple_mpmc_data_ringbuffer_t *ringbuf)
+{
+    simple_mpmc_data_ringbuffer_get(ringbuf, NULL);
+}
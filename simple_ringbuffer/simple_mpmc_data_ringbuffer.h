@@ -0,0 +1,267 @@
+#ifndef _SIMPLE_MPMC_DATA_RINGBUFFER_H_
+#define _SIMPLE_MPMC_DATA_RINGBUFFER_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <stdatomic.h>
+
+#include "simple_data_ringbuffer.h"
+
+/**
+ * @brief   Define a bounded multi-producer/multi-consumer RINGBUF of fixed size items.
+ * @details
+ *   Same idea as simple_data_ringbuffer_t, any number of items (no power of 2 limit) and
+ *   read/write index in [0, 2n), but any thread can put and any thread can get.
+ *   - Every slot starts with a sequence stamp, which tells if the slot is free for the writer
+ *     at a position, or holds data for the reader at a position.
+ *   - A writer claims a slot by CAS on write_pos, copies the data, then publishes the stamp.
+ *     A reader claims a slot by CAS on read_pos, copies the data, then frees the stamp.
+ *   - write_pos/read_pos keep the mirror index in the low 16 bits, and a 15-bit lap counter
+ *     above it, so a thread stalled between load and CAS can not be fooled by a RINGBUF that
+ *     went round and came back to the same index (ABA). The top bit of a stamp marks a slot
+ *     holding data, so even a single slot RINGBUF can tell free from full.
+ *   No lock, and write_pos/read_pos live on separate cache lines.
+ *   total_size must be in [1, 32768].
+ *
+ *   API 2 (enqueue_get/enqueue, dequeue_peek/dequeue) is the zero copy path, multi-producer and
+ *   single consumer: every producer reserves its own slot, fills it in place and commits it, in
+ *   any order. The consumer only sees the prefix of committed slots, a slot reserved but not
+ *   committed yet holds back the slots after it.
+ *
+ *   With SIMPLE_RINGBUFFER_STATS the counters sit next to write_pos/read_pos. Every thread of a
+ *   side updates them, so they are bumped with a relaxed atomic add on the line the claim CAS
+ *   already owns, and a put reads read_pos once more for high_water.
+ */
+typedef struct simple_mpmc_data_ringbuffer
+{
+    uint16_t total_size; /* Number of buffers */
+    uint16_t item_size;  /* Size of elements */
+    uint16_t slot_size;  /* Stride between elements, sequence stamp + item */
+    uint8_t *buffer;
+
+    /* Consumer side */
+    _Alignas(SIMPLE_RINGBUFFER_CACHE_LINE_SIZE) _Atomic uint32_t read_pos; /* lap | read index */
+#if SIMPLE_RINGBUFFER_STATS
+    _Atomic uint64_t get_items; /* Items get or dequeued */
+    _Atomic uint64_t get_empty; /* Gets which found no item */
+#endif
+
+    /* Producer side */
+    _Alignas(SIMPLE_RINGBUFFER_CACHE_LINE_SIZE) _Atomic uint32_t write_pos; /* lap | write index */
+#if SIMPLE_RINGBUFFER_STATS
+    _Atomic uint64_t put_items;  /* Items put or committed */
+    _Atomic uint64_t put_full;   /* Puts which did not find room for every item */
+    _Atomic uint64_t wraps;      /* Claims which went past the end of the storage */
+    _Atomic uint32_t high_water; /* Highest size seen by a producer */
+#endif
+} simple_mpmc_data_ringbuffer_t;
+
+/**
+ * @brief Stride of one slot, a 32-bit sequence stamp followed by the item.
+ */
+#define SIMPLE_MPMC_DATA_RINGBUFFER_SLOT_SIZE(_data_size) (sizeof(uint32_t) + MROUND(_data_size))
+
+#define SIMPLE_MPMC_DATA_RINGBUFFER_DEFINE(_name, _num, _data_size)                                \
+    static uint32_t                                                                                \
+            _name##_data_storage[_num][SIMPLE_MPMC_DATA_RINGBUFFER_SLOT_SIZE(_data_size) / 4];     \
+    static simple_mpmc_data_ringbuffer_t _name
+
+#define SIMPLE_MPMC_DATA_RINGBUFFER_INIT(_name, _num, _data_size)                                  \
+    simple_mpmc_data_ringbuffer_init(&_name, _num, _data_size, (void *)_name##_data_storage)
+
+/**
+ * @brief  Returns the size of the RINGBUF in bytes.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @return The size of the RINGBUF.
+ */
+static inline uint32_t
+simple_mpmc_data_ringbuffer_total_size(simple_mpmc_data_ringbuffer_t *ringbuf)
+{
+    return ringbuf->total_size;
+}
+
+/**
+ * @brief  Returns the item size of the RINGBUF in bytes.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @return The item size of the RINGBUF.
+ */
+static inline uint32_t simple_mpmc_data_ringbuffer_item_size(simple_mpmc_data_ringbuffer_t *ringbuf)
+{
+    return ringbuf->item_size;
+}
+
+/**
+ * @brief  Returns the used size of the RINGBUF.
+ * @details Only a snapshot when other threads are working on the RINGBUF.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @return The used size of the RINGBUF.
+ */
+static inline uint16_t simple_mpmc_data_ringbuffer_size(simple_mpmc_data_ringbuffer_t *ringbuf)
+{
+    uint16_t read_index =
+            atomic_load_explicit(&ringbuf->read_pos, memory_order_acquire) & 0xFFFF;
+    uint16_t write_index =
+            atomic_load_explicit(&ringbuf->write_pos, memory_order_acquire) & 0xFFFF;
+    uint16_t size = write_index >= read_index
+                            ? write_index - read_index
+                            : (ringbuf->total_size << 1) - (read_index - write_index);
+
+    /* read_pos may move on between the two loads */
+    return size > ringbuf->total_size ? ringbuf->total_size : size;
+}
+
+/**
+ * @brief  Returns the free size of the RINGBUF.
+ * @details Only a snapshot when other threads are working on the RINGBUF.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @return The free size of the RINGBUF.
+ */
+static inline uint16_t
+simple_mpmc_data_ringbuffer_reserve_size(simple_mpmc_data_ringbuffer_t *ringbuf)
+{
+    return ringbuf->total_size - simple_mpmc_data_ringbuffer_size(ringbuf);
+}
+
+/**
+ * @brief  Check if the RINGBUF is empty.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @return 1 if the RINGBUF is empty, 0 otherwise.
+ */
+static inline int simple_mpmc_data_ringbuffer_is_empty(simple_mpmc_data_ringbuffer_t *ringbuf)
+{
+    return simple_mpmc_data_ringbuffer_size(ringbuf) == 0;
+}
+
+/**
+ * @brief  Check if the RINGBUF is full.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ */
+static inline int simple_mpmc_data_ringbuffer_is_full(simple_mpmc_data_ringbuffer_t *ringbuf)
+{
+    return simple_mpmc_data_ringbuffer_size(ringbuf) == ringbuf->total_size;
+}
+
+/**
+ * @brief  Initialize the RINGBUF, must not race with any put/get.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @param  [in] total_size: The total size of the RINGBUF, at most 32768.
+ * @param  [in] item_size: The size of one item.
+ * @param  [in] buffer: total_size * SIMPLE_MPMC_DATA_RINGBUFFER_SLOT_SIZE(item_size) bytes,
+ *                      4 bytes aligned.
+ */
+void simple_mpmc_data_ringbuffer_init(simple_mpmc_data_ringbuffer_t *ringbuf, uint16_t total_size,
+                                      uint16_t item_size, void *buffer);
+
+/**
+ * @brief  Put data into the RINGBUF, safe from any number of threads.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @param  [in] buffer: The buffer to be put into the RINGBUF.
+ * @return 1 if put, 0 if the RINGBUF is full.
+ */
+int simple_mpmc_data_ringbuffer_put(simple_mpmc_data_ringbuffer_t *ringbuf, const void *buffer);
+
+/**
+ * @brief  Get data from the RINGBUF, safe from any number of threads.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @param  [out] buffer: The buffer to get the item, NULL to drop it.
+ * @return 1 if get, 0 if the RINGBUF is empty.
+ */
+int simple_mpmc_data_ringbuffer_get(simple_mpmc_data_ringbuffer_t *ringbuf, void *buffer);
+
+/**
+ * @brief  Put up to n items into the RINGBUF with a single claim, safe from any number of threads.
+ * @details The items are put in a row, no item of another writer in between.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @param  [in] buffer: n items, packed by item_size.
+ * @param  [in] n: The number of items.
+ * @return The number of items put, 0 if the RINGBUF is full.
+ */
+uint32_t simple_mpmc_data_ringbuffer_put_n(simple_mpmc_data_ringbuffer_t *ringbuf,
+                                           const void *buffer, uint32_t n);
+
+/**
+ * @brief  Get up to n items from the RINGBUF with a single claim, safe from any number of threads.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @param  [out] buffer: Room for n items packed by item_size, NULL to drop them.
+ * @param  [in] n: The number of items.
+ * @return The number of items get, 0 if the RINGBUF is empty.
+ */
+uint32_t simple_mpmc_data_ringbuffer_get_n(simple_mpmc_data_ringbuffer_t *ringbuf, void *buffer,
+                                           uint32_t n);
+
+/**
+ * @brief   Non-destructive: Allocate buffer from the RINGBUF, safe from any number of threads.
+ * @details API 2.
+ *   The allocated buffer exists in limbo until committed.
+ *   To commit the enqueue process, simple_mpmc_data_ringbuffer_enqueue() must be called
+ *   afterwards, commits of different producers may come in any order.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @param  [out] mem: The allocated buffer, NULL if the RINGBUF is full.
+ * @return Commit token of the buffer, 0 if the RINGBUF is full.
+ */
+uint32_t simple_mpmc_data_ringbuffer_enqueue_get(simple_mpmc_data_ringbuffer_t *ringbuf,
+                                                 void **mem);
+
+/**
+ * @brief   Atomically commit a previously allocated buffer.
+ * @details API 2.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @param  [in] commit: Token returned by simple_mpmc_data_ringbuffer_enqueue_get().
+ */
+void simple_mpmc_data_ringbuffer_enqueue(simple_mpmc_data_ringbuffer_t *ringbuf, uint32_t commit);
+
+/**
+ * @brief  Peek data from the RINGBUF, but not dequeue.
+ * @details API 2, single consumer only, do not mix with simple_mpmc_data_ringbuffer_get() from
+ *   other threads.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @return The oldest committed item, NULL if the RINGBUF is empty or the oldest slot is not
+ *         committed yet.
+ */
+void *simple_mpmc_data_ringbuffer_dequeue_peek(simple_mpmc_data_ringbuffer_t *ringbuf);
+
+/**
+ * @brief  Dequeue data from the RINGBUF.
+ * @details API 2, single consumer only.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ */
+void simple_mpmc_data_ringbuffer_dequeue(simple_mpmc_data_ringbuffer_t *ringbuf);
+
+#if SIMPLE_RINGBUFFER_STATS
+/**
+ * @brief  Zero the counters of the RINGBUF, 'make STATS=1', must not race with any put/get.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ */
+static inline void simple_mpmc_data_ringbuffer_stats_reset(simple_mpmc_data_ringbuffer_t *ringbuf)
+{
+    atomic_store_explicit(&ringbuf->put_items, 0, memory_order_relaxed);
+    atomic_store_explicit(&ringbuf->put_full, 0, memory_order_relaxed);
+    atomic_store_explicit(&ringbuf->wraps, 0, memory_order_relaxed);
+    atomic_store_explicit(&ringbuf->high_water, 0, memory_order_relaxed);
+    atomic_store_explicit(&ringbuf->get_items, 0, memory_order_relaxed);
+    atomic_store_explicit(&ringbuf->get_empty, 0, memory_order_relaxed);
+}
+
+/**
+ * @brief  Take a snapshot of the counters of the RINGBUF, 'make STATS=1'.
+ * @details May be called from any thread, each counter is read on its own.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @param  [out] stats: The counters since init or reset.
+ */
+static inline void
+simple_mpmc_data_ringbuffer_stats_snapshot(simple_mpmc_data_ringbuffer_t *ringbuf,
+                                           simple_ringbuffer_stats_t *stats)
+{
+    stats->put_items = atomic_load_explicit(&ringbuf->put_items, memory_order_relaxed);
+    stats->put_bytes = stats->put_items * ringbuf->item_size;
+    stats->put_full = atomic_load_explicit(&ringbuf->put_full, memory_order_relaxed);
+    stats->wraps = atomic_load_explicit(&ringbuf->wraps, memory_order_relaxed);
+    stats->high_water = atomic_load_explicit(&ringbuf->high_water, memory_order_relaxed);
+    stats->get_items = atomic_load_explicit(&ringbuf->get_items, memory_order_relaxed);
+    stats->get_bytes = stats->get_items * ringbuf->item_size;
+    stats->get_empty = atomic_load_explicit(&ringbuf->get_empty, memory_order_relaxed);
+}
+#endif
+
+#endif /* _SIMPLE_MPMC_DATA_RINGBUFFER_H_ */
@@ -0,0 +1,205 @@
+#ifndef _SIMPLE_MPMC_POOL_H_
+#define _SIMPLE_MPMC_POOL_H_
+
+#include <string.h>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+#include "simple_mpmc_data_ringbuffer.h"
+
+/**
+ * @brief   Number of free blocks one per-thread cache (magazine) can hold.
+ * @details Blocks move between a cache and the shared RINGBUF half a magazine at a time.
+ */
+#ifndef SIMPLE_MPMC_POOL_CACHE_SIZE
+#define SIMPLE_MPMC_POOL_CACHE_SIZE 32
+#endif
+
+/**
+ * @brief   Tries with a CPU relax before a flush gives up the CPU to wait for a busy slot.
+ * @details Only on Linux, elsewhere a flush keeps spinning with a CPU relax.
+ */
+#ifndef SIMPLE_MPMC_POOL_SPIN_CNT
+#define SIMPLE_MPMC_POOL_SPIN_CNT 64
+#endif
+
+/**
+ * @brief   Define a thread safe pool, free blocks are kept in a MPMC RINGBUF of pointers.
+ * @details
+ *   Every thread allocates and frees through its own simple_mpmc_pool_cache_t. The common
+ *   alloc/free path only touches that cache, the shared RINGBUF is only used when the cache is
+ *   empty (refill) or full (flush), and then moves SIMPLE_MPMC_POOL_CACHE_SIZE / 2 blocks with
+ *   a single claim.
+ *   A block may be freed by another thread than the one which allocated it.
+ */
+typedef struct simple_mpmc_pool
+{
+    simple_mpmc_data_ringbuffer_t ringbuf;
+    uint16_t item_size;
+} simple_mpmc_pool_t;
+
+/**
+ * @brief   Per-thread cache of a simple_mpmc_pool_t, must only be used by its owner thread.
+ */
+typedef struct simple_mpmc_pool_cache
+{
+    simple_mpmc_pool_t *spool;
+    uint16_t count;
+    void *items[SIMPLE_MPMC_POOL_CACHE_SIZE];
+} simple_mpmc_pool_cache_t;
+
+#define SIMPLE_MPMC_POOL_SIZE(_spool) simple_mpmc_data_ringbuffer_size(&(_spool)->ringbuf)
+
+#define SIMPLE_MPMC_POOL_TOTAL_CNT(_spool)                                                         \
+    simple_mpmc_data_ringbuffer_total_size(&(_spool)->ringbuf)
+
+#define SIMPLE_MPMC_POOL_ITEM_SIZE(_spool) (_spool)->item_size
+
+#define SIMPLE_MPMC_POOL_DEFINE(_name, _num, _data_size)                                           \
+    static simple_mpmc_pool_t _name;                                                               \
+    static uint32_t _name##_fifo_storage[_num]                                                     \
+                                        [SIMPLE_MPMC_DATA_RINGBUFFER_SLOT_SIZE(sizeof(void *)) /   \
+                                         4];                                                       \
+    static uint8_t _name##_data_storage[_num][MROUND(_data_size)];
+
+#define SIMPLE_MPMC_POOL_INIT(_name, _num, _data_size)                                             \
+    simple_mpmc_pool_init(&_name, _name##_fifo_storage, (uint8_t *)_name##_data_storage, _num,     \
+                          _data_size)
+
+static inline void simple_mpmc_pool_init(simple_mpmc_pool_t *spool, void *fifo_storage,
+                                         uint8_t *data_storage, uint16_t n,
+                                         uint16_t data_item_size)
+{
+    spool->item_size = data_item_size;
+
+    simple_mpmc_data_ringbuffer_init(&spool->ringbuf, n, sizeof(void *), fifo_storage);
+    for (int i = 0; i < n; i++)
+    {
+        void *data_item = (void *)(data_storage + MROUND(data_item_size) * i);
+        simple_mpmc_data_ringbuffer_put(&spool->ringbuf, &data_item);
+    }
+#if SIMPLE_RINGBUFFER_STATS
+    /* the blocks put above are the initial state, not traffic */
+    simple_mpmc_data_ringbuffer_stats_reset(&spool->ringbuf);
+#endif
+}
+
+/**
+ * @brief  Initialize the cache of the calling thread.
+ * @param  [in] cache: The cache to be used.
+ * @param  [in] spool: The pool behind the cache.
+ */
+static inline void simple_mpmc_pool_cache_init(simple_mpmc_pool_cache_t *cache,
+                                               simple_mpmc_pool_t *spool)
+{
+    cache->spool = spool;
+    cache->count = 0;
+}
+
+/**
+ * @brief  Put the first n blocks of the cache back into the shared RINGBUF.
+ * @details The RINGBUF has room for every block of the pool, a put only fails while the slot
+ *   after the last one is still held by a reader which claimed it and was preempted. Wait for
+ *   it with a CPU relax, then give up the CPU, that reader may need it.
+ *   This never returns if a block was freed twice or does not belong to the pool: the RINGBUF
+ *   is then full for good.
+ */
+static inline void mpmc_pool_cache_put_back(simple_mpmc_pool_cache_t *cache, uint16_t n)
+{
+    uint16_t done = 0;
+    uint32_t tries = 0;
+
+    while (done < n)
+    {
+        uint32_t cnt = simple_mpmc_data_ringbuffer_put_n(&cache->spool->ringbuf,
+                                                         &cache->items[done], n - done);
+
+        if (cnt > 0)
+        {
+            done += cnt;
+            tries = 0;
+            continue;
+        }
+#if defined(__linux__)
+        if (++tries > SIMPLE_MPMC_POOL_SPIN_CNT)
+        {
+            sched_yield();
+            continue;
+        }
+#endif
+        SIMPLE_RINGBUFFER_CPU_RELAX();
+    }
+}
+
+/**
+ * @brief  Give every block held in the cache back to the pool, e.g. before the thread exits.
+ * @details May block while another thread holds a slot of the RINGBUF, see
+ *   mpmc_pool_cache_put_back().
+ * @param  [in] cache: The cache to be used.
+ */
+static inline void simple_mpmc_pool_cache_flush(simple_mpmc_pool_cache_t *cache)
+{
+    mpmc_pool_cache_put_back(cache, cache->count);
+    cache->count = 0;
+}
+
+/**
+ * @brief  Allocate a block.
+ * @param  [in] cache: The cache of the calling thread.
+ * @return The block, NULL if the pool and the cache are empty.
+ */
+static inline void *simple_mpmc_pool_alloc(simple_mpmc_pool_cache_t *cache)
+{
+    if (cache->count == 0)
+    {
+        cache->count = simple_mpmc_data_ringbuffer_get_n(&cache->spool->ringbuf, cache->items,
+                                                         SIMPLE_MPMC_POOL_CACHE_SIZE / 2);
+        if (cache->count == 0)
+        {
+            return NULL;
+        }
+    }
+
+    return cache->items[--cache->count];
+}
+
+/**
+ * @brief  Free a block, which may have been allocated by another thread.
+ * @details When the cache is full half of it goes back to the pool, which may block like
+ *   simple_mpmc_pool_cache_flush(). ptr must come from this pool and be freed only once.
+ * @param  [in] cache: The cache of the calling thread.
+ * @param  [in] ptr: The block.
+ */
+static inline void simple_mpmc_pool_free(simple_mpmc_pool_cache_t *cache, void *ptr)
+{
+    if (cache->count == SIMPLE_MPMC_POOL_CACHE_SIZE)
+    {
+        /* keep the newest half, it is the most likely to be still in cache */
+        mpmc_pool_cache_put_back(cache, SIMPLE_MPMC_POOL_CACHE_SIZE / 2);
+        memmove(&cache->items[0], &cache->items[SIMPLE_MPMC_POOL_CACHE_SIZE / 2],
+                sizeof(cache->items[0]) * (SIMPLE_MPMC_POOL_CACHE_SIZE / 2));
+        cache->count = SIMPLE_MPMC_POOL_CACHE_SIZE / 2;
+    }
+
+    cache->items[cache->count++] = ptr;
+}
+
+#if SIMPLE_RINGBUFFER_STATS
+/**
+ * @brief  Take a snapshot of the counters of the shared RINGBUF of free blocks, 'make STATS=1'.
+ * @details Only the traffic between the caches and the RINGBUF is seen: put_items counts the
+ *   blocks flushed back, get_items the blocks taken by refills, get_empty the refills which
+ *   found no free block, high_water the most free blocks the RINGBUF held since init.
+ * @param  [in] spool: The pool to be used.
+ * @param  [out] stats: The counters since init.
+ */
+static inline void simple_mpmc_pool_stats_snapshot(simple_mpmc_pool_t *spool,
+                                                   simple_ringbuffer_stats_t *stats)
+{
+    simple_mpmc_data_ringbuffer_stats_snapshot(&spool->ringbuf, stats);
+}
+#endif
+
+#endif /* _SIMPLE_MPMC_POOL_H_ */
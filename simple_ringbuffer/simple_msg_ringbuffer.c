@@ -0,0 +1,102 @@
+#include <string.h>
+
+#include "simple_msg_ringbuffer.h"
+
+/* header value of the skipped tail of buffer */
+#define MSG_RINGBUFFER_SKIP 0xffffffffu
+
+void *simple_msg_ringbuffer_reserve(simple_msg_ringbuffer_t *msgbuf, uint32_t len)
+{
+    simple_ringbuffer_span_t span[2];
+    uint32_t need;
+
+    if (len > msgbuf->ringbuf.total_size - sizeof(uint32_t))
+    {
+        return NULL;
+    }
+    need = SIMPLE_MSG_RINGBUFFER_RECORD_SIZE(len);
+    simple_ringbuffer_reserve(&msgbuf->ringbuf, span);
+
+    if (span[0].len >= need)
+    {
+        msgbuf->record = span[0].data;
+    }
+    else if (span[1].len >= need)
+    {
+        /*
+         * Not enough room before the end of buffer, but at the beginning. Records are 4 bytes
+         * aligned so the tail has room for the marker, publish it at once, it is of no use for
+         * any other message as the free space wraps.
+         */
+        *(uint32_t *)span[0].data = MSG_RINGBUFFER_SKIP;
+        simple_ringbuffer_commit(&msgbuf->ringbuf, span[0].len);
+        msgbuf->record = span[1].data;
+    }
+    else
+    {
+        msgbuf->record = NULL;
+        return NULL;
+    }
+
+    return msgbuf->record + sizeof(uint32_t);
+}
+
+void simple_msg_ringbuffer_commit(simple_msg_ringbuffer_t *msgbuf, uint32_t len)
+{
+    *(uint32_t *)msgbuf->record = len;
+    /* publish the header and the payload to the consumer */
+    simple_ringbuffer_commit(&msgbuf->ringbuf, SIMPLE_MSG_RINGBUFFER_RECORD_SIZE(len));
+    msgbuf->record = NULL;
+}
+
+void *simple_msg_ringbuffer_peek(simple_msg_ringbuffer_t *msgbuf, uint32_t *len)
+{
+    simple_ringbuffer_span_t span[2];
+    uint32_t header;
+
+    if (simple_ringbuffer_peek(&msgbuf->ringbuf, span) == 0)
+    {
+        return NULL;
+    }
+
+    header = *(uint32_t *)span[0].data;
+    if (header == MSG_RINGBUFFER_SKIP)
+    {
+        /* the skipped tail was published in one go, span[0] ends with the buffer */
+        simple_ringbuffer_consume(&msgbuf->ringbuf, span[0].len);
+        if (simple_ringbuffer_peek(&msgbuf->ringbuf, span) == 0)
+        {
+            return NULL;
+        }
+        header = *(uint32_t *)span[0].data;
+    }
+
+    *len = header;
+
+    return span[0].data + sizeof(uint32_t);
+}
+
+void simple_msg_ringbuffer_consume(simple_msg_ringbuffer_t *msgbuf)
+{
+    uint32_t len;
+
+    if (simple_msg_ringbuffer_peek(msgbuf, &len) != NULL)
+    {
+        simple_ringbuffer_consume(&msgbuf->ringbuf, SIMPLE_MSG_RINGBUFFER_RECORD_SIZE(len));
+    }
+}
+
+int simple_msg_ringbuffer_put(simple_msg_ringbuffer_t *msgbuf, const void *buffer, uint32_t len)
+{
+    void *payload = simple_msg_ringbuffer_reserve(msgbuf, len);
+
+    if (payload == NULL)
+    {
+        return 0;
+    }
+
+    memcpy(payload, buffer, len);
+    simple_msg_ringbuffer_commit(msgbuf, len);
+
+    return 1;
+}
@@ -0,0 +1,120 @@
+#ifndef _SIMPLE_MSG_RINGBUFFER_H_
+#define _SIMPLE_MSG_RINGBUFFER_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "simple_ringbuffer.h"
+
+/**
+ * @brief   Define a RINGBUF of variable length messages, on top of simple_ringbuffer_t.
+ * @details
+ *   Every message is stored as a uint32_t length header followed by the payload, rounded up to
+ *   4 bytes, in one contiguous region of the buffer: a message never straddles the end of the
+ *   buffer. When it does not fit before the end, the producer writes a skip marker there and
+ *   the message starts again at the beginning of buffer, the consumer drops the skipped tail.
+ *   Producer: simple_msg_ringbuffer_reserve(), write in place, simple_msg_ringbuffer_commit().
+ *   Consumer: simple_msg_ringbuffer_peek(), read in place, simple_msg_ringbuffer_consume().
+ *   Same threading rules as simple_ringbuffer_t (one producer and one consumer in SPSC mode).
+ */
+typedef struct simple_msg_ringbuffer
+{
+    simple_ringbuffer_t ringbuf;
+    uint8_t *record; /* Write. Header of the reserved message, NULL if none */
+} simple_msg_ringbuffer_t;
+
+#ifndef MROUND
+/**
+ * @brief Round up to nearest multiple of 4, see simple_data_ringbuffer.h.
+ */
+#define MROUND(x) (((uint32_t)(x) + 3) & (~((uint32_t)3)))
+#endif
+
+/**
+ * @brief Bytes used in the RINGBUF by a message of _len bytes, header included.
+ */
+#define SIMPLE_MSG_RINGBUFFER_RECORD_SIZE(_len) (sizeof(uint32_t) + MROUND(_len))
+
+#define SIMPLE_MSG_RINGBUFFER_DEFINE(_name, _size)                                                 \
+    static uint32_t _name##_data_storage[MROUND(_size) / sizeof(uint32_t)];                        \
+    static simple_msg_ringbuffer_t _name
+
+#define SIMPLE_MSG_RINGBUFFER_INIT(_name, _size)                                                   \
+    simple_msg_ringbuffer_init(&_name, MROUND(_size), (uint8_t *)_name##_data_storage)
+
+/**
+ * @brief  Initialize the RINGBUF.
+ * @param  [in] msgbuf: The ringbuf to be used.
+ * @param  [in] total_size: The size of buffer in bytes, rounded down to a multiple of 4.
+ * @param  [in] buffer: The buffer to be used, 4 bytes aligned.
+ */
+static inline void simple_msg_ringbuffer_init(simple_msg_ringbuffer_t *msgbuf, uint32_t total_size,
+                                              uint8_t *buffer)
+{
+    simple_ringbuffer_init(&msgbuf->ringbuf, total_size & ~(uint32_t)3, buffer);
+    msgbuf->record = NULL;
+}
+
+/**
+ * @brief  Check if the RINGBUF holds no message.
+ * @param  [in] msgbuf: The ringbuf to be used.
+ * @return 1 if the RINGBUF is empty, 0 otherwise.
+ */
+static inline int simple_msg_ringbuffer_is_empty(simple_msg_ringbuffer_t *msgbuf)
+{
+    return simple_ringbuffer_is_empty(&msgbuf->ringbuf);
+}
+
+/**
+ * @brief  Returns the bytes used by the messages (headers, padding and skipped tail included).
+ * @param  [in] msgbuf: The ringbuf to be used.
+ * @return The used size of the RINGBUF in bytes.
+ */
+static inline uint32_t simple_msg_ringbuffer_size(simple_msg_ringbuffer_t *msgbuf)
+{
+    return simple_ringbuffer_size(&msgbuf->ringbuf);
+}
+
+/**
+ * @brief   Reserve a message of len bytes, to be written in place.
+ * @details Producer side. Nothing is visible to the consumer until
+ *   simple_msg_ringbuffer_commit() is called, a new reserve replaces a pending one.
+ * @param  [in] msgbuf: The ringbuf to be used.
+ * @param  [in] len: The length of the message.
+ * @return The payload of the message (4 bytes aligned), NULL if there is no contiguous room.
+ */
+void *simple_msg_ringbuffer_reserve(simple_msg_ringbuffer_t *msgbuf, uint32_t len);
+
+/**
+ * @brief  Publish the message returned by simple_msg_ringbuffer_reserve().
+ * @param  [in] msgbuf: The ringbuf to be used.
+ * @param  [in] len: The final length of the message, at most the reserved length.
+ */
+void simple_msg_ringbuffer_commit(simple_msg_ringbuffer_t *msgbuf, uint32_t len);
+
+/**
+ * @brief   Peek the oldest message in place.
+ * @details Consumer side, the message stays in the RINGBUF until
+ *   simple_msg_ringbuffer_consume() is called.
+ * @param  [in] msgbuf: The ringbuf to be used.
+ * @param  [out] len: The length of the message.
+ * @return The payload of the message, NULL if the RINGBUF is empty.
+ */
+void *simple_msg_ringbuffer_peek(simple_msg_ringbuffer_t *msgbuf, uint32_t *len);
+
+/**
+ * @brief  Release the oldest message, the one returned by simple_msg_ringbuffer_peek().
+ * @param  [in] msgbuf: The ringbuf to be used.
+ */
+void simple_msg_ringbuffer_consume(simple_msg_ringbuffer_t *msgbuf);
+
+/**
+ * @brief  Copy a message into the RINGBUF.
+ * @param  [in] msgbuf: The ringbuf to be used.
+ * @param  [in] buffer: The message.
+ * @param  [in] len: The length of the message.
+ * @return 1 if the message was put, 0 if there is no room.
+ */
+int simple_msg_ringbuffer_put(simple_msg_ringbuffer_t *msgbuf, const void *buffer, uint32_t len);
+
+#endif /* _SIMPLE_MSG_RINGBUFFER_H_ */
@@ -6,7 +6,7 @@
 typedef struct simple_pool
 {
     simple_data_ringbuffer_t ringbuf;
-    uint16_t item_size;
+    simple_data_index_t item_size;
 } simple_pool_t;
 
 #define SIMPLE_POOL_ENQUEUE(_spool, _val)                                                          \
@@ -37,15 +37,16 @@ typedef struct simple_pool
                      _data_size)
 
 static inline void simple_pool_init(simple_pool_t *spool, void **fifo_storage,
-                                    uint8_t *data_storage, uint16_t n, uint16_t data_item_size)
+                                    uint8_t *data_storage, simple_data_index_t n,
+                                    simple_data_index_t data_item_size)
 {
     spool->item_size = data_item_size;
 
     // in 32 system, ptr is 32bit.
     simple_data_ringbuffer_init(&spool->ringbuf, n, sizeof(void *), fifo_storage);
-    for (int i = 0; i < n; i++)
+    for (simple_data_index_t i = 0; i < n; i++)
     {
-        void *data_item = (void *)(data_storage + MROUND(data_item_size) * i);
+        void *data_item = (void *)(data_storage + (size_t)MROUND(data_item_size) * i);
         SIMPLE_POOL_ENQUEUE(spool, data_item);
     }
 }
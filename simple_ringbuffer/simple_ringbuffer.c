@@ -3,60 +3,516 @@
 #include <stdlib.h>
 
 #include "simple_ringbuffer.h"
+#include "simple_ringbuffer_internal.h"
 
 #ifndef MIN
 #define MIN(a, b) (((a) < (b)) ? (a) : (b))
 #endif
 
-#define RINGBUFFER_INDEX_TO_PTR(_index, _total_size)                                               \
-    ((_index >= _total_size) ? (_index - _total_size) : (_index))
+/**
+ * @brief  Producer side view of read_index.
+ * @details In SPSC mode the producer works on its own copy of read_index, and only loads the
+ *   consumer cache line again when that copy does not leave room for len bytes.
+ */
+static inline uint32_t ringbuffer_producer_read_index(simple_ringbuffer_t *ringbuf,
+                                                      uint32_t write_index, uint32_t len,
+                                                      uint32_t mask)
+{
+#if SIMPLE_RINGBUFFER_SPSC
+    return ringbuffer_cached_read_index(&ringbuf->read_index, &ringbuf->read_index_cache,
+                                        write_index, len, ringbuf->total_size, mask);
+#else
+    return SIMPLE_RINGBUFFER_LOAD_ACQUIRE(ringbuf->read_index);
+#endif
+}
 
-uint32_t simple_ringbuffer_put(simple_ringbuffer_t *ringbuf, uint8_t *buffer, uint32_t len)
+/**
+ * @brief  Consumer side view of write_index.
+ * @details In SPSC mode the consumer works on its own copy of write_index, and only loads the
+ *   producer cache line again when that copy does not hold len bytes.
+ */
+static inline uint32_t ringbuffer_consumer_write_index(simple_ringbuffer_t *ringbuf,
+                                                       uint32_t read_index, uint32_t len,
+                                                       uint32_t mask)
 {
-    uint32_t l;
-    uint32_t write_index;
-    uint32_t wptr = RINGBUFFER_INDEX_TO_PTR(ringbuf->write_index, ringbuf->total_size);
+#if SIMPLE_RINGBUFFER_SPSC
+    return ringbuffer_cached_write_index(&ringbuf->write_index, &ringbuf->write_index_cache,
+                                         read_index, len, ringbuf->total_size, mask);
+#else
+    return SIMPLE_RINGBUFFER_LOAD_ACQUIRE(ringbuf->write_index);
+#endif
+}
 
-    len = MIN(len, simple_ringbuffer_reserve_size(ringbuf));
+/**
+ * @brief  Length of a copy that can be done in one go from ptr.
+ * @details A mirrored RINGBUF has the storage mapped again right after the end.
+ */
+static inline uint32_t ringbuffer_linear_size(simple_ringbuffer_t *ringbuf, uint32_t ptr,
+                                              uint32_t len)
+{
+    return ringbuf->mirror ? len : MIN(len, ringbuf->total_size - ptr);
+}
 
-    /* first put the data starting from ringbuf->write_index to buffer end */
-    l = MIN(len, ringbuf->total_size - wptr);
-    memcpy(ringbuf->buffer + wptr, buffer, l);
+/**
+ * @brief  Count len bytes put at write_index, nothing without SIMPLE_RINGBUFFER_STATS.
+ * @details read_index is the producer view of it. In SPSC mode that is a cached copy which may
+ *   be far behind, it is only reloaded when it would raise high_water.
+ */
+static inline void ringbuffer_stats_put(simple_ringbuffer_t *ringbuf, uint32_t write_index,
+                                        uint32_t read_index, uint32_t len, uint32_t mask)
+{
+#if SIMPLE_RINGBUFFER_STATS
+    uint32_t high_water = SIMPLE_RINGBUFFER_LOAD_RELAXED(ringbuf->put_stats.high_water);
+    uint32_t used;
 
-    /* then put the rest (if any) at the beginning of the buffer */
-    memcpy(ringbuf->buffer, buffer + l, len - l);
+    if (len == 0)
+    {
+        return;
+    }
+    SIMPLE_RINGBUFFER_STATS_ADD(ringbuf->put_stats.items, 1);
+    SIMPLE_RINGBUFFER_STATS_ADD(ringbuf->put_stats.bytes, len);
+    SIMPLE_RINGBUFFER_STATS_ADD(ringbuf->put_stats.wraps,
+                                RINGBUFFER_INDEX_TO_PTR(write_index, ringbuf->total_size, mask) +
+                                                len >=
+                                        ringbuf->total_size);
 
-    write_index = ringbuf->write_index + len;
-    if (write_index >= (ringbuf->total_size << 1))
+    used = RINGBUFFER_USED_SIZE(write_index, read_index, ringbuf->total_size, mask) + len;
+#if SIMPLE_RINGBUFFER_SPSC
+    if (used > high_water)
+    {
+        read_index = SIMPLE_RINGBUFFER_LOAD_ACQUIRE(ringbuf->read_index);
+        ringbuf->read_index_cache = read_index;
+        used = RINGBUFFER_USED_SIZE(write_index, read_index, ringbuf->total_size, mask) + len;
+    }
+#endif
+    if (used > high_water)
     {
-        write_index -= (ringbuf->total_size << 1);
+        SIMPLE_RINGBUFFER_STORE_RELAXED(ringbuf->put_stats.high_water, used);
     }
-    ringbuf->write_index = write_index;
+#endif
+}
+
+/**
+ * @brief  Count a put which found no room for all of its data.
+ */
+static inline void ringbuffer_stats_full(simple_ringbuffer_t *ringbuf, int full)
+{
+#if SIMPLE_RINGBUFFER_STATS
+    SIMPLE_RINGBUFFER_STATS_ADD(ringbuf->put_stats.full, full != 0);
+#endif
+}
+
+/**
+ * @brief  Count len bytes get, and a get which found the RINGBUF empty.
+ */
+static inline void ringbuffer_stats_get(simple_ringbuffer_t *ringbuf, uint32_t len, int empty)
+{
+#if SIMPLE_RINGBUFFER_STATS
+    SIMPLE_RINGBUFFER_STATS_ADD(ringbuf->get_stats.items, len != 0);
+    SIMPLE_RINGBUFFER_STATS_ADD(ringbuf->get_stats.bytes, len);
+    SIMPLE_RINGBUFFER_STATS_ADD(ringbuf->get_stats.empty, empty != 0);
+#endif
+}
+
+/**
+ * @brief  Body of simple_ringbuffer_put(), inlined once for each kind of size.
+ */
+static inline uint32_t ringbuffer_put(simple_ringbuffer_t *ringbuf, uint8_t *buffer, uint32_t len,
+                                      uint32_t mask)
+{
+    uint32_t l;
+    /* write_index is owned by the producer, read_index must be observed before data overwrite */
+    uint32_t write_index = SIMPLE_RINGBUFFER_LOAD_RELAXED(ringbuf->write_index);
+    uint32_t read_index = ringbuffer_producer_read_index(ringbuf, write_index, len, mask);
+    uint32_t wptr = RINGBUFFER_INDEX_TO_PTR(write_index, ringbuf->total_size, mask);
+
+    ringbuffer_stats_full(ringbuf,
+                          ringbuf->total_size - RINGBUFFER_USED_SIZE(write_index, read_index,
+                                                                     ringbuf->total_size, mask) <
+                                  len);
+    len = MIN(len, ringbuf->total_size - RINGBUFFER_USED_SIZE(write_index, read_index,
+                                                              ringbuf->total_size, mask));
+    ringbuffer_stats_put(ringbuf, write_index, read_index, len, mask);
+
+    /* the data from ringbuf->write_index to buffer end, then the rest (if any) at the beginning */
+    l = ringbuffer_linear_size(ringbuf, wptr, len);
+    ringbuffer_copy(ringbuf->buffer + wptr, buffer, ringbuf->buffer, buffer + l, l, len);
+
+    write_index = ringbuffer_index_add(write_index, len, ringbuf->total_size, mask);
+    /* publish the data to the consumer */
+    SIMPLE_RINGBUFFER_STORE_RELEASE(ringbuf->write_index, write_index);
 
     return len;
 }
 
-uint32_t simple_ringbuffer_get(simple_ringbuffer_t *ringbuf, uint8_t *buffer, uint32_t len)
+/**
+ * @brief  Body of simple_ringbuffer_get(), inlined once for each kind of size.
+ */
+static inline uint32_t ringbuffer_get(simple_ringbuffer_t *ringbuf, uint8_t *buffer, uint32_t len,
+                                      uint32_t mask)
 {
     uint32_t l;
-    uint32_t read_index;
-    uint32_t rptr = RINGBUFFER_INDEX_TO_PTR(ringbuf->read_index, ringbuf->total_size);
+    /* read_index is owned by the consumer, write_index must be observed before data read */
+    uint32_t read_index = SIMPLE_RINGBUFFER_LOAD_RELAXED(ringbuf->read_index);
+    uint32_t write_index = ringbuffer_consumer_write_index(ringbuf, read_index, len, mask);
+    uint32_t rptr = RINGBUFFER_INDEX_TO_PTR(read_index, ringbuf->total_size, mask);
+
+    len = MIN(len, RINGBUFFER_USED_SIZE(write_index, read_index, ringbuf->total_size, mask));
+    ringbuffer_stats_get(ringbuf, len, read_index == write_index);
 
-    len = MIN(len, simple_ringbuffer_size(ringbuf));
+    /* the data from ringbuf->read_index to buffer end, then the rest (if any) from the beginning */
+    l = ringbuffer_linear_size(ringbuf, rptr, len);
+    ringbuffer_copy(buffer, ringbuf->buffer + rptr, buffer + l, ringbuf->buffer, l, len);
 
-    /* first get the data from ringbuf->read_index until the end of the buffer */
-    l = MIN(len, ringbuf->total_size - rptr);
-    memcpy(buffer, ringbuf->buffer + rptr, l);
+    read_index = ringbuffer_index_add(read_index, len, ringbuf->total_size, mask);
+    /* release the space to the producer */
+    SIMPLE_RINGBUFFER_STORE_RELEASE(ringbuf->read_index, read_index);
 
-    /* then get the rest (if any) from the beginning of the buffer */
-    memcpy(buffer + l, ringbuf->buffer, len - l);
+    return len;
+}
 
-    read_index = ringbuf->read_index + len;
-    if (read_index >= (ringbuf->total_size << 1))
+uint32_t simple_ringbuffer_put(simple_ringbuffer_t *ringbuf, uint8_t *buffer, uint32_t len)
+{
+    /* power of 2 size, every wrap is a mask */
+    if (ringbuf->index_mask)
     {
-        read_index -= (ringbuf->total_size << 1);
+        return ringbuffer_put(ringbuf, buffer, len, ringbuf->index_mask);
     }
-    ringbuf->read_index = read_index;
+
+    return ringbuffer_put(ringbuf, buffer, len, 0);
+}
+
+uint32_t simple_ringbuffer_get(simple_ringbuffer_t *ringbuf, uint8_t *buffer, uint32_t len)
+{
+    /* power of 2 size, every wrap is a mask */
+    if (ringbuf->index_mask)
+    {
+        return ringbuffer_get(ringbuf, buffer, len, ringbuf->index_mask);
+    }
+
+    return ringbuffer_get(ringbuf, buffer, len, 0);
+}
+
+/**
+ * @brief  Sum of the iov lengths, total_size + 1 (more than the RINGBUF ever holds) as soon as it
+ *         goes over total_size, so it cannot overflow.
+ */
+static inline uint32_t ringbuffer_iov_len(simple_ringbuffer_t *ringbuf,
+                                          const simple_ringbuffer_span_t *iov, uint32_t iovcnt)
+{
+    uint32_t len = 0;
+
+    for (uint32_t i = 0; i < iovcnt; i++)
+    {
+        if (iov[i].len > ringbuf->total_size - len)
+        {
+            return ringbuf->total_size + 1;
+        }
+        len += iov[i].len;
+    }
+
+    return len;
+}
+
+/**
+ * @brief  Body of simple_ringbuffer_putv(), inlined once for each kind of size.
+ */
+static inline uint32_t ringbuffer_putv(simple_ringbuffer_t *ringbuf,
+                                       const simple_ringbuffer_span_t *iov, uint32_t iovcnt,
+                                       uint32_t mask)
+{
+    uint32_t len = ringbuffer_iov_len(ringbuf, iov, iovcnt);
+    uint32_t write_index = SIMPLE_RINGBUFFER_LOAD_RELAXED(ringbuf->write_index);
+    uint32_t read_index = ringbuffer_producer_read_index(ringbuf, write_index, len, mask);
+    uint32_t index = write_index;
+
+    /* all or nothing */
+    if (ringbuf->total_size - RINGBUFFER_USED_SIZE(write_index, read_index, ringbuf->total_size,
+                                                   mask) <
+        len)
+    {
+        ringbuffer_stats_full(ringbuf, 1);
+        return 0;
+    }
+    ringbuffer_stats_put(ringbuf, write_index, read_index, len, mask);
+
+    for (uint32_t i = 0; i < iovcnt; i++)
+    {
+        uint32_t wptr = RINGBUFFER_INDEX_TO_PTR(index, ringbuf->total_size, mask);
+        uint32_t l = ringbuffer_linear_size(ringbuf, wptr, iov[i].len);
+
+        ringbuffer_copy(ringbuf->buffer + wptr, iov[i].data, ringbuf->buffer, iov[i].data + l, l,
+                        iov[i].len);
+        index = ringbuffer_index_add(index, iov[i].len, ringbuf->total_size, mask);
+    }
+    /* publish the whole message to the consumer at once */
+    SIMPLE_RINGBUFFER_STORE_RELEASE(ringbuf->write_index, index);
 
     return len;
 }
+
+/**
+ * @brief  Body of simple_ringbuffer_getv(), inlined once for each kind of size.
+ */
+static inline uint32_t ringbuffer_getv(simple_ringbuffer_t *ringbuf,
+                                       const simple_ringbuffer_span_t *iov, uint32_t iovcnt,
+                                       uint32_t mask)
+{
+    uint32_t len = ringbuffer_iov_len(ringbuf, iov, iovcnt);
+    uint32_t read_index = SIMPLE_RINGBUFFER_LOAD_RELAXED(ringbuf->read_index);
+    uint32_t write_index = ringbuffer_consumer_write_index(ringbuf, read_index, len, mask);
+    uint32_t index = read_index;
+
+    /* all or nothing */
+    if (RINGBUFFER_USED_SIZE(write_index, read_index, ringbuf->total_size, mask) < len)
+    {
+        ringbuffer_stats_get(ringbuf, 0, read_index == write_index);
+        return 0;
+    }
+    ringbuffer_stats_get(ringbuf, len, read_index == write_index);
+
+    for (uint32_t i = 0; i < iovcnt; i++)
+    {
+        uint32_t rptr = RINGBUFFER_INDEX_TO_PTR(index, ringbuf->total_size, mask);
+        uint32_t l = ringbuffer_linear_size(ringbuf, rptr, iov[i].len);
+
+        ringbuffer_copy(iov[i].data, ringbuf->buffer + rptr, iov[i].data + l, ringbuf->buffer, l,
+                        iov[i].len);
+        index = ringbuffer_index_add(index, iov[i].len, ringbuf->total_size, mask);
+    }
+    /* release the space of the whole message to the producer at once */
+    SIMPLE_RINGBUFFER_STORE_RELEASE(ringbuf->read_index, index);
+
+    return len;
+}
+
+uint32_t simple_ringbuffer_putv(simple_ringbuffer_t *ringbuf, const simple_ringbuffer_span_t *iov,
+                                uint32_t iovcnt)
+{
+    /* power of 2 size, every wrap is a mask */
+    if (ringbuf->index_mask)
+    {
+        return ringbuffer_putv(ringbuf, iov, iovcnt, ringbuf->index_mask);
+    }
+
+    return ringbuffer_putv(ringbuf, iov, iovcnt, 0);
+}
+
+uint32_t simple_ringbuffer_getv(simple_ringbuffer_t *ringbuf, const simple_ringbuffer_span_t *iov,
+                                uint32_t iovcnt)
+{
+    /* power of 2 size, every wrap is a mask */
+    if (ringbuf->index_mask)
+    {
+        return ringbuffer_getv(ringbuf, iov, iovcnt, ringbuf->index_mask);
+    }
+
+    return ringbuffer_getv(ringbuf, iov, iovcnt, 0);
+}
+
+uint32_t simple_ringbuffer_put_overwrite(simple_ringbuffer_t *ringbuf, uint8_t *buffer,
+                                         uint32_t len)
+{
+    uint32_t mask = ringbuf->index_mask;
+    uint32_t write_index = SIMPLE_RINGBUFFER_LOAD_RELAXED(ringbuf->write_index);
+    uint32_t read_index = ringbuffer_producer_read_index(ringbuf, write_index, len, mask);
+    uint32_t dropped = 0;
+    uint32_t wptr, l;
+
+    /* only the newest total_size bytes can be kept */
+    if (len > ringbuf->total_size)
+    {
+        dropped = len - ringbuf->total_size;
+        buffer += dropped;
+        len = ringbuf->total_size;
+    }
+
+    /* no room: push the oldest data out, unless the consumer releases it first */
+    while (ringbuf->total_size - RINGBUFFER_USED_SIZE(write_index, read_index,
+                                                      ringbuf->total_size, mask) <
+           len)
+    {
+        uint32_t need = len - (ringbuf->total_size - RINGBUFFER_USED_SIZE(write_index, read_index,
+                                                                          ringbuf->total_size,
+                                                                          mask));
+        uint32_t next = ringbuffer_index_add(read_index, need, ringbuf->total_size, mask);
+
+        if (SIMPLE_RINGBUFFER_CAS(ringbuf->read_index, &read_index, next))
+        {
+            dropped += need;
+            read_index = next;
+        }
+    }
+#if SIMPLE_RINGBUFFER_SPSC
+    ringbuf->read_index_cache = read_index;
+#endif
+    ringbuffer_stats_put(ringbuf, write_index, read_index, len, mask);
+
+    if (dropped != 0)
+    {
+        /* a consumer copying the dropped data sees the count change, the data is written after */
+        SIMPLE_RINGBUFFER_STORE_RELAXED(ringbuf->overwritten,
+                                        SIMPLE_RINGBUFFER_LOAD_RELAXED(ringbuf->overwritten) +
+                                                dropped);
+        SIMPLE_RINGBUFFER_FENCE_RELEASE();
+    }
+
+    wptr = RINGBUFFER_INDEX_TO_PTR(write_index, ringbuf->total_size, mask);
+    l = ringbuffer_linear_size(ringbuf, wptr, len);
+    ringbuffer_copy(ringbuf->buffer + wptr, buffer, ringbuf->buffer, buffer + l, l, len);
+
+    /* publish the data to the consumer */
+    SIMPLE_RINGBUFFER_STORE_RELEASE(
+            ringbuf->write_index,
+            ringbuffer_index_add(write_index, len, ringbuf->total_size, mask));
+
+    return dropped;
+}
+
+uint32_t simple_ringbuffer_get_overwrite(simple_ringbuffer_t *ringbuf, uint8_t *buffer,
+                                         uint32_t len)
+{
+    uint32_t mask = ringbuf->index_mask;
+
+    while (1)
+    {
+        /* the producer moves read_index too, the cached write_index may be behind it */
+        uint32_t overwritten = SIMPLE_RINGBUFFER_LOAD_ACQUIRE(ringbuf->overwritten);
+        uint32_t read_index = SIMPLE_RINGBUFFER_LOAD_ACQUIRE(ringbuf->read_index);
+        uint32_t write_index = SIMPLE_RINGBUFFER_LOAD_ACQUIRE(ringbuf->write_index);
+        uint32_t used = RINGBUFFER_USED_SIZE(write_index, read_index, ringbuf->total_size, mask);
+        uint32_t rptr = RINGBUFFER_INDEX_TO_PTR(read_index, ringbuf->total_size, mask);
+        uint32_t n = MIN(len, used);
+        uint32_t l;
+
+        if (used > ringbuf->total_size)
+        {
+            /* lapped between the two loads */
+            continue;
+        }
+
+        /*
+         * Seqlock read: the producer may be overwriting these bytes right now. That is on
+         * purpose, the copy is only kept if overwritten did not move meanwhile, checked below.
+         * Do not drop the retry loop, it is what makes the result untorn.
+         */
+        l = ringbuffer_linear_size(ringbuf, rptr, n);
+        ringbuffer_copy(buffer, ringbuf->buffer + rptr, buffer + l, ringbuf->buffer, l, n);
+
+        /* lapped during the copy: the producer overwrote the oldest data, it may be torn */
+        SIMPLE_RINGBUFFER_FENCE_ACQUIRE();
+        if (SIMPLE_RINGBUFFER_LOAD_RELAXED(ringbuf->overwritten) != overwritten)
+        {
+            continue;
+        }
+        /* release the space, unless the producer pushed read_index meanwhile */
+        if (n == 0 || SIMPLE_RINGBUFFER_CAS(ringbuf->read_index, &read_index,
+                                            ringbuffer_index_add(read_index, n,
+                                                                 ringbuf->total_size, mask)))
+        {
+            ringbuffer_stats_get(ringbuf, n, used == 0);
+            return n;
+        }
+    }
+}
+
+/**
+ * @brief  Split len bytes from ptr into the part up to the end of buffer and the part wrapped to
+ *         the start.
+ */
+static inline void ringbuffer_span_split(simple_ringbuffer_t *ringbuf, uint32_t ptr, uint32_t len,
+                                         simple_ringbuffer_span_t span[2])
+{
+    span[0].data = ringbuf->buffer + ptr;
+    span[0].len = ringbuffer_linear_size(ringbuf, ptr, len);
+    span[1].data = ringbuf->buffer;
+    span[1].len = len - span[0].len;
+}
+
+uint32_t simple_ringbuffer_reserve(simple_ringbuffer_t *ringbuf, simple_ringbuffer_span_t span[2])
+{
+    uint32_t mask = ringbuf->index_mask;
+    uint32_t write_index = SIMPLE_RINGBUFFER_LOAD_RELAXED(ringbuf->write_index);
+    uint32_t read_index =
+            ringbuffer_producer_read_index(ringbuf, write_index, ringbuf->total_size, mask);
+    uint32_t len = ringbuf->total_size -
+                   RINGBUFFER_USED_SIZE(write_index, read_index, ringbuf->total_size, mask);
+
+    ringbuffer_stats_full(ringbuf, len == 0);
+    ringbuffer_span_split(ringbuf, RINGBUFFER_INDEX_TO_PTR(write_index, ringbuf->total_size, mask),
+                          len, span);
+
+    return len;
+}
+
+void simple_ringbuffer_commit(simple_ringbuffer_t *ringbuf, uint32_t len)
+{
+    uint32_t write_index = SIMPLE_RINGBUFFER_LOAD_RELAXED(ringbuf->write_index);
+
+#if SIMPLE_RINGBUFFER_STATS
+    ringbuffer_stats_put(ringbuf, write_index,
+                         ringbuffer_producer_read_index(ringbuf, write_index, 0,
+                                                        ringbuf->index_mask),
+                         len, ringbuf->index_mask);
+#endif
+    /* publish the data to the consumer */
+    SIMPLE_RINGBUFFER_STORE_RELEASE(ringbuf->write_index,
+                                    ringbuffer_index_add(write_index, len, ringbuf->total_size,
+                                                         ringbuf->index_mask));
+}
+
+uint32_t simple_ringbuffer_peek(simple_ringbuffer_t *ringbuf, simple_ringbuffer_span_t span[2])
+{
+    uint32_t mask = ringbuf->index_mask;
+    uint32_t read_index = SIMPLE_RINGBUFFER_LOAD_RELAXED(ringbuf->read_index);
+    uint32_t write_index =
+            ringbuffer_consumer_write_index(ringbuf, read_index, ringbuf->total_size, mask);
+    uint32_t len = RINGBUFFER_USED_SIZE(write_index, read_index, ringbuf->total_size, mask);
+
+    ringbuffer_stats_get(ringbuf, 0, len == 0);
+    ringbuffer_span_split(ringbuf, RINGBUFFER_INDEX_TO_PTR(read_index, ringbuf->total_size, mask),
+                          len, span);
+
+    return len;
+}
+
+void simple_ringbuffer_consume(simple_ringbuffer_t *ringbuf, uint32_t len)
+{
+    uint32_t read_index = SIMPLE_RINGBUFFER_LOAD_RELAXED(ringbuf->read_index);
+
+    ringbuffer_stats_get(ringbuf, len, 0);
+    /* release the space to the producer */
+    SIMPLE_RINGBUFFER_STORE_RELEASE(ringbuf->read_index,
+                                    ringbuffer_index_add(read_index, len, ringbuf->total_size,
+                                                         ringbuf->index_mask));
+}
+
+uint8_t *simple_ringbuffer_mirror_peek(simple_ringbuffer_t *ringbuf, uint32_t *len)
+{
+    simple_ringbuffer_span_t span[2];
+
+    simple_ringbuffer_peek(ringbuf, span);
+    *len = span[0].len;
+
+    return span[0].data;
+}
+
+void simple_ringbuffer_mirror_consume(simple_ringbuffer_t *ringbuf, uint32_t len)
+{
+    simple_ringbuffer_consume(ringbuf, len);
+}
+
+uint8_t *simple_ringbuffer_mirror_reserve(simple_ringbuffer_t *ringbuf, uint32_t *len)
+{
+    simple_ringbuffer_span_t span[2];
+
+    simple_ringbuffer_reserve(ringbuf, span);
+    *len = span[0].len;
+
+    return span[0].data;
+}
+
+void simple_ringbuffer_mirror_commit(simple_ringbuffer_t *ringbuf, uint32_t len)
+{
+    simple_ringbuffer_commit(ringbuf, len);
+}
@@ -4,17 +4,51 @@
 #include <stdint.h>
 #include <stddef.h>
 
+#include "simple_ringbuffer_port.h"
+
 typedef struct simple_ringbuffer
 {
-    uint32_t total_size;  /* Number of buffers */
-    uint32_t read_index;  /* Read. Read index */
-    uint32_t write_index; /* Write. Write index */
+    uint32_t total_size; /* Number of buffers */
+    uint32_t index_mask; /* SIMPLE_RINGBUFFER_INDEX_MASK(total_size) */
     uint8_t *buffer;
+    uint8_t mirror; /* buffer is mapped twice back-to-back, see simple_ringbuffer_init_mirror() */
+
+    /* Consumer side, on its own cache line in SPSC mode */
+    SIMPLE_RINGBUFFER_CACHE_ALIGNED
+    SIMPLE_RINGBUFFER_ATOMIC(uint32_t) read_index; /* Read. Read index */
+#if SIMPLE_RINGBUFFER_SPSC
+    uint32_t write_index_cache; /* Read. Last write_index seen by the consumer */
+#endif
+#if SIMPLE_RINGBUFFER_STATS
+    simple_ringbuffer_get_stats_t get_stats; /* Read. Consumer counters */
+#endif
+
+    /* Producer side, on its own cache line in SPSC mode */
+    SIMPLE_RINGBUFFER_CACHE_ALIGNED
+    SIMPLE_RINGBUFFER_ATOMIC(uint32_t) write_index; /* Write. Write index */
+    SIMPLE_RINGBUFFER_ATOMIC(uint32_t) overwritten; /* Write. Bytes dropped by put_overwrite */
+#if SIMPLE_RINGBUFFER_SPSC
+    uint32_t read_index_cache; /* Write. Last read_index seen by the producer */
+#endif
+#if SIMPLE_RINGBUFFER_STATS
+    simple_ringbuffer_put_stats_t put_stats; /* Write. Producer counters */
+#endif
 } simple_ringbuffer_t;
 
+/**
+ * @brief   A contiguous part of the RINGBUF storage, see simple_ringbuffer_reserve() and
+ *          simple_ringbuffer_peek().
+ */
+typedef struct simple_ringbuffer_span
+{
+    uint8_t *data;
+    uint32_t len;
+} simple_ringbuffer_span_t;
+
 #define SIMPLE_RINGBUFFER_DEFINE(_name, _num)                                                      \
     static uint8_t _name##_data_storage[_num];                                                     \
     static simple_ringbuffer_t _name = {.total_size = _num,                                        \
+                                        .index_mask = SIMPLE_RINGBUFFER_INDEX_MASK(_num),          \
                                         .write_index = 0,                                          \
                                         .read_index = 0,                                           \
                                         .buffer = (void *)_name##_data_storage}
@@ -38,12 +72,22 @@ static inline uint32_t simple_ringbuffer_total_size(simple_ringbuffer_t *ringbuf
  */
 static inline void simple_ringbuffer_reset(simple_ringbuffer_t *ringbuf)
 {
-    ringbuf->write_index = 0;
-    ringbuf->read_index = 0;
+    SIMPLE_RINGBUFFER_STORE_RELAXED(ringbuf->write_index, 0);
+    SIMPLE_RINGBUFFER_STORE_RELAXED(ringbuf->read_index, 0);
+    SIMPLE_RINGBUFFER_STORE_RELAXED(ringbuf->overwritten, 0);
+#if SIMPLE_RINGBUFFER_SPSC
+    ringbuf->write_index_cache = 0;
+    ringbuf->read_index_cache = 0;
+#endif
+#if SIMPLE_RINGBUFFER_STATS
+    simple_ringbuffer_stats_clear(&ringbuf->put_stats, &ringbuf->get_stats);
+#endif
 }
 
 /**
  * @brief  Initialize the RINGBUF.
+ * @details A power of 2 total_size selects the mask based index wrap, any other size the
+ *   generic one.
  * @param  [in] ringbuf: The ringbuf to be used.
  * @param  [in] total_size: The total size of the RINGBUF.
  * @param  [in] buffer: The buffer to be used.
@@ -52,9 +96,19 @@ static inline void simple_ringbuffer_init(simple_ringbuffer_t *ringbuf, uint32_t
                                           uint8_t *buffer)
 {
     ringbuf->total_size = total_size;
-    ringbuf->write_index = 0;
-    ringbuf->read_index = 0;
+    ringbuf->index_mask = SIMPLE_RINGBUFFER_INDEX_MASK(total_size);
     ringbuf->buffer = buffer;
+    ringbuf->mirror = 0;
+    SIMPLE_RINGBUFFER_STORE_RELAXED(ringbuf->write_index, 0);
+    SIMPLE_RINGBUFFER_STORE_RELAXED(ringbuf->read_index, 0);
+    SIMPLE_RINGBUFFER_STORE_RELAXED(ringbuf->overwritten, 0);
+#if SIMPLE_RINGBUFFER_SPSC
+    ringbuf->write_index_cache = 0;
+    ringbuf->read_index_cache = 0;
+#endif
+#if SIMPLE_RINGBUFFER_STATS
+    simple_ringbuffer_stats_clear(&ringbuf->put_stats, &ringbuf->get_stats);
+#endif
 }
 
 /**
@@ -64,7 +118,8 @@ static inline void simple_ringbuffer_init(simple_ringbuffer_t *ringbuf, uint32_t
  */
 static inline int simple_ringbuffer_is_empty(simple_ringbuffer_t *ringbuf)
 {
-    return ringbuf->read_index == ringbuf->write_index;
+    return SIMPLE_RINGBUFFER_LOAD_ACQUIRE(ringbuf->read_index) ==
+           SIMPLE_RINGBUFFER_LOAD_ACQUIRE(ringbuf->write_index);
 }
 
 /**
@@ -74,9 +129,11 @@ static inline int simple_ringbuffer_is_empty(simple_ringbuffer_t *ringbuf)
  */
 static inline uint32_t simple_ringbuffer_size(simple_ringbuffer_t *ringbuf)
 {
-    return ringbuf->write_index >= ringbuf->read_index
-                   ? ringbuf->write_index - ringbuf->read_index
-                   : (ringbuf->total_size << 1) - (ringbuf->read_index - ringbuf->write_index);
+    uint32_t read_index = SIMPLE_RINGBUFFER_LOAD_ACQUIRE(ringbuf->read_index);
+    uint32_t write_index = SIMPLE_RINGBUFFER_LOAD_ACQUIRE(ringbuf->write_index);
+
+    return write_index >= read_index ? write_index - read_index
+                                     : (ringbuf->total_size << 1) - (read_index - write_index);
 }
 
 /**
@@ -104,6 +161,8 @@ static inline int simple_ringbuffer_is_full(simple_ringbuffer_t *ringbuf)
  * @param  [in] buffer: The buffer to be put into the RINGBUF.
  * @param  [in] len: The length of the buffer.
  * @return The length of the buffer put into the RINGBUF.
+ * @details From SIMPLE_RINGBUFFER_STREAM_SIZE bytes on, the copy into the RINGBUF storage uses
+ *   non-temporal stores.
  */
 uint32_t simple_ringbuffer_put(simple_ringbuffer_t *ringbuf, uint8_t *buffer, uint32_t len);
 
@@ -113,7 +172,180 @@ uint32_t simple_ringbuffer_put(simple_ringbuffer_t *ringbuf, uint8_t *buffer, ui
  * @param  [in] buffer: The buffer to be put into the RINGBUF.
  * @param  [in] len: The length of the buffer.
  * @return The length of the buffer get from the RINGBUF.
+ * @details From SIMPLE_RINGBUFFER_STREAM_SIZE bytes on, the copy into buffer uses non-temporal
+ *   stores.
  */
 uint32_t simple_ringbuffer_get(simple_ringbuffer_t *ringbuf, uint8_t *buffer, uint32_t len);
 
+/**
+ * @brief   Put the pieces of a message into the RINGBUF as one unit (gather).
+ * @details All or nothing: when the free space is less than the sum of the pieces nothing is
+ *   put. write_index is published once after the last piece, the consumer never sees part of
+ *   the message.
+ * @param   [in] ringbuf: The ringbuf to be used.
+ * @param   [in] iov: The pieces, in order, e.g. header, body and trailer.
+ * @param   [in] iovcnt: The number of pieces.
+ * @return  The sum of the piece lengths, 0 if it does not fit.
+ */
+uint32_t simple_ringbuffer_putv(simple_ringbuffer_t *ringbuf, const simple_ringbuffer_span_t *iov,
+                                uint32_t iovcnt);
+
+/**
+ * @brief   Get a message from the RINGBUF into several buffers as one unit (scatter).
+ * @details All or nothing: when the RINGBUF holds less than the sum of the buffer lengths
+ *   nothing is taken. read_index is published once after the last buffer.
+ * @param   [in] ringbuf: The ringbuf to be used.
+ * @param   [in] iov: The buffers, filled in order.
+ * @param   [in] iovcnt: The number of buffers.
+ * @return  The sum of the buffer lengths, 0 if the RINGBUF does not hold that much.
+ */
+uint32_t simple_ringbuffer_getv(simple_ringbuffer_t *ringbuf, const simple_ringbuffer_span_t *iov,
+                                uint32_t iovcnt);
+
+/**
+ * @brief   Put data into the RINGBUF, overwriting the oldest data when there is no room.
+ * @details Overwrite (lossy) mode, the newest data is kept and a slow consumer falls behind:
+ *   the producer moves read_index forward itself. Only the last total_size bytes of a longer
+ *   buffer are kept. In SPSC mode the consumer must then use simple_ringbuffer_get_overwrite().
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @param  [in] buffer: The buffer to be put into the RINGBUF.
+ * @param  [in] len: The length of the buffer.
+ * @return The number of bytes dropped, the oldest of the RINGBUF first.
+ */
+uint32_t simple_ringbuffer_put_overwrite(simple_ringbuffer_t *ringbuf, uint8_t *buffer,
+                                         uint32_t len);
+
+/**
+ * @brief   Get data from a RINGBUF fed by simple_ringbuffer_put_overwrite().
+ * @details When the producer overwrote the data while it was copied, the consumer was lapped:
+ *   the copy is dropped and done again from the new oldest data, so no torn data is returned.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @param  [in] buffer: The destination buffer.
+ * @param  [in] len: The length of the buffer.
+ * @return The length get from the RINGBUF.
+ */
+uint32_t simple_ringbuffer_get_overwrite(simple_ringbuffer_t *ringbuf, uint8_t *buffer,
+                                         uint32_t len);
+
+/**
+ * @brief  Returns the number of bytes dropped by simple_ringbuffer_put_overwrite() since init.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @return The number of bytes overwritten, wraps at 2^32.
+ */
+static inline uint32_t simple_ringbuffer_overwritten(simple_ringbuffer_t *ringbuf)
+{
+    return SIMPLE_RINGBUFFER_LOAD_ACQUIRE(ringbuf->overwritten);
+}
+
+#if SIMPLE_RINGBUFFER_STATS
+/**
+ * @brief  Take a snapshot of the counters of the RINGBUF, 'make STATS=1'.
+ * @details May be called from any thread. The counters are not updated together, a snapshot
+ *   taken while the RINGBUF is used may miss the operations in flight. high_water is in bytes.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @param  [out] stats: The counters since init or reset.
+ */
+static inline void simple_ringbuffer_stats_snapshot(simple_ringbuffer_t *ringbuf,
+                                                    simple_ringbuffer_stats_t *stats)
+{
+    simple_ringbuffer_stats_load(&ringbuf->put_stats, &ringbuf->get_stats, stats);
+}
+#endif
+
+/**
+ * @brief   Reserve the free space of the RINGBUF, to be written in place.
+ * @details Producer side, zero copy.
+ *   The free space is returned as up to two spans: span[0] from the write position to the end
+ *   of buffer (or to the end of the free space), span[1] from the start of buffer, span[1].len
+ *   is 0 when the free space does not wrap. Nothing is visible to the consumer until
+ *   simple_ringbuffer_commit() is called.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @param  [out] span: The two writable spans.
+ * @return The total free length, span[0].len + span[1].len.
+ */
+uint32_t simple_ringbuffer_reserve(simple_ringbuffer_t *ringbuf, simple_ringbuffer_span_t span[2]);
+
+/**
+ * @brief  Publish len bytes written to the spans returned by simple_ringbuffer_reserve().
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @param  [in] len: The length to publish, span[0] first, at most the reserved length.
+ */
+void simple_ringbuffer_commit(simple_ringbuffer_t *ringbuf, uint32_t len);
+
+/**
+ * @brief   Peek the data of the RINGBUF in place.
+ * @details Consumer side, zero copy.
+ *   The data is returned as up to two spans: span[0] from the read position, span[1] from the
+ *   start of buffer, span[1].len is 0 when the data does not wrap.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @param  [out] span: The two readable spans.
+ * @return The total readable length, span[0].len + span[1].len.
+ */
+uint32_t simple_ringbuffer_peek(simple_ringbuffer_t *ringbuf, simple_ringbuffer_span_t span[2]);
+
+/**
+ * @brief  Release len bytes of the data returned by simple_ringbuffer_peek().
+ * @details len may be less than the peeked length, the rest stays in the RINGBUF.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @param  [in] len: The length to release, span[0] first, at most the peeked length.
+ */
+void simple_ringbuffer_consume(simple_ringbuffer_t *ringbuf, uint32_t len);
+
+#if defined(__linux__)
+/**
+ * @brief   Initialize a mirrored RINGBUF, the storage is mapped twice back-to-back.
+ * @details
+ *   The same physical pages (a memfd) are mapped at buffer and at buffer + total_size, so any
+ *   readable or writable region of the RINGBUF is one contiguous pointer, put/get copy in one
+ *   go and decoders can work directly on the RINGBUF memory, see simple_ringbuffer_mirror_peek()
+ *   and simple_ringbuffer_mirror_reserve().
+ *   Linux only, release it with simple_ringbuffer_deinit_mirror().
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @param  [in] total_size: The total size of the RINGBUF, rounded up to the page size, at most
+ *                          2 GB.
+ * @return 0 on success, -1 on failure (errno is set).
+ */
+int simple_ringbuffer_init_mirror(simple_ringbuffer_t *ringbuf, uint32_t total_size);
+
+/**
+ * @brief  Release the mapping of a RINGBUF set up by simple_ringbuffer_init_mirror().
+ * @param  [in] ringbuf: The ringbuf to be used.
+ */
+void simple_ringbuffer_deinit_mirror(simple_ringbuffer_t *ringbuf);
+#endif
+
+/**
+ * @brief  Peek the readable region of a mirrored RINGBUF, without copy.
+ * @details Consumer side. On a RINGBUF which is not mirrored, only the part up to the end of
+ *   buffer is returned.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @param  [out] len: The length of the readable region.
+ * @return The start of the readable region.
+ */
+uint8_t *simple_ringbuffer_mirror_peek(simple_ringbuffer_t *ringbuf, uint32_t *len);
+
+/**
+ * @brief  Release len bytes of the region returned by simple_ringbuffer_mirror_peek().
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @param  [in] len: The length to release, at most the length returned by the peek.
+ */
+void simple_ringbuffer_mirror_consume(simple_ringbuffer_t *ringbuf, uint32_t len);
+
+/**
+ * @brief  Reserve the writable region of a mirrored RINGBUF, to be filled in place.
+ * @details Producer side. On a RINGBUF which is not mirrored, only the part up to the end of
+ *   buffer is returned.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @param  [out] len: The length of the writable region.
+ * @return The start of the writable region.
+ */
+uint8_t *simple_ringbuffer_mirror_reserve(simple_ringbuffer_t *ringbuf, uint32_t *len);
+
+/**
+ * @brief  Publish len bytes written to the region returned by simple_ringbuffer_mirror_reserve().
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @param  [in] len: The length to publish, at most the length returned by the reserve.
+ */
+void simple_ringbuffer_mirror_commit(simple_ringbuffer_t *ringbuf, uint32_t len);
+
 #endif /* _SIMPLE_RINGBUFFER_H_ */
\ No newline at end of file
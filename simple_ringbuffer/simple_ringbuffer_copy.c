@@ -0,0 +1,319 @@
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "simple_ringbuffer_copy.h"
+
+/* above this the kernels hand over to memcpy() */
+#define RINGBUFFER_COPY_VECTOR_MAX 512
+
+typedef struct ringbuffer_copy_kernel
+{
+    const char *name;
+    simple_ringbuffer_copy_t copy;
+    int (*supported)(void);
+} ringbuffer_copy_kernel_t;
+
+static void ringbuffer_copy_memcpy(uint8_t *dst, const uint8_t *src, uint8_t *dst2,
+                                   const uint8_t *src2, uint32_t l, uint32_t len)
+{
+    memcpy(dst, src, l);
+    if (len != l)
+    {
+        memcpy(dst2, src2, len - l);
+    }
+}
+
+static int ringbuffer_copy_always(void)
+{
+    return 1;
+}
+
+#if SIMPLE_RINGBUFFER_COPY_DISPATCH
+
+/**
+ * @brief  Copy less than 16 bytes, two overlapping loads and stores of the biggest word which
+ *         fits.
+ */
+static inline __attribute__((always_inline)) void ringbuffer_copy_small(uint8_t *dst,
+                                                                        const uint8_t *src,
+                                                                        uint32_t len)
+{
+    if (len >= 8)
+    {
+        uint64_t head, tail;
+
+        memcpy(&head, src, 8);
+        memcpy(&tail, src + len - 8, 8);
+        memcpy(dst, &head, 8);
+        memcpy(dst + len - 8, &tail, 8);
+    }
+    else if (len >= 4)
+    {
+        uint32_t head, tail;
+
+        memcpy(&head, src, 4);
+        memcpy(&tail, src + len - 4, 4);
+        memcpy(dst, &head, 4);
+        memcpy(dst + len - 4, &tail, 4);
+    }
+    else if (len != 0)
+    {
+        /* 1 to 3 bytes */
+        dst[0] = src[0];
+        dst[len >> 1] = src[len >> 1];
+        dst[len - 1] = src[len - 1];
+    }
+}
+
+/*
+ * Each kernel copies a segment with whole vectors and one last vector ending at the end of the
+ * segment, which may overlap the one before. No alignment prologue, the buffers of a RINGBUF
+ * are rarely aligned and unaligned vector accesses cost the same on the cores which have them.
+ */
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+
+#define RINGBUFFER_COPY_X86(_isa) __attribute__((target(_isa)))
+
+static inline __attribute__((always_inline)) RINGBUFFER_COPY_X86("sse2") void
+ringbuffer_copy_sse2_segment(uint8_t *dst, const uint8_t *src, uint32_t len)
+{
+    if (len < 16)
+    {
+        ringbuffer_copy_small(dst, src, len);
+        return;
+    }
+    if (len > RINGBUFFER_COPY_VECTOR_MAX)
+    {
+        memcpy(dst, src, len);
+        return;
+    }
+    for (uint32_t i = 0; i + 16 < len; i += 16)
+    {
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_loadu_si128((const __m128i *)(src + i)));
+    }
+    _mm_storeu_si128((__m128i *)(dst + len - 16),
+                     _mm_loadu_si128((const __m128i *)(src + len - 16)));
+}
+
+static RINGBUFFER_COPY_X86("sse2") void ringbuffer_copy_sse2(uint8_t *dst, const uint8_t *src,
+                                                             uint8_t *dst2, const uint8_t *src2,
+                                                             uint32_t l, uint32_t len)
+{
+    ringbuffer_copy_sse2_segment(dst, src, l);
+    if (len != l)
+    {
+        ringbuffer_copy_sse2_segment(dst2, src2, len - l);
+    }
+}
+
+static int ringbuffer_copy_sse2_supported(void)
+{
+    return __builtin_cpu_supports("sse2");
+}
+
+static inline __attribute__((always_inline)) RINGBUFFER_COPY_X86("avx2") void
+ringbuffer_copy_avx2_segment(uint8_t *dst, const uint8_t *src, uint32_t len)
+{
+    if (len < 32)
+    {
+        if (len < 16)
+        {
+            ringbuffer_copy_small(dst, src, len);
+            return;
+        }
+        __m128i head = _mm_loadu_si128((const __m128i *)src);
+        __m128i tail = _mm_loadu_si128((const __m128i *)(src + len - 16));
+        _mm_storeu_si128((__m128i *)dst, head);
+        _mm_storeu_si128((__m128i *)(dst + len - 16), tail);
+        return;
+    }
+    if (len > RINGBUFFER_COPY_VECTOR_MAX)
+    {
+        memcpy(dst, src, len);
+        return;
+    }
+    for (uint32_t i = 0; i + 32 < len; i += 32)
+    {
+        _mm256_storeu_si256((__m256i *)(dst + i),
+                            _mm256_loadu_si256((const __m256i *)(src + i)));
+    }
+    _mm256_storeu_si256((__m256i *)(dst + len - 32),
+                        _mm256_loadu_si256((const __m256i *)(src + len - 32)));
+}
+
+static RINGBUFFER_COPY_X86("avx2") void ringbuffer_copy_avx2(uint8_t *dst, const uint8_t *src,
+                                                             uint8_t *dst2, const uint8_t *src2,
+                                                             uint32_t l, uint32_t len)
+{
+    ringbuffer_copy_avx2_segment(dst, src, l);
+    if (len != l)
+    {
+        ringbuffer_copy_avx2_segment(dst2, src2, len - l);
+    }
+}
+
+static int ringbuffer_copy_avx2_supported(void)
+{
+    return __builtin_cpu_supports("avx2");
+}
+
+static inline __attribute__((always_inline)) RINGBUFFER_COPY_X86("avx512f") void
+ringbuffer_copy_avx512_segment(uint8_t *dst, const uint8_t *src, uint32_t len)
+{
+    if (len < 64)
+    {
+        /* masked byte stores cost more than two overlapping ymm or xmm ones */
+        ringbuffer_copy_avx2_segment(dst, src, len);
+        return;
+    }
+    if (len > RINGBUFFER_COPY_VECTOR_MAX)
+    {
+        memcpy(dst, src, len);
+        return;
+    }
+    for (uint32_t i = 0; i + 64 < len; i += 64)
+    {
+        _mm512_storeu_si512((void *)(dst + i), _mm512_loadu_si512((const void *)(src + i)));
+    }
+    _mm512_storeu_si512((void *)(dst + len - 64),
+                        _mm512_loadu_si512((const void *)(src + len - 64)));
+}
+
+static RINGBUFFER_COPY_X86("avx512f") void
+ringbuffer_copy_avx512(uint8_t *dst, const uint8_t *src, uint8_t *dst2, const uint8_t *src2,
+                       uint32_t l, uint32_t len)
+{
+    ringbuffer_copy_avx512_segment(dst, src, l);
+    if (len != l)
+    {
+        ringbuffer_copy_avx512_segment(dst2, src2, len - l);
+    }
+}
+
+static int ringbuffer_copy_avx512_supported(void)
+{
+    return __builtin_cpu_supports("avx512f");
+}
+#endif
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+
+static inline __attribute__((always_inline)) void
+ringbuffer_copy_neon_segment(uint8_t *dst, const uint8_t *src, uint32_t len)
+{
+    if (len < 16)
+    {
+        ringbuffer_copy_small(dst, src, len);
+        return;
+    }
+    if (len > RINGBUFFER_COPY_VECTOR_MAX)
+    {
+        memcpy(dst, src, len);
+        return;
+    }
+    for (uint32_t i = 0; i + 16 < len; i += 16)
+    {
+        vst1q_u8(dst + i, vld1q_u8(src + i));
+    }
+    vst1q_u8(dst + len - 16, vld1q_u8(src + len - 16));
+}
+
+static void ringbuffer_copy_neon(uint8_t *dst, const uint8_t *src, uint8_t *dst2,
+                                 const uint8_t *src2, uint32_t l, uint32_t len)
+{
+    ringbuffer_copy_neon_segment(dst, src, l);
+    if (len != l)
+    {
+        ringbuffer_copy_neon_segment(dst2, src2, len - l);
+    }
+}
+#endif
+
+#endif /* SIMPLE_RINGBUFFER_COPY_DISPATCH */
+
+/* best first, NEON is part of every ARM64 core */
+static const ringbuffer_copy_kernel_t ringbuffer_copy_kernels[] = {
+#if SIMPLE_RINGBUFFER_COPY_DISPATCH && (defined(__x86_64__) || defined(__i386__))
+        {"avx512", ringbuffer_copy_avx512, ringbuffer_copy_avx512_supported},
+        {"avx2", ringbuffer_copy_avx2, ringbuffer_copy_avx2_supported},
+        {"sse2", ringbuffer_copy_sse2, ringbuffer_copy_sse2_supported},
+#endif
+#if SIMPLE_RINGBUFFER_COPY_DISPATCH && defined(__aarch64__)
+        {"neon", ringbuffer_copy_neon, ringbuffer_copy_always},
+#endif
+        {"memcpy", ringbuffer_copy_memcpy, ringbuffer_copy_always},
+};
+
+#define RINGBUFFER_COPY_KERNEL_CNT                                                                 \
+    (sizeof(ringbuffer_copy_kernels) / sizeof(ringbuffer_copy_kernels[0]))
+
+#if SIMPLE_RINGBUFFER_COPY_DISPATCH
+/* only for copies made by other constructors, before ringbuffer_copy_init() ran */
+static void ringbuffer_copy_resolve(uint8_t *dst, const uint8_t *src, uint8_t *dst2,
+                                    const uint8_t *src2, uint32_t l, uint32_t len)
+{
+    simple_ringbuffer_copy_select(NULL);
+    simple_ringbuffer_copy(dst, src, dst2, src2, l, len);
+}
+
+_Atomic(simple_ringbuffer_copy_t) simple_ringbuffer_copy_kernel = ringbuffer_copy_resolve;
+
+/**
+ * @brief  Pick the kernel once at startup, the put/get paths never resolve it.
+ */
+__attribute__((constructor)) static void ringbuffer_copy_init(void)
+{
+    simple_ringbuffer_copy_select(NULL);
+}
+#endif
+
+int simple_ringbuffer_copy_select(const char *name)
+{
+#if SIMPLE_RINGBUFFER_COPY_DISPATCH && (defined(__x86_64__) || defined(__i386__))
+    /* may run before the libgcc constructor which fills the CPU model */
+    __builtin_cpu_init();
+#endif
+    for (uint32_t i = 0; i < RINGBUFFER_COPY_KERNEL_CNT; i++)
+    {
+        const ringbuffer_copy_kernel_t *kernel = &ringbuffer_copy_kernels[i];
+
+        if ((name == NULL || strcmp(name, kernel->name) == 0) && kernel->supported())
+        {
+#if SIMPLE_RINGBUFFER_COPY_DISPATCH
+            atomic_store_explicit(&simple_ringbuffer_copy_kernel, kernel->copy,
+                                  memory_order_relaxed);
+#endif
+            return 0;
+        }
+    }
+
+    errno = ENOTSUP;
+    return -1;
+}
+
+const char *simple_ringbuffer_copy_name(void)
+{
+#if SIMPLE_RINGBUFFER_COPY_DISPATCH
+    simple_ringbuffer_copy_t copy =
+            atomic_load_explicit(&simple_ringbuffer_copy_kernel, memory_order_relaxed);
+
+    if (copy == ringbuffer_copy_resolve)
+    {
+        simple_ringbuffer_copy_select(NULL);
+        copy = atomic_load_explicit(&simple_ringbuffer_copy_kernel, memory_order_relaxed);
+    }
+    for (uint32_t i = 0; i < RINGBUFFER_COPY_KERNEL_CNT; i++)
+    {
+        if (ringbuffer_copy_kernels[i].copy == copy)
+        {
+            return ringbuffer_copy_kernels[i].name;
+        }
+    }
+#endif
+
+    return "memcpy";
+}
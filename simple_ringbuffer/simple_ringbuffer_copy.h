@@ -0,0 +1,59 @@
+#ifndef _SIMPLE_RINGBUFFER_COPY_H_
+#define _SIMPLE_RINGBUFFER_COPY_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#include "simple_ringbuffer_port.h"
+
+/**
+ * @brief   A copy kernel: len bytes, the first l from src to dst, the rest from src2 to dst2.
+ * @details The two segments of a copy across the end of a RINGBUF storage are one call, l == len
+ *   when the copy does not wrap (dst2 and src2 are not used then). The buffers do not overlap.
+ *   Sizes up to a few hundred bytes run in vector registers without any loop setup, bigger ones
+ *   go to memcpy(), libc does better there.
+ */
+typedef void (*simple_ringbuffer_copy_t)(uint8_t *dst, const uint8_t *src, uint8_t *dst2,
+                                         const uint8_t *src2, uint32_t l, uint32_t len);
+
+#if SIMPLE_RINGBUFFER_COPY_DISPATCH
+#include <stdatomic.h>
+
+/* the selected kernel, set at startup by a constructor */
+extern _Atomic(simple_ringbuffer_copy_t) simple_ringbuffer_copy_kernel;
+#endif
+
+/**
+ * @brief  Copy with the selected kernel, see simple_ringbuffer_copy_t.
+ */
+static inline void simple_ringbuffer_copy(uint8_t *dst, const uint8_t *src, uint8_t *dst2,
+                                          const uint8_t *src2, uint32_t l, uint32_t len)
+{
+#if SIMPLE_RINGBUFFER_COPY_DISPATCH
+    atomic_load_explicit(&simple_ringbuffer_copy_kernel, memory_order_relaxed)(dst, src, dst2,
+                                                                               src2, l, len);
+#else
+    memcpy(dst, src, l);
+    /* dst2 and src2 may be NULL when the copy does not wrap */
+    if (len != l)
+    {
+        memcpy(dst2, src2, len - l);
+    }
+#endif
+}
+
+/**
+ * @brief  Select a copy kernel, for all the RINGBUFs.
+ * @param  [in] name: "avx512", "avx2", "sse2", "neon" or "memcpy", NULL for the best one the CPU
+ *   supports, what the startup does by itself. Call it before the RINGBUFs are in use.
+ * @return 0 on success, -1 with errno set to ENOTSUP if the kernel is not built in or the CPU
+ *   does not support it.
+ */
+int simple_ringbuffer_copy_select(const char *name);
+
+/**
+ * @brief  Name of the selected copy kernel.
+ */
+const char *simple_ringbuffer_copy_name(void);
+
+#endif /* _SIMPLE_RINGBUFFER_COPY_H_ */
@@ -0,0 +1,165 @@
+#ifndef _SIMPLE_RINGBUFFER_INTERNAL_H_
+#define _SIMPLE_RINGBUFFER_INTERNAL_H_
+
+/*
+ * Index arithmetic and copy helpers shared by the byte RINGBUFs, simple_ringbuffer.c and
+ * simple_shm_ringbuffer.c. Not part of the API.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "simple_ringbuffer_copy.h"
+#include "simple_ringbuffer_port.h"
+
+#ifndef MIN
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#endif
+
+/*
+ * _mask is the index_mask of the RINGBUF, 2 * total_size - 1 for a power of 2 size and 0
+ * otherwise. With a power of 2 size the index wraps with a mask instead of compare and subtract,
+ * the index values are the same in both cases.
+ */
+#define RINGBUFFER_INDEX_TO_PTR(_index, _total_size, _mask)                                        \
+    ((_mask) ? ((_index) & ((_mask) >> 1))                                                         \
+             : ((_index >= _total_size) ? (_index - _total_size) : (_index)))
+
+#define RINGBUFFER_USED_SIZE(_write_index, _read_index, _total_size, _mask)                        \
+    ((_mask) ? ((_write_index - _read_index) & (_mask))                                            \
+     : (_write_index >= _read_index) ? (_write_index - _read_index)                                \
+                                     : ((_total_size << 1) - (_read_index - _write_index)))
+
+#if SIMPLE_RINGBUFFER_STREAM_SIZE && defined(__SSE2__)
+#include <emmintrin.h>
+
+/**
+ * @brief  memcpy() with non-temporal stores, dst lines are written around the caches.
+ * @details The stores are weakly ordered, ringbuffer_stream_fence() must follow before the
+ *   data is published.
+ */
+static inline void ringbuffer_stream_copy(uint8_t *dst, const uint8_t *src, uint32_t len)
+{
+    /* plain copy up to the first 16 byte aligned dst */
+    uint32_t head = MIN(len, (uint32_t)(-(uintptr_t)dst & 15));
+
+    memcpy(dst, src, head);
+    dst += head;
+    src += head;
+    len -= head;
+
+    for (; len >= 64; len -= 64, dst += 64, src += 64)
+    {
+        __m128i a = _mm_loadu_si128((const __m128i *)src);
+        __m128i b = _mm_loadu_si128((const __m128i *)(src + 16));
+        __m128i c = _mm_loadu_si128((const __m128i *)(src + 32));
+        __m128i d = _mm_loadu_si128((const __m128i *)(src + 48));
+
+        _mm_stream_si128((__m128i *)dst, a);
+        _mm_stream_si128((__m128i *)(dst + 16), b);
+        _mm_stream_si128((__m128i *)(dst + 32), c);
+        _mm_stream_si128((__m128i *)(dst + 48), d);
+    }
+    for (; len >= 16; len -= 16, dst += 16, src += 16)
+    {
+        _mm_stream_si128((__m128i *)dst, _mm_loadu_si128((const __m128i *)src));
+    }
+    memcpy(dst, src, len);
+}
+
+static inline void ringbuffer_stream_fence(void)
+{
+    _mm_sfence();
+}
+#else
+#define ringbuffer_stream_copy(_dst, _src, _len) memcpy(_dst, _src, _len)
+#define ringbuffer_stream_fence()                ((void)0)
+#endif
+
+/**
+ * @brief  Copy the two segments of a put or get, see simple_ringbuffer_copy_t. Streamed from
+ *         SIMPLE_RINGBUFFER_STREAM_SIZE bytes on, with the copy kernel below that.
+ */
+static inline void ringbuffer_copy(uint8_t *dst, const uint8_t *src, uint8_t *dst2,
+                                   const uint8_t *src2, uint32_t l, uint32_t len)
+{
+    if (SIMPLE_RINGBUFFER_STREAM_SIZE && len >= SIMPLE_RINGBUFFER_STREAM_SIZE)
+    {
+        ringbuffer_stream_copy(dst, src, l);
+        if (len != l)
+        {
+            ringbuffer_stream_copy(dst2, src2, len - l);
+        }
+        /* non-temporal stores are not ordered by a release store, even on x86 */
+        ringbuffer_stream_fence();
+        return;
+    }
+    simple_ringbuffer_copy(dst, src, dst2, src2, l, len);
+}
+
+/**
+ * @brief  Move an index len bytes forward, in [0, 2 * total_size).
+ */
+static inline uint32_t ringbuffer_index_add(uint32_t index, uint32_t len, uint32_t total_size,
+                                            uint32_t mask)
+{
+    index += len;
+    if (mask)
+    {
+        index &= mask;
+    }
+    else if (index >= (total_size << 1))
+    {
+        index -= (total_size << 1);
+    }
+
+    return index;
+}
+
+#ifndef __STDC_NO_ATOMICS__
+#include <stdatomic.h>
+
+/**
+ * @brief  Producer side view of a shared read_index.
+ * @details The producer works on its own copy of read_index, *cache, and only loads the
+ *   consumer cache line again when that copy does not leave room for len bytes.
+ */
+static inline uint32_t ringbuffer_cached_read_index(_Atomic uint32_t *read_index,
+                                                    uint32_t *cache, uint32_t write_index,
+                                                    uint32_t len, uint32_t total_size,
+                                                    uint32_t mask)
+{
+    uint32_t index = *cache;
+
+    if (total_size - RINGBUFFER_USED_SIZE(write_index, index, total_size, mask) < len)
+    {
+        index = atomic_load_explicit(read_index, memory_order_acquire);
+        *cache = index;
+    }
+
+    return index;
+}
+
+/**
+ * @brief  Consumer side view of a shared write_index.
+ * @details The consumer works on its own copy of write_index, *cache, and only loads the
+ *   producer cache line again when that copy does not hold len bytes.
+ */
+static inline uint32_t ringbuffer_cached_write_index(_Atomic uint32_t *write_index,
+                                                     uint32_t *cache, uint32_t read_index,
+                                                     uint32_t len, uint32_t total_size,
+                                                     uint32_t mask)
+{
+    uint32_t index = *cache;
+
+    if (RINGBUFFER_USED_SIZE(index, read_index, total_size, mask) < len)
+    {
+        index = atomic_load_explicit(write_index, memory_order_acquire);
+        *cache = index;
+    }
+
+    return index;
+}
+#endif
+
+#endif /* _SIMPLE_RINGBUFFER_INTERNAL_H_ */
@@ -0,0 +1,68 @@
+#if defined(__linux__)
+/* memfd_create() */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <errno.h>
+#include <stdint.h>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "simple_ringbuffer.h"
+
+int simple_ringbuffer_init_mirror(simple_ringbuffer_t *ringbuf, uint32_t total_size)
+{
+    size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+    size_t size = ((size_t)total_size + page_size - 1) / page_size * page_size;
+    uint8_t *base;
+    int fd;
+
+    /* indices run up to 2 * total_size */
+    if (total_size == 0 || size > 0x80000000u)
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    fd = memfd_create("simple_ringbuffer", MFD_CLOEXEC);
+    if (fd < 0)
+    {
+        return -1;
+    }
+    /* reserve twice the size, then map the same pages in both halves */
+    base = ftruncate(fd, (off_t)size) == 0
+                   ? mmap(NULL, size << 1, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)
+                   : MAP_FAILED;
+    if (base != MAP_FAILED &&
+        (mmap(base, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED ||
+         mmap(base + size, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) ==
+                 MAP_FAILED))
+    {
+        munmap(base, size << 1);
+        base = MAP_FAILED;
+    }
+    /* the mappings keep the pages alive */
+    close(fd);
+    if (base == MAP_FAILED)
+    {
+        return -1;
+    }
+
+    simple_ringbuffer_init(ringbuf, (uint32_t)size, base);
+    ringbuf->mirror = 1;
+
+    return 0;
+}
+
+void simple_ringbuffer_deinit_mirror(simple_ringbuffer_t *ringbuf)
+{
+    if (ringbuf->mirror)
+    {
+        munmap(ringbuf->buffer, (size_t)ringbuf->total_size << 1);
+        ringbuf->buffer = NULL;
+        ringbuf->mirror = 0;
+    }
+}
+#endif
@@ -0,0 +1,171 @@
+#if defined(__linux__)
+#include <errno.h>
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "simple_ringbuffer_notify.h"
+
+/**
+ * @brief  Ask the other side for the next edge.
+ * @details Called when a RINGBUF was found empty (consumer) or full (producer), the caller must
+ *   retry once afterwards. Pending readiness is dropped first, it belongs to an edge already
+ *   handled. The fence orders the armed store before the index load of the retry, and pairs
+ *   with the fence in ringbuffer_notify_signal(): either the retry sees the progress, or the
+ *   other side sees the edge armed and writes the eventfd.
+ */
+static void ringbuffer_notify_arm(simple_ringbuffer_signal_t *signal)
+{
+    uint64_t cnt;
+
+    (void)read(signal->fd, &cnt, sizeof(cnt));
+    atomic_store_explicit(&signal->armed, 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+}
+
+/**
+ * @brief  Take back an edge armed by ringbuffer_notify_arm(), the retry was successful.
+ * @details If the other side already took it, its eventfd write is a spurious readiness.
+ */
+static void ringbuffer_notify_disarm(simple_ringbuffer_signal_t *signal)
+{
+    atomic_exchange_explicit(&signal->armed, 0, memory_order_relaxed);
+}
+
+/**
+ * @brief  Signal the other side after progress, if it asked for it.
+ * @details Costs a fence and a load, the eventfd write is only made once per armed edge.
+ */
+static void ringbuffer_notify_signal(simple_ringbuffer_signal_t *signal)
+{
+    uint64_t one = 1;
+
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&signal->armed, memory_order_relaxed) != 0 &&
+        atomic_exchange_explicit(&signal->armed, 0, memory_order_relaxed) != 0)
+    {
+        (void)write(signal->fd, &one, sizeof(one));
+    }
+}
+
+int simple_ringbuffer_notifier_init(simple_ringbuffer_notifier_t *notifier)
+{
+    notifier->readable.fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (notifier->readable.fd < 0)
+    {
+        return -1;
+    }
+    notifier->writable.fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (notifier->writable.fd < 0)
+    {
+        int err = errno;
+        close(notifier->readable.fd);
+        errno = err;
+        return -1;
+    }
+
+    /* the consumer of an empty RINGBUF waits for the first put */
+    atomic_init(&notifier->readable.armed, 1);
+    atomic_init(&notifier->writable.armed, 0);
+
+    return 0;
+}
+
+void simple_ringbuffer_notifier_deinit(simple_ringbuffer_notifier_t *notifier)
+{
+    close(notifier->readable.fd);
+    close(notifier->writable.fd);
+    notifier->readable.fd = -1;
+    notifier->writable.fd = -1;
+}
+
+uint32_t simple_ringbuffer_put_notify(simple_ringbuffer_t *ringbuf,
+                                      simple_ringbuffer_notifier_t *notifier, uint8_t *buffer,
+                                      uint32_t len)
+{
+    uint32_t done = simple_ringbuffer_put(ringbuf, buffer, len);
+
+    if (done < len)
+    {
+        ringbuffer_notify_arm(&notifier->writable);
+        done += simple_ringbuffer_put(ringbuf, buffer + done, len - done);
+        if (done == len)
+        {
+            ringbuffer_notify_disarm(&notifier->writable);
+        }
+    }
+    if (done != 0)
+    {
+        ringbuffer_notify_signal(&notifier->readable);
+    }
+
+    return done;
+}
+
+uint32_t simple_ringbuffer_get_notify(simple_ringbuffer_t *ringbuf,
+                                      simple_ringbuffer_notifier_t *notifier, uint8_t *buffer,
+                                      uint32_t len)
+{
+    uint32_t done = simple_ringbuffer_get(ringbuf, buffer, len);
+
+    if (done < len)
+    {
+        ringbuffer_notify_arm(&notifier->readable);
+        done += simple_ringbuffer_get(ringbuf, buffer + done, len - done);
+        if (done == len)
+        {
+            ringbuffer_notify_disarm(&notifier->readable);
+        }
+    }
+    if (done != 0)
+    {
+        ringbuffer_notify_signal(&notifier->writable);
+    }
+
+    return done;
+}
+
+int simple_data_ringbuffer_put_notify(simple_data_ringbuffer_t *ringbuf,
+                                      simple_ringbuffer_notifier_t *notifier, void *buffer)
+{
+    int done = simple_data_ringbuffer_put(ringbuf, buffer);
+
+    if (done == 0)
+    {
+        ringbuffer_notify_arm(&notifier->writable);
+        done = simple_data_ringbuffer_put(ringbuf, buffer);
+        if (done != 0)
+        {
+            ringbuffer_notify_disarm(&notifier->writable);
+        }
+    }
+    if (done != 0)
+    {
+        ringbuffer_notify_signal(&notifier->readable);
+    }
+
+    return done;
+}
+
+int simple_data_ringbuffer_get_notify(simple_data_ringbuffer_t *ringbuf,
+                                      simple_ringbuffer_notifier_t *notifier, void *buffer)
+{
+    int done = simple_data_ringbuffer_get(ringbuf, buffer);
+
+    if (done == 0)
+    {
+        ringbuffer_notify_arm(&notifier->readable);
+        done = simple_data_ringbuffer_get(ringbuf, buffer);
+        if (done != 0)
+        {
+            ringbuffer_notify_disarm(&notifier->readable);
+        }
+    }
+    if (done != 0)
+    {
+        ringbuffer_notify_signal(&notifier->writable);
+    }
+
+    return done;
+}
+#endif
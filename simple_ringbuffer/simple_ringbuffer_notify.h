@@ -0,0 +1,99 @@
+#ifndef _SIMPLE_RINGBUFFER_NOTIFY_H_
+#define _SIMPLE_RINGBUFFER_NOTIFY_H_
+
+#if defined(__linux__)
+#include <stdint.h>
+#include <stdatomic.h>
+
+#include "simple_data_ringbuffer.h"
+#include "simple_ringbuffer.h"
+
+/**
+ * @brief   One readiness edge of a RINGBUF (readable / writable), backed by an eventfd.
+ */
+typedef struct simple_ringbuffer_signal
+{
+    SIMPLE_RINGBUFFER_CACHE_ALIGNED
+    atomic_uint armed; /* Set by the side which found the RINGBUF empty/full */
+    int fd;            /* Non-blocking eventfd, to be added to an epoll set */
+} simple_ringbuffer_signal_t;
+
+/**
+ * @brief   Readiness notification of one RINGBUF, shared by its producer and consumer.
+ * @details
+ *   The consumer polls readable.fd (EPOLLIN), it becomes readable when the RINGBUF goes from
+ *   empty to non-empty. The producer polls writable.fd (EPOLLIN as well), it becomes readable
+ *   when the RINGBUF goes from full to not full.
+ *   Signals are edge-coalesced: an edge is only armed when a _notify call finds the RINGBUF
+ *   empty (get) or full (put), and the other side makes at most one write() per armed edge,
+ *   so a producer feeding a consumer which keeps up makes one syscall per burst, not per put.
+ *   Both sides must go through the _notify calls and drain until they come up short before
+ *   going back to epoll_wait(). A readiness may be spurious, a get then simply returns 0.
+ *   Linux only, and two threads need the SIMPLE_RINGBUFFER_SPSC build.
+ */
+typedef struct simple_ringbuffer_notifier
+{
+    simple_ringbuffer_signal_t readable; /* Polled by the consumer */
+    simple_ringbuffer_signal_t writable; /* Polled by the producer */
+} simple_ringbuffer_notifier_t;
+
+/**
+ * @brief  Create the eventfds of a RINGBUF notifier.
+ * @details The RINGBUF is expected to be empty, the readable edge starts armed.
+ * @param  [in] notifier: The notifier to be used.
+ * @return 0 on success, -1 on failure (errno is set).
+ */
+int simple_ringbuffer_notifier_init(simple_ringbuffer_notifier_t *notifier);
+
+/**
+ * @brief  Close the eventfds of a RINGBUF notifier.
+ * @param  [in] notifier: The notifier to be used.
+ */
+void simple_ringbuffer_notifier_deinit(simple_ringbuffer_notifier_t *notifier);
+
+/**
+ * @brief  Put data into the RINGBUF, signal the consumer on the empty to non-empty edge.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @param  [in] notifier: The notifier of the RINGBUF.
+ * @param  [in] buffer: The buffer to be put into the RINGBUF.
+ * @param  [in] len: The length of the buffer.
+ * @return The length put into the RINGBUF, less than len arms the writable edge.
+ */
+uint32_t simple_ringbuffer_put_notify(simple_ringbuffer_t *ringbuf,
+                                      simple_ringbuffer_notifier_t *notifier, uint8_t *buffer,
+                                      uint32_t len);
+
+/**
+ * @brief  Get data from the RINGBUF, signal the producer on the full to not full edge.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @param  [in] notifier: The notifier of the RINGBUF.
+ * @param  [in] buffer: The destination buffer.
+ * @param  [in] len: The length of the buffer.
+ * @return The length get from the RINGBUF, less than len arms the readable edge.
+ */
+uint32_t simple_ringbuffer_get_notify(simple_ringbuffer_t *ringbuf,
+                                      simple_ringbuffer_notifier_t *notifier, uint8_t *buffer,
+                                      uint32_t len);
+
+/**
+ * @brief  Put an item into the RINGBUF, signal the consumer on the empty to non-empty edge.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @param  [in] notifier: The notifier of the RINGBUF.
+ * @param  [in] buffer: The item.
+ * @return 1 if the item was put, 0 if the RINGBUF is full (the writable edge is armed).
+ */
+int simple_data_ringbuffer_put_notify(simple_data_ringbuffer_t *ringbuf,
+                                      simple_ringbuffer_notifier_t *notifier, void *buffer);
+
+/**
+ * @brief  Get an item from the RINGBUF, signal the producer on the full to not full edge.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @param  [in] notifier: The notifier of the RINGBUF.
+ * @param  [in] buffer: The destination of the item, NULL to drop it.
+ * @return 1 if an item was get, 0 if the RINGBUF is empty (the readable edge is armed).
+ */
+int simple_data_ringbuffer_get_notify(simple_data_ringbuffer_t *ringbuf,
+                                      simple_ringbuffer_notifier_t *notifier, void *buffer);
+#endif
+
+#endif /* _SIMPLE_RINGBUFFER_NOTIFY_H_ */
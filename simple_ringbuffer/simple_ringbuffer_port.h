@@ -0,0 +1,220 @@
+#ifndef _SIMPLE_RINGBUFFER_PORT_H_
+#define _SIMPLE_RINGBUFFER_PORT_H_
+
+/**
+ * @brief   Build options shared by all the RINGBUF types.
+ * @details
+ *   SIMPLE_RINGBUFFER_SPSC = 0 (default):
+ *     Single thread (or one thread plus interrupt on a single core) use. read_index and
+ *     write_index are plain integers and are accessed without any memory ordering, this is the
+ *     zero-overhead path.
+ *   SIMPLE_RINGBUFFER_SPSC = 1:
+ *     One producer thread and one consumer thread, which may run on different cores.
+ *     read_index and write_index are C11 atomics, the producer publishes write_index with
+ *     release and the consumer observes it with acquire (and the other way around for
+ *     read_index). Producer owned and consumer owned fields are placed on separate cache lines,
+ *     so the two cores do not fight over one line.
+ *     Note: the RINGBUF struct is then cache line aligned, memory from malloc() may not respect
+ *     that, use aligned_alloc() or a static define instead.
+ */
+#ifndef SIMPLE_RINGBUFFER_SPSC
+#define SIMPLE_RINGBUFFER_SPSC 0
+#endif
+
+/**
+ * @brief   Per RINGBUF statistics, 'make STATS=1'.
+ * @details
+ *   SIMPLE_RINGBUFFER_STATS = 0 (default):
+ *     No counter in the RINGBUF struct and no code in the put/get paths.
+ *   SIMPLE_RINGBUFFER_STATS = 1:
+ *     simple_ringbuffer_t, simple_data_ringbuffer_t and the shm handle count what goes through
+ *     them, see simple_ringbuffer_stats_t. Each counter is owned by the producer or by the
+ *     consumer, on its own side of the struct, and is bumped with a plain load and store, no
+ *     atomic read-modify-write even in SPSC mode.
+ *     simple_mpmc_data_ringbuffer_t (and simple_mpmc_pool_t on top of it) has many threads on
+ *     each side, its counters are bumped with a relaxed atomic add.
+ */
+#ifndef SIMPLE_RINGBUFFER_STATS
+#define SIMPLE_RINGBUFFER_STATS 0
+#endif
+
+/**
+ * @brief   Streaming copy threshold of simple_ringbuffer_put()/get(), 'make STREAM=<bytes>'.
+ * @details
+ *   SIMPLE_RINGBUFFER_STREAM_SIZE = 0 (default):
+ *     Every copy is a memcpy().
+ *   SIMPLE_RINGBUFFER_STREAM_SIZE = n:
+ *     A put or get of at least n bytes copies with non-temporal stores, the destination (RINGBUF
+ *     storage for a put, the caller buffer for a get) is written around the caches instead of
+ *     evicting the working set. A store fence orders them before the index is published.
+ *     Meant for large transfers the other side will not touch for a while, a few hundred KB and
+ *     up, below that the consumer reading the data back from memory costs more than it saves.
+ *     Only x86 with SSE2 has the stores, other targets keep memcpy().
+ */
+#ifndef SIMPLE_RINGBUFFER_STREAM_SIZE
+#define SIMPLE_RINGBUFFER_STREAM_SIZE 0
+#endif
+
+/**
+ * @brief   SIMD copy kernels of simple_ringbuffer_t and simple_data_ringbuffer_t,
+ *          'make COPY_DISPATCH=1'.
+ * @details
+ *   SIMPLE_RINGBUFFER_COPY_DISPATCH = 0 (default):
+ *     The put/get copies are plain memcpy() calls, no indirect call in the path.
+ *   SIMPLE_RINGBUFFER_COPY_DISPATCH = 1 (GCC or clang):
+ *     The put/get copies go through a kernel picked once at startup, from a constructor, from
+ *     what the CPU supports: AVX-512, AVX2 or SSE2 on x86 (CPUID), NEON on ARM64. Each copy
+ *     then costs an indirect call, which pays off for small fixed size items. See
+ *     simple_ringbuffer_copy.h.
+ */
+#ifndef SIMPLE_RINGBUFFER_COPY_DISPATCH
+#define SIMPLE_RINGBUFFER_COPY_DISPATCH 0
+#endif
+
+#if SIMPLE_RINGBUFFER_COPY_DISPATCH && !defined(__GNUC__)
+#error "SIMPLE_RINGBUFFER_COPY_DISPATCH needs GCC or clang"
+#endif
+
+/**
+ * @brief   Cache line size used to separate producer and consumer fields in SPSC mode.
+ * @details Some ARM64 cores fetch lines in pairs, 128 can be used there.
+ */
+#ifndef SIMPLE_RINGBUFFER_CACHE_LINE_SIZE
+#define SIMPLE_RINGBUFFER_CACHE_LINE_SIZE 64
+#endif
+
+/**
+ * @brief   index_mask of a RINGBUF with _total_size items.
+ * @details 2 * _total_size - 1 when _total_size is a power of 2, the RINGBUF then wraps its
+ *   indices with a mask, 0 otherwise and the generic compare and subtract wrap is used.
+ *   The index values are in [0, 2 * _total_size) in both cases.
+ */
+#define SIMPLE_RINGBUFFER_INDEX_MASK(_total_size)                                                  \
+    (((_total_size) != 0 && ((_total_size) & ((_total_size) - 1)) == 0)                            \
+             ? (((uint32_t)(_total_size) << 1) - 1)                                                \
+             : 0)
+
+/**
+ * @brief   Hint to the CPU between two tries of a spin loop.
+ */
+#if defined(__x86_64__) || defined(__i386__)
+#define SIMPLE_RINGBUFFER_CPU_RELAX() __builtin_ia32_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+#define SIMPLE_RINGBUFFER_CPU_RELAX() __asm__ volatile("yield" ::: "memory")
+#else
+#define SIMPLE_RINGBUFFER_CPU_RELAX() ((void)0)
+#endif
+
+#if SIMPLE_RINGBUFFER_SPSC
+#include <stdatomic.h>
+
+#define SIMPLE_RINGBUFFER_ATOMIC(_type) _Atomic _type
+#define SIMPLE_RINGBUFFER_CACHE_ALIGNED _Alignas(SIMPLE_RINGBUFFER_CACHE_LINE_SIZE)
+
+#define SIMPLE_RINGBUFFER_LOAD_RELAXED(_obj) atomic_load_explicit(&(_obj), memory_order_relaxed)
+#define SIMPLE_RINGBUFFER_LOAD_ACQUIRE(_obj) atomic_load_explicit(&(_obj), memory_order_acquire)
+#define SIMPLE_RINGBUFFER_STORE_RELAXED(_obj, _val)                                                \
+    atomic_store_explicit(&(_obj), (_val), memory_order_relaxed)
+#define SIMPLE_RINGBUFFER_STORE_RELEASE(_obj, _val)                                                \
+    atomic_store_explicit(&(_obj), (_val), memory_order_release)
+#define SIMPLE_RINGBUFFER_CAS(_obj, _expected, _desired)                                           \
+    atomic_compare_exchange_strong_explicit(&(_obj), (_expected), (_desired),                      \
+                                            memory_order_acq_rel, memory_order_acquire)
+#define SIMPLE_RINGBUFFER_FENCE_ACQUIRE() atomic_thread_fence(memory_order_acquire)
+#define SIMPLE_RINGBUFFER_FENCE_RELEASE() atomic_thread_fence(memory_order_release)
+#else
+#define SIMPLE_RINGBUFFER_ATOMIC(_type) _type
+#define SIMPLE_RINGBUFFER_CACHE_ALIGNED
+
+#define SIMPLE_RINGBUFFER_LOAD_RELAXED(_obj)        (_obj)
+#define SIMPLE_RINGBUFFER_LOAD_ACQUIRE(_obj)        (_obj)
+#define SIMPLE_RINGBUFFER_STORE_RELAXED(_obj, _val) ((_obj) = (_val))
+#define SIMPLE_RINGBUFFER_STORE_RELEASE(_obj, _val) ((_obj) = (_val))
+#define SIMPLE_RINGBUFFER_CAS(_obj, _expected, _desired)                                           \
+    ((_obj) == *(_expected) ? ((_obj) = (_desired), 1) : (*(_expected) = (_obj), 0))
+#define SIMPLE_RINGBUFFER_FENCE_ACQUIRE() ((void)0)
+#define SIMPLE_RINGBUFFER_FENCE_RELEASE() ((void)0)
+#endif
+
+#if SIMPLE_RINGBUFFER_STATS
+#include <stdint.h>
+
+/**
+ * @brief   Counters of a RINGBUF, a snapshot filled by simple_ringbuffer_stats_snapshot(),
+ *          simple_data_ringbuffer_stats_snapshot() and the snapshot of the other RINGBUFs.
+ * @details An item is an item of a simple_data_ringbuffer_t, or a call which moved at least
+ *   one byte of a simple_ringbuffer_t.
+ */
+typedef struct simple_ringbuffer_stats
+{
+    uint64_t put_items;  /* Items put, enqueued or committed */
+    uint64_t put_bytes;  /* Bytes of the items put */
+    uint64_t put_full;   /* Puts which did not find room for everything, items or bytes dropped */
+    uint64_t get_items;  /* Items get, dequeued or consumed */
+    uint64_t get_bytes;  /* Bytes of the items get */
+    uint64_t get_empty;  /* Gets which found the RINGBUF empty */
+    uint64_t wraps;      /* Times the producer went past the end of the storage */
+    uint32_t high_water; /* Highest size seen by the producer, bytes or items */
+} simple_ringbuffer_stats_t;
+
+/**
+ * @brief   Producer owned counters, in the producer side of the RINGBUF struct.
+ */
+typedef struct simple_ringbuffer_put_stats
+{
+    SIMPLE_RINGBUFFER_ATOMIC(uint64_t) items;
+    SIMPLE_RINGBUFFER_ATOMIC(uint64_t) bytes;
+    SIMPLE_RINGBUFFER_ATOMIC(uint64_t) full;
+    SIMPLE_RINGBUFFER_ATOMIC(uint64_t) wraps;
+    SIMPLE_RINGBUFFER_ATOMIC(uint32_t) high_water;
+} simple_ringbuffer_put_stats_t;
+
+/**
+ * @brief   Consumer owned counters, in the consumer side of the RINGBUF struct.
+ */
+typedef struct simple_ringbuffer_get_stats
+{
+    SIMPLE_RINGBUFFER_ATOMIC(uint64_t) items;
+    SIMPLE_RINGBUFFER_ATOMIC(uint64_t) bytes;
+    SIMPLE_RINGBUFFER_ATOMIC(uint64_t) empty;
+} simple_ringbuffer_get_stats_t;
+
+/* only the owner side writes a counter, no read-modify-write needed */
+#define SIMPLE_RINGBUFFER_STATS_ADD(_obj, _val)                                                    \
+    SIMPLE_RINGBUFFER_STORE_RELAXED(_obj, SIMPLE_RINGBUFFER_LOAD_RELAXED(_obj) + (_val))
+
+/**
+ * @brief  Zero the counters, when nothing else uses the RINGBUF.
+ */
+static inline void simple_ringbuffer_stats_clear(simple_ringbuffer_put_stats_t *put,
+                                                 simple_ringbuffer_get_stats_t *get)
+{
+    SIMPLE_RINGBUFFER_STORE_RELAXED(put->items, 0);
+    SIMPLE_RINGBUFFER_STORE_RELAXED(put->bytes, 0);
+    SIMPLE_RINGBUFFER_STORE_RELAXED(put->full, 0);
+    SIMPLE_RINGBUFFER_STORE_RELAXED(put->wraps, 0);
+    SIMPLE_RINGBUFFER_STORE_RELAXED(put->high_water, 0);
+    SIMPLE_RINGBUFFER_STORE_RELAXED(get->items, 0);
+    SIMPLE_RINGBUFFER_STORE_RELAXED(get->bytes, 0);
+    SIMPLE_RINGBUFFER_STORE_RELAXED(get->empty, 0);
+}
+
+/**
+ * @brief  Copy the counters of both sides, may be called from any thread.
+ */
+static inline void simple_ringbuffer_stats_load(simple_ringbuffer_put_stats_t *put,
+                                                simple_ringbuffer_get_stats_t *get,
+                                                simple_ringbuffer_stats_t *stats)
+{
+    stats->put_items = SIMPLE_RINGBUFFER_LOAD_RELAXED(put->items);
+    stats->put_bytes = SIMPLE_RINGBUFFER_LOAD_RELAXED(put->bytes);
+    stats->put_full = SIMPLE_RINGBUFFER_LOAD_RELAXED(put->full);
+    stats->wraps = SIMPLE_RINGBUFFER_LOAD_RELAXED(put->wraps);
+    stats->high_water = SIMPLE_RINGBUFFER_LOAD_RELAXED(put->high_water);
+    stats->get_items = SIMPLE_RINGBUFFER_LOAD_RELAXED(get->items);
+    stats->get_bytes = SIMPLE_RINGBUFFER_LOAD_RELAXED(get->bytes);
+    stats->get_empty = SIMPLE_RINGBUFFER_LOAD_RELAXED(get->empty);
+}
+#endif
+
+#endif /* _SIMPLE_RINGBUFFER_PORT_H_ */
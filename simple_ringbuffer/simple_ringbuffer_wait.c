@@ -0,0 +1,238 @@
+#if defined(__linux__)
+/* syscall(), clock_gettime() */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <limits.h>
+#include <time.h>
+
+#include <linux/futex.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "simple_ringbuffer_wait.h"
+
+/**
+ * @brief  One try of a blocking call, returns 1 once the call is done.
+ */
+typedef int (*ringbuffer_wait_try_t)(void *ctx);
+
+static uint64_t ringbuffer_wait_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief  Wake the thread parked on event, if any.
+ * @details Called by one side after it made progress. The fence orders the index store of
+ *   that progress before the waiters load, and pairs with the fence in ringbuffer_wait(): either
+ *   the waiter sees the progress on its last try, or this sees the waiter and bumps seq, which
+ *   makes its futex wait return at once.
+ */
+static void ringbuffer_wake(simple_ringbuffer_waiter_t *waiter, simple_ringbuffer_event_t *event)
+{
+    if (waiter->strategy != SIMPLE_RINGBUFFER_WAIT_FUTEX)
+    {
+        return;
+    }
+
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&event->waiters, memory_order_relaxed) != 0)
+    {
+        atomic_fetch_add_explicit(&event->seq, 1, memory_order_release);
+        syscall(SYS_futex, &event->seq, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+    }
+}
+
+/**
+ * @brief  Call try_op until it is done or timeout_ms expires.
+ * @return 1 if try_op is done, 0 on timeout.
+ */
+static int ringbuffer_wait(simple_ringbuffer_waiter_t *waiter, simple_ringbuffer_event_t *event,
+                           ringbuffer_wait_try_t try_op, void *ctx, int32_t timeout_ms)
+{
+    uint64_t deadline = 0;
+
+    if (try_op(ctx))
+    {
+        return 1;
+    }
+    if (timeout_ms == 0)
+    {
+        return 0;
+    }
+    if (timeout_ms > 0)
+    {
+        deadline = ringbuffer_wait_now_ns() + (uint64_t)timeout_ms * 1000000u;
+    }
+
+    /* the other side is likely running, it is cheaper to spin a bit than to sleep */
+    for (uint32_t i = 0; i < waiter->spin_cnt; i++)
+    {
+        SIMPLE_RINGBUFFER_CPU_RELAX();
+        if (try_op(ctx))
+        {
+            return 1;
+        }
+    }
+
+    while (1)
+    {
+        uint64_t now = timeout_ms > 0 ? ringbuffer_wait_now_ns() : 0;
+        if (timeout_ms > 0 && now >= deadline)
+        {
+            return 0;
+        }
+
+        if (waiter->strategy == SIMPLE_RINGBUFFER_WAIT_FUTEX)
+        {
+            struct timespec ts;
+            unsigned int seq = atomic_load_explicit(&event->seq, memory_order_acquire);
+            int done;
+
+            atomic_fetch_add_explicit(&event->waiters, 1, memory_order_relaxed);
+            atomic_thread_fence(memory_order_seq_cst);
+            /* last try once visible as a waiter, see ringbuffer_wake() */
+            done = try_op(ctx);
+            if (!done)
+            {
+                ts.tv_sec = (deadline - now) / 1000000000u;
+                ts.tv_nsec = (deadline - now) % 1000000000u;
+                syscall(SYS_futex, &event->seq, FUTEX_WAIT_PRIVATE, seq,
+                        timeout_ms > 0 ? &ts : NULL, NULL, 0);
+            }
+            atomic_fetch_sub_explicit(&event->waiters, 1, memory_order_relaxed);
+            if (done)
+            {
+                return 1;
+            }
+        }
+        else if (waiter->strategy == SIMPLE_RINGBUFFER_WAIT_YIELD)
+        {
+            sched_yield();
+        }
+        else
+        {
+            SIMPLE_RINGBUFFER_CPU_RELAX();
+        }
+
+        if (try_op(ctx))
+        {
+            return 1;
+        }
+    }
+}
+
+typedef struct ringbuffer_wait_ctx
+{
+    void *ringbuf;
+    simple_ringbuffer_waiter_t *waiter;
+    uint8_t *buffer;
+    uint32_t len;
+    uint32_t done;
+} ringbuffer_wait_ctx_t;
+
+static int ringbuffer_try_put(void *arg)
+{
+    ringbuffer_wait_ctx_t *ctx = arg;
+    uint32_t len = simple_ringbuffer_put(ctx->ringbuf, ctx->buffer + ctx->done,
+                                         ctx->len - ctx->done);
+
+    if (len != 0)
+    {
+        ctx->done += len;
+        ringbuffer_wake(ctx->waiter, &ctx->waiter->not_empty);
+    }
+
+    return ctx->done == ctx->len;
+}
+
+static int ringbuffer_try_get(void *arg)
+{
+    ringbuffer_wait_ctx_t *ctx = arg;
+
+    ctx->done = simple_ringbuffer_get(ctx->ringbuf, ctx->buffer, ctx->len);
+    if (ctx->done != 0)
+    {
+        ringbuffer_wake(ctx->waiter, &ctx->waiter->not_full);
+    }
+
+    return ctx->done != 0;
+}
+
+static int data_ringbuffer_try_put(void *arg)
+{
+    ringbuffer_wait_ctx_t *ctx = arg;
+
+    ctx->done = simple_data_ringbuffer_put(ctx->ringbuf, ctx->buffer);
+    if (ctx->done != 0)
+    {
+        ringbuffer_wake(ctx->waiter, &ctx->waiter->not_empty);
+    }
+
+    return ctx->done != 0;
+}
+
+static int data_ringbuffer_try_get(void *arg)
+{
+    ringbuffer_wait_ctx_t *ctx = arg;
+
+    ctx->done = simple_data_ringbuffer_get(ctx->ringbuf, ctx->buffer);
+    if (ctx->done != 0)
+    {
+        ringbuffer_wake(ctx->waiter, &ctx->waiter->not_full);
+    }
+
+    return ctx->done != 0;
+}
+
+uint32_t simple_ringbuffer_put_wait(simple_ringbuffer_t *ringbuf,
+                                    simple_ringbuffer_waiter_t *waiter, uint8_t *buffer,
+                                    uint32_t len, int32_t timeout_ms)
+{
+    ringbuffer_wait_ctx_t ctx = {ringbuf, waiter, buffer, len, 0};
+
+    ringbuffer_wait(waiter, &waiter->not_full, ringbuffer_try_put, &ctx, timeout_ms);
+
+    return ctx.done;
+}
+
+uint32_t simple_ringbuffer_get_wait(simple_ringbuffer_t *ringbuf,
+                                    simple_ringbuffer_waiter_t *waiter, uint8_t *buffer,
+                                    uint32_t len, int32_t timeout_ms)
+{
+    ringbuffer_wait_ctx_t ctx = {ringbuf, waiter, buffer, len, 0};
+
+    if (len == 0)
+    {
+        return 0;
+    }
+    ringbuffer_wait(waiter, &waiter->not_empty, ringbuffer_try_get, &ctx, timeout_ms);
+
+    return ctx.done;
+}
+
+int simple_data_ringbuffer_put_wait(simple_data_ringbuffer_t *ringbuf,
+                                    simple_ringbuffer_waiter_t *waiter, void *buffer,
+                                    int32_t timeout_ms)
+{
+    ringbuffer_wait_ctx_t ctx = {ringbuf, waiter, buffer, 1, 0};
+
+    return ringbuffer_wait(waiter, &waiter->not_full, data_ringbuffer_try_put, &ctx, timeout_ms);
+}
+
+int simple_data_ringbuffer_get_wait(simple_data_ringbuffer_t *ringbuf,
+                                    simple_ringbuffer_waiter_t *waiter, void *buffer,
+                                    int32_t timeout_ms)
+{
+    ringbuffer_wait_ctx_t ctx = {ringbuf, waiter, buffer, 1, 0};
+
+    return ringbuffer_wait(waiter, &waiter->not_empty, data_ringbuffer_try_get, &ctx,
+                           timeout_ms);
+}
+#endif
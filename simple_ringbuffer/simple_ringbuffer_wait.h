@@ -0,0 +1,122 @@
+#ifndef _SIMPLE_RINGBUFFER_WAIT_H_
+#define _SIMPLE_RINGBUFFER_WAIT_H_
+
+#if defined(__linux__)
+#include <stdint.h>
+#include <stdatomic.h>
+
+#include "simple_data_ringbuffer.h"
+#include "simple_ringbuffer.h"
+
+/**
+ * @brief   Number of failed tries before a blocking call stops busy-spinning.
+ */
+#ifndef SIMPLE_RINGBUFFER_WAIT_SPIN_CNT
+#define SIMPLE_RINGBUFFER_WAIT_SPIN_CNT 128
+#endif
+
+/**
+ * @brief   What a blocking put/get does once the spin phase did not succeed.
+ */
+typedef enum simple_ringbuffer_wait_strategy
+{
+    SIMPLE_RINGBUFFER_WAIT_SPIN = 0, /* Keep spinning, lowest latency, burns the core */
+    SIMPLE_RINGBUFFER_WAIT_YIELD,    /* sched_yield() between tries */
+    SIMPLE_RINGBUFFER_WAIT_FUTEX,    /* Park on a futex until the other side makes progress */
+} simple_ringbuffer_wait_strategy_t;
+
+/**
+ * @brief   One side of a RINGBUF a thread may wait for (not empty / not full).
+ */
+typedef struct simple_ringbuffer_event
+{
+    SIMPLE_RINGBUFFER_CACHE_ALIGNED
+    atomic_uint seq;     /* Futex word, bumped by every wake which found a waiter */
+    atomic_uint waiters; /* Threads parked, or about to park, on seq */
+} simple_ringbuffer_event_t;
+
+/**
+ * @brief   Wait state of one RINGBUF, shared by its producer and consumer.
+ * @details
+ *   The blocking calls below take it along with the RINGBUF. With SIMPLE_RINGBUFFER_WAIT_FUTEX
+ *   both sides must go through these calls (timeout 0 for a non-blocking one), they wake the
+ *   other side after progress. A wake costs a fence and a load, the futex syscall is only made
+ *   when a thread is actually parked.
+ *   Linux only, and two threads need the SIMPLE_RINGBUFFER_SPSC build.
+ */
+typedef struct simple_ringbuffer_waiter
+{
+    simple_ringbuffer_wait_strategy_t strategy;
+    uint32_t spin_cnt;
+    simple_ringbuffer_event_t not_empty; /* The consumer waits for data */
+    simple_ringbuffer_event_t not_full;  /* The producer waits for room */
+} simple_ringbuffer_waiter_t;
+
+/**
+ * @brief  Initialize the wait state of a RINGBUF.
+ * @param  [in] waiter: The wait state to be used.
+ * @param  [in] strategy: What to do after SIMPLE_RINGBUFFER_WAIT_SPIN_CNT failed tries.
+ */
+static inline void simple_ringbuffer_waiter_init(simple_ringbuffer_waiter_t *waiter,
+                                                 simple_ringbuffer_wait_strategy_t strategy)
+{
+    waiter->strategy = strategy;
+    waiter->spin_cnt = SIMPLE_RINGBUFFER_WAIT_SPIN_CNT;
+    atomic_init(&waiter->not_empty.seq, 0);
+    atomic_init(&waiter->not_empty.waiters, 0);
+    atomic_init(&waiter->not_full.seq, 0);
+    atomic_init(&waiter->not_full.waiters, 0);
+}
+
+/**
+ * @brief  Put all the data into the RINGBUF, waiting for room.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @param  [in] waiter: The wait state of the RINGBUF.
+ * @param  [in] buffer: The buffer to be put into the RINGBUF.
+ * @param  [in] len: The length of the buffer.
+ * @param  [in] timeout_ms: Maximum wait in ms, < 0 waits forever, 0 does not wait.
+ * @return The length put into the RINGBUF, less than len on timeout.
+ */
+uint32_t simple_ringbuffer_put_wait(simple_ringbuffer_t *ringbuf,
+                                    simple_ringbuffer_waiter_t *waiter, uint8_t *buffer,
+                                    uint32_t len, int32_t timeout_ms);
+
+/**
+ * @brief  Get data from the RINGBUF, waiting until there is some.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @param  [in] waiter: The wait state of the RINGBUF.
+ * @param  [in] buffer: The destination buffer.
+ * @param  [in] len: The length of the buffer.
+ * @param  [in] timeout_ms: Maximum wait in ms, < 0 waits forever, 0 does not wait.
+ * @return The length get from the RINGBUF, up to len, 0 on timeout.
+ */
+uint32_t simple_ringbuffer_get_wait(simple_ringbuffer_t *ringbuf,
+                                    simple_ringbuffer_waiter_t *waiter, uint8_t *buffer,
+                                    uint32_t len, int32_t timeout_ms);
+
+/**
+ * @brief  Put an item into the RINGBUF, waiting for a free slot.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @param  [in] waiter: The wait state of the RINGBUF.
+ * @param  [in] buffer: The item.
+ * @param  [in] timeout_ms: Maximum wait in ms, < 0 waits forever, 0 does not wait.
+ * @return 1 if the item was put, 0 on timeout.
+ */
+int simple_data_ringbuffer_put_wait(simple_data_ringbuffer_t *ringbuf,
+                                    simple_ringbuffer_waiter_t *waiter, void *buffer,
+                                    int32_t timeout_ms);
+
+/**
+ * @brief  Get an item from the RINGBUF, waiting until there is one.
+ * @param  [in] ringbuf: The ringbuf to be used.
+ * @param  [in] waiter: The wait state of the RINGBUF.
+ * @param  [in] buffer: The destination of the item, NULL to drop it.
+ * @param  [in] timeout_ms: Maximum wait in ms, < 0 waits forever, 0 does not wait.
+ * @return 1 if an item was get, 0 on timeout.
+ */
+int simple_data_ringbuffer_get_wait(simple_data_ringbuffer_t *ringbuf,
+                                    simple_ringbuffer_waiter_t *waiter, void *buffer,
+                                    int32_t timeout_ms);
+#endif
+
+#endif /* _SIMPLE_RINGBUFFER_WAIT_H_ */
@@ -0,0 +1,391 @@
+#if defined(__linux__)
+/* shm_open(), ftruncate() */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <errno.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "simple_ringbuffer_internal.h"
+#include "simple_shm_ringbuffer.h"
+
+/* the storage starts on its own cache line after the header */
+#define SHM_RINGBUFFER_DATA_OFFSET                                                                 \
+    ((sizeof(simple_shm_ringbuffer_header_t) + SIMPLE_RINGBUFFER_CACHE_LINE_SIZE - 1) /            \
+     SIMPLE_RINGBUFFER_CACHE_LINE_SIZE * SIMPLE_RINGBUFFER_CACHE_LINE_SIZE)
+
+/**
+ * @brief  Map an open shared memory object and fill the process local handle.
+ */
+static int shm_ringbuffer_map(simple_shm_ringbuffer_t *shm, int fd, size_t map_size)
+{
+    void *base = mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    if (base == MAP_FAILED)
+    {
+        return -1;
+    }
+
+    shm->header = base;
+    shm->buffer = (uint8_t *)base + SHM_RINGBUFFER_DATA_OFFSET;
+    shm->map_size = map_size;
+    shm->write_index_cache = 0;
+    shm->read_index_cache = 0;
+#if SIMPLE_RINGBUFFER_STATS
+    simple_ringbuffer_stats_clear(&shm->put_stats, &shm->get_stats);
+#endif
+
+    return 0;
+}
+
+int simple_shm_ringbuffer_create(simple_shm_ringbuffer_t *shm, const char *name,
+                                 uint32_t total_size)
+{
+    simple_shm_ringbuffer_header_t *header;
+    size_t map_size = SHM_RINGBUFFER_DATA_OFFSET + (size_t)total_size;
+    int fd;
+
+    /* indices run up to 2 * total_size */
+    if (total_size == 0 || total_size > 0x7fffffffu)
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0)
+    {
+        return -1;
+    }
+    /* the new object is zero filled, magic is not set until the header is complete */
+    if (ftruncate(fd, (off_t)map_size) != 0 || shm_ringbuffer_map(shm, fd, map_size) != 0)
+    {
+        int err = errno;
+        close(fd);
+        shm_unlink(name);
+        errno = err;
+        return -1;
+    }
+    /* the mapping keeps the object alive */
+    close(fd);
+
+    header = shm->header;
+    header->total_size = total_size;
+    header->index_mask = SIMPLE_RINGBUFFER_INDEX_MASK(total_size);
+    header->data_offset = SHM_RINGBUFFER_DATA_OFFSET;
+    atomic_init(&header->read_index, 0);
+    atomic_init(&header->write_index, 0);
+    /* publish the header to the processes which attach */
+    atomic_store_explicit(&header->magic, SIMPLE_SHM_RINGBUFFER_MAGIC, memory_order_release);
+
+    shm->total_size = total_size;
+    shm->index_mask = header->index_mask;
+
+    return 0;
+}
+
+int simple_shm_ringbuffer_attach(simple_shm_ringbuffer_t *shm, const char *name)
+{
+    simple_shm_ringbuffer_header_t *header;
+    struct stat st;
+    int fd;
+
+    fd = shm_open(name, O_RDWR, 0);
+    if (fd < 0)
+    {
+        return -1;
+    }
+    if (fstat(fd, &st) != 0)
+    {
+        int err = errno;
+        close(fd);
+        errno = err;
+        return -1;
+    }
+    if ((size_t)st.st_size < SHM_RINGBUFFER_DATA_OFFSET)
+    {
+        close(fd);
+        errno = EINVAL;
+        return -1;
+    }
+    if (shm_ringbuffer_map(shm, fd, (size_t)st.st_size) != 0)
+    {
+        int err = errno;
+        close(fd);
+        errno = err;
+        return -1;
+    }
+    close(fd);
+
+    /* only trust the header once it is published, and only if it fits the mapping */
+    header = shm->header;
+    if (atomic_load_explicit(&header->magic, memory_order_acquire) !=
+                SIMPLE_SHM_RINGBUFFER_MAGIC ||
+        header->data_offset != SHM_RINGBUFFER_DATA_OFFSET || header->total_size == 0 ||
+        header->total_size > 0x7fffffffu ||
+        header->total_size > shm->map_size - SHM_RINGBUFFER_DATA_OFFSET)
+    {
+        simple_shm_ringbuffer_detach(shm);
+        errno = EINVAL;
+        return -1;
+    }
+
+    shm->total_size = header->total_size;
+    shm->index_mask = SIMPLE_RINGBUFFER_INDEX_MASK(shm->total_size);
+    shm->write_index_cache = atomic_load_explicit(&header->write_index, memory_order_acquire);
+    shm->read_index_cache = atomic_load_explicit(&header->read_index, memory_order_acquire);
+
+    return 0;
+}
+
+void simple_shm_ringbuffer_detach(simple_shm_ringbuffer_t *shm)
+{
+    if (shm->header != NULL)
+    {
+        munmap(shm->header, shm->map_size);
+        shm->header = NULL;
+        shm->buffer = NULL;
+    }
+}
+
+int simple_shm_ringbuffer_unlink(const char *name)
+{
+    return shm_unlink(name);
+}
+
+/**
+ * @brief  Producer side view of read_index, reloaded only when the cached one leaves no room.
+ */
+static inline uint32_t shm_ringbuffer_producer_read_index(simple_shm_ringbuffer_t *shm,
+                                                          uint32_t write_index, uint32_t len)
+{
+    return ringbuffer_cached_read_index(&shm->header->read_index, &shm->read_index_cache,
+                                        write_index, len, shm->total_size, shm->index_mask);
+}
+
+/**
+ * @brief  Consumer side view of write_index, reloaded only when the cached one holds no data.
+ */
+static inline uint32_t shm_ringbuffer_consumer_write_index(simple_shm_ringbuffer_t *shm,
+                                                           uint32_t read_index, uint32_t len)
+{
+    return ringbuffer_cached_write_index(&shm->header->write_index, &shm->write_index_cache,
+                                         read_index, len, shm->total_size, shm->index_mask);
+}
+
+/**
+ * @brief  Check a pair of indices loaded from the mapping.
+ * @details The other process can write anything there, a crashed or broken peer must not make
+ *   this one copy outside the storage. Both indices must be in [0, 2 * total_size) and hold at
+ *   most total_size bytes between them.
+ */
+static inline int shm_ringbuffer_index_valid(simple_shm_ringbuffer_t *shm, uint32_t write_index,
+                                             uint32_t read_index)
+{
+    return write_index < (shm->total_size << 1) && read_index < (shm->total_size << 1) &&
+           RINGBUFFER_USED_SIZE(write_index, read_index, shm->total_size, shm->index_mask) <=
+                   shm->total_size;
+}
+
+/**
+ * @brief  Count len bytes put at write_index, nothing without SIMPLE_RINGBUFFER_STATS.
+ * @details read_index is the cached one, it is only reloaded when it would raise high_water.
+ */
+static inline void shm_ringbuffer_stats_put(simple_shm_ringbuffer_t *shm, uint32_t write_index,
+                                            uint32_t read_index, uint32_t len)
+{
+#if SIMPLE_RINGBUFFER_STATS
+    uint32_t high_water = SIMPLE_RINGBUFFER_LOAD_RELAXED(shm->put_stats.high_water);
+    uint32_t used;
+
+    if (len == 0)
+    {
+        return;
+    }
+    SIMPLE_RINGBUFFER_STATS_ADD(shm->put_stats.items, 1);
+    SIMPLE_RINGBUFFER_STATS_ADD(shm->put_stats.bytes, len);
+    SIMPLE_RINGBUFFER_STATS_ADD(shm->put_stats.wraps,
+                                RINGBUFFER_INDEX_TO_PTR(write_index, shm->total_size,
+                                                        shm->index_mask) +
+                                                len >=
+                                        shm->total_size);
+
+    used = RINGBUFFER_USED_SIZE(write_index, read_index, shm->total_size, shm->index_mask) + len;
+    if (used > high_water)
+    {
+        read_index = atomic_load_explicit(&shm->header->read_index, memory_order_acquire);
+        if (!shm_ringbuffer_index_valid(shm, write_index, read_index))
+        {
+            return;
+        }
+        shm->read_index_cache = read_index;
+        used = RINGBUFFER_USED_SIZE(write_index, read_index, shm->total_size, shm->index_mask) +
+               len;
+    }
+    if (used > high_water)
+    {
+        SIMPLE_RINGBUFFER_STORE_RELAXED(shm->put_stats.high_water, used);
+    }
+#endif
+}
+
+/**
+ * @brief  Count a put which found no room for all of its data.
+ */
+static inline void shm_ringbuffer_stats_full(simple_shm_ringbuffer_t *shm, int full)
+{
+#if SIMPLE_RINGBUFFER_STATS
+    SIMPLE_RINGBUFFER_STATS_ADD(shm->put_stats.full, full != 0);
+#endif
+}
+
+/**
+ * @brief  Count len bytes get, and a get which found the RINGBUF empty.
+ */
+static inline void shm_ringbuffer_stats_get(simple_shm_ringbuffer_t *shm, uint32_t len,
+                                            int empty)
+{
+#if SIMPLE_RINGBUFFER_STATS
+    SIMPLE_RINGBUFFER_STATS_ADD(shm->get_stats.items, len != 0);
+    SIMPLE_RINGBUFFER_STATS_ADD(shm->get_stats.bytes, len);
+    SIMPLE_RINGBUFFER_STATS_ADD(shm->get_stats.empty, empty != 0);
+#endif
+}
+
+/**
+ * @brief  Split len bytes from ptr into the part up to the end of storage and the wrapped part.
+ */
+static inline void shm_ringbuffer_span_split(simple_shm_ringbuffer_t *shm, uint32_t ptr,
+                                             uint32_t len, simple_ringbuffer_span_t span[2])
+{
+    span[0].data = shm->buffer + ptr;
+    span[0].len = MIN(len, shm->total_size - ptr);
+    span[1].data = shm->buffer;
+    span[1].len = len - span[0].len;
+}
+
+uint32_t simple_shm_ringbuffer_reserve(simple_shm_ringbuffer_t *shm,
+                                       simple_ringbuffer_span_t span[2])
+{
+    uint32_t write_index = atomic_load_explicit(&shm->header->write_index, memory_order_relaxed);
+    uint32_t read_index = shm_ringbuffer_producer_read_index(shm, write_index, shm->total_size);
+    uint32_t len;
+
+    if (!shm_ringbuffer_index_valid(shm, write_index, read_index))
+    {
+        span[0].len = span[1].len = 0;
+        return 0;
+    }
+    len = shm->total_size -
+          RINGBUFFER_USED_SIZE(write_index, read_index, shm->total_size, shm->index_mask);
+    shm_ringbuffer_stats_full(shm, len == 0);
+    shm_ringbuffer_span_split(
+            shm, RINGBUFFER_INDEX_TO_PTR(write_index, shm->total_size, shm->index_mask), len,
+            span);
+
+    return len;
+}
+
+void simple_shm_ringbuffer_commit(simple_shm_ringbuffer_t *shm, uint32_t len)
+{
+    uint32_t write_index = atomic_load_explicit(&shm->header->write_index, memory_order_relaxed);
+
+    shm_ringbuffer_stats_put(shm, write_index, shm->read_index_cache, len);
+    /* publish the data to the consumer */
+    atomic_store_explicit(&shm->header->write_index,
+                          ringbuffer_index_add(write_index, len, shm->total_size, shm->index_mask),
+                          memory_order_release);
+}
+
+uint32_t simple_shm_ringbuffer_peek(simple_shm_ringbuffer_t *shm,
+                                    simple_ringbuffer_span_t span[2])
+{
+    uint32_t read_index = atomic_load_explicit(&shm->header->read_index, memory_order_relaxed);
+    uint32_t write_index = shm_ringbuffer_consumer_write_index(shm, read_index, shm->total_size);
+    uint32_t len;
+
+    if (!shm_ringbuffer_index_valid(shm, write_index, read_index))
+    {
+        span[0].len = span[1].len = 0;
+        return 0;
+    }
+    len = RINGBUFFER_USED_SIZE(write_index, read_index, shm->total_size, shm->index_mask);
+    shm_ringbuffer_stats_get(shm, 0, len == 0);
+    shm_ringbuffer_span_split(
+            shm, RINGBUFFER_INDEX_TO_PTR(read_index, shm->total_size, shm->index_mask), len,
+            span);
+
+    return len;
+}
+
+void simple_shm_ringbuffer_consume(simple_shm_ringbuffer_t *shm, uint32_t len)
+{
+    uint32_t read_index = atomic_load_explicit(&shm->header->read_index, memory_order_relaxed);
+
+    shm_ringbuffer_stats_get(shm, len, 0);
+    /* release the space to the producer */
+    atomic_store_explicit(&shm->header->read_index,
+                          ringbuffer_index_add(read_index, len, shm->total_size, shm->index_mask),
+                          memory_order_release);
+}
+
+uint32_t simple_shm_ringbuffer_put(simple_shm_ringbuffer_t *shm, const uint8_t *buffer,
+                                   uint32_t len)
+{
+    uint32_t write_index = atomic_load_explicit(&shm->header->write_index, memory_order_relaxed);
+    uint32_t read_index = shm_ringbuffer_producer_read_index(shm, write_index, len);
+    simple_ringbuffer_span_t span[2];
+    uint32_t room;
+
+    if (!shm_ringbuffer_index_valid(shm, write_index, read_index))
+    {
+        return 0;
+    }
+    room = shm->total_size -
+           RINGBUFFER_USED_SIZE(write_index, read_index, shm->total_size, shm->index_mask);
+    shm_ringbuffer_stats_full(shm, room < len);
+    len = MIN(len, room);
+    shm_ringbuffer_stats_put(shm, write_index, read_index, len);
+    shm_ringbuffer_span_split(
+            shm, RINGBUFFER_INDEX_TO_PTR(write_index, shm->total_size, shm->index_mask), len,
+            span);
+    ringbuffer_copy(span[0].data, buffer, span[1].data, buffer + span[0].len, span[0].len, len);
+
+    /* publish the data to the consumer */
+    atomic_store_explicit(&shm->header->write_index,
+                          ringbuffer_index_add(write_index, len, shm->total_size, shm->index_mask),
+                          memory_order_release);
+
+    return len;
+}
+
+uint32_t simple_shm_ringbuffer_get(simple_shm_ringbuffer_t *shm, uint8_t *buffer, uint32_t len)
+{
+    uint32_t read_index = atomic_load_explicit(&shm->header->read_index, memory_order_relaxed);
+    uint32_t write_index = shm_ringbuffer_consumer_write_index(shm, read_index, len);
+    simple_ringbuffer_span_t span[2];
+
+    if (!shm_ringbuffer_index_valid(shm, write_index, read_index))
+    {
+        return 0;
+    }
+    len = MIN(len,
+              RINGBUFFER_USED_SIZE(write_index, read_index, shm->total_size, shm->index_mask));
+    shm_ringbuffer_stats_get(shm, len, read_index == write_index);
+    shm_ringbuffer_span_split(
+            shm, RINGBUFFER_INDEX_TO_PTR(read_index, shm->total_size, shm->index_mask), len, span);
+    ringbuffer_copy(buffer, span[0].data, buffer + span[0].len, span[1].data, span[0].len, len);
+
+    /* release the space to the producer */
+    atomic_store_explicit(&shm->header->read_index,
+                          ringbuffer_index_add(read_index, len, shm->total_size, shm->index_mask),
+                          memory_order_release);
+
+    return len;
+}
+#endif
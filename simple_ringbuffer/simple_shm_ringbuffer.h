@@ -0,0 +1,193 @@
+#ifndef _SIMPLE_SHM_RINGBUFFER_H_
+#define _SIMPLE_SHM_RINGBUFFER_H_
+
+#if defined(__linux__)
+#include <stdint.h>
+#include <stddef.h>
+#include <stdatomic.h>
+
+#include "simple_ringbuffer.h"
+
+/**
+ * @brief   Value of simple_shm_ringbuffer_header_t::magic once the creator is done with it.
+ */
+#define SIMPLE_SHM_RINGBUFFER_MAGIC 0x53524246u /* "SRBF" */
+
+/**
+ * @brief   Header of a shared memory RINGBUF, at the start of the mapping.
+ * @details
+ *   Only plain values and offsets are stored here, never a pointer: every process maps the
+ *   object at its own address. The storage starts data_offset bytes after the header.
+ *   The indices are always atomic (whatever SIMPLE_RINGBUFFER_SPSC), each on its own cache line.
+ */
+typedef struct simple_shm_ringbuffer_header
+{
+    atomic_uint magic;    /* SIMPLE_SHM_RINGBUFFER_MAGIC, published last by the creator */
+    uint32_t total_size;  /* Size of the storage in bytes */
+    uint32_t index_mask;  /* SIMPLE_RINGBUFFER_INDEX_MASK(total_size) */
+    uint32_t data_offset; /* Offset of the storage from the header */
+
+    /* Consumer side */
+    _Alignas(SIMPLE_RINGBUFFER_CACHE_LINE_SIZE) atomic_uint read_index;
+
+    /* Producer side */
+    _Alignas(SIMPLE_RINGBUFFER_CACHE_LINE_SIZE) atomic_uint write_index;
+} simple_shm_ringbuffer_header_t;
+
+/**
+ * @brief   Process local handle of a shared memory RINGBUF.
+ * @details
+ *   One process (or thread) is the producer and one the consumer, they run the SPSC protocol on
+ *   the shared indices: data moves between them through the mapping, with no kernel copy.
+ *   total_size and index_mask are checked against the mapping and copied at attach time, later
+ *   changes of the header by the other process are ignored. The indices are checked on every
+ *   load, put, get, reserve and peek return 0 when the other process left them out of range.
+ *   With SIMPLE_RINGBUFFER_STATS each handle counts its own side here, not in the mapping: the
+ *   header layout is the same in every build, and a peer can not forge the counters.
+ */
+typedef struct simple_shm_ringbuffer
+{
+    simple_shm_ringbuffer_header_t *header;
+    uint8_t *buffer;     /* The storage, in this process */
+    size_t map_size;     /* Size of the mapping */
+    uint32_t total_size; /* Size of the storage in bytes */
+    uint32_t index_mask; /* SIMPLE_RINGBUFFER_INDEX_MASK(total_size) */
+
+    uint32_t write_index_cache; /* Read. Last write_index seen by the consumer */
+    uint32_t read_index_cache;  /* Write. Last read_index seen by the producer */
+
+#if SIMPLE_RINGBUFFER_STATS
+    simple_ringbuffer_put_stats_t put_stats; /* Counters of this handle as a producer */
+    simple_ringbuffer_get_stats_t get_stats; /* Counters of this handle as a consumer */
+#endif
+} simple_shm_ringbuffer_t;
+
+/**
+ * @brief  Create a shared memory RINGBUF and map it.
+ * @details The object is created with shm_open(), it must not exist yet. It stays in the
+ *   system until simple_shm_ringbuffer_unlink() is called, even after every process detached.
+ * @param  [in] shm: The handle to be used.
+ * @param  [in] name: Name of the shared memory object, "/name".
+ * @param  [in] total_size: The size of the storage in bytes, at most 0x7fffffff.
+ * @return 0 on success, -1 on failure (errno is set).
+ */
+int simple_shm_ringbuffer_create(simple_shm_ringbuffer_t *shm, const char *name,
+                                 uint32_t total_size);
+
+/**
+ * @brief  Map a shared memory RINGBUF created by simple_shm_ringbuffer_create().
+ * @param  [in] shm: The handle to be used.
+ * @param  [in] name: Name of the shared memory object.
+ * @return 0 on success, -1 on failure (errno is set, EINVAL if it is no valid RINGBUF,
+ *         or its creator is not done yet).
+ */
+int simple_shm_ringbuffer_attach(simple_shm_ringbuffer_t *shm, const char *name);
+
+/**
+ * @brief  Unmap a shared memory RINGBUF.
+ * @param  [in] shm: The handle to be used.
+ */
+void simple_shm_ringbuffer_detach(simple_shm_ringbuffer_t *shm);
+
+/**
+ * @brief  Remove the name of a shared memory RINGBUF, it is freed once every process detached.
+ * @param  [in] name: Name of the shared memory object.
+ * @return 0 on success, -1 on failure (errno is set).
+ */
+int simple_shm_ringbuffer_unlink(const char *name);
+
+/**
+ * @brief  Check if the RINGBUF is empty.
+ * @param  [in] shm: The ringbuf to be used.
+ * @return 1 if the RINGBUF is empty, 0 otherwise.
+ */
+static inline int simple_shm_ringbuffer_is_empty(simple_shm_ringbuffer_t *shm)
+{
+    return atomic_load_explicit(&shm->header->read_index, memory_order_acquire) ==
+           atomic_load_explicit(&shm->header->write_index, memory_order_acquire);
+}
+
+/**
+ * @brief  Returns the used size of the RINGBUF in bytes.
+ * @param  [in] shm: The ringbuf to be used.
+ * @return The used size of the RINGBUF in bytes.
+ */
+static inline uint32_t simple_shm_ringbuffer_size(simple_shm_ringbuffer_t *shm)
+{
+    uint32_t read_index = atomic_load_explicit(&shm->header->read_index, memory_order_acquire);
+    uint32_t write_index = atomic_load_explicit(&shm->header->write_index, memory_order_acquire);
+
+    return write_index >= read_index ? write_index - read_index
+                                     : (shm->total_size << 1) - (read_index - write_index);
+}
+
+/**
+ * @brief  Put data into the RINGBUF.
+ * @param  [in] shm: The ringbuf to be used.
+ * @param  [in] buffer: The buffer to be put into the RINGBUF.
+ * @param  [in] len: The length of the buffer.
+ * @return The length put into the RINGBUF.
+ */
+uint32_t simple_shm_ringbuffer_put(simple_shm_ringbuffer_t *shm, const uint8_t *buffer,
+                                   uint32_t len);
+
+/**
+ * @brief  Get data from the RINGBUF.
+ * @param  [in] shm: The ringbuf to be used.
+ * @param  [in] buffer: The destination buffer.
+ * @param  [in] len: The length of the buffer.
+ * @return The length get from the RINGBUF.
+ */
+uint32_t simple_shm_ringbuffer_get(simple_shm_ringbuffer_t *shm, uint8_t *buffer, uint32_t len);
+
+/**
+ * @brief  Reserve the free space of the RINGBUF, to be written in place.
+ * @details Same as simple_ringbuffer_reserve(), publish with simple_shm_ringbuffer_commit().
+ * @param  [in] shm: The ringbuf to be used.
+ * @param  [out] span: The free space, up to the end of the storage then from its start.
+ * @return The free size in bytes.
+ */
+uint32_t simple_shm_ringbuffer_reserve(simple_shm_ringbuffer_t *shm,
+                                       simple_ringbuffer_span_t span[2]);
+
+/**
+ * @brief  Publish len bytes written in the space returned by simple_shm_ringbuffer_reserve().
+ * @param  [in] shm: The ringbuf to be used.
+ * @param  [in] len: The length written.
+ */
+void simple_shm_ringbuffer_commit(simple_shm_ringbuffer_t *shm, uint32_t len);
+
+/**
+ * @brief  Peek the used space of the RINGBUF, to be read in place.
+ * @details Same as simple_ringbuffer_peek(), release with simple_shm_ringbuffer_consume().
+ * @param  [in] shm: The ringbuf to be used.
+ * @param  [out] span: The data, up to the end of the storage then from its start.
+ * @return The used size in bytes.
+ */
+uint32_t simple_shm_ringbuffer_peek(simple_shm_ringbuffer_t *shm,
+                                    simple_ringbuffer_span_t span[2]);
+
+/**
+ * @brief  Release len bytes returned by simple_shm_ringbuffer_peek().
+ * @param  [in] shm: The ringbuf to be used.
+ * @param  [in] len: The length read.
+ */
+void simple_shm_ringbuffer_consume(simple_shm_ringbuffer_t *shm, uint32_t len);
+
+#if SIMPLE_RINGBUFFER_STATS
+/**
+ * @brief  Take a snapshot of the counters of this handle, 'make STATS=1'.
+ * @details Only what went through this handle: the put side of a producer, the get side of a
+ *   consumer. high_water is seen from the producer side.
+ * @param  [in] shm: The ringbuf to be used.
+ * @param  [out] stats: The counters since create or attach.
+ */
+static inline void simple_shm_ringbuffer_stats_snapshot(simple_shm_ringbuffer_t *shm,
+                                                        simple_ringbuffer_stats_t *stats)
+{
+    simple_ringbuffer_stats_load(&shm->put_stats, &shm->get_stats, stats);
+}
+#endif
+#endif
+
+#endif /* _SIMPLE_SHM_RINGBUFFER_H_ */
@@ -974,6 +974,474 @@ static void test_work_read_index_big_to_write_index_odd(void)
     SUITE_END();
 }
 
+static void test_work_span_odd(void)
+{
+    SUITE_START("test_work_span_odd");
+
+    SIMPLE_RINGBUFFER_DEFINE(test_ringbuf, TEST_BUFFER_SIZE_ODD);
+
+    SIMPLE_RINGBUFFER_INIT(test_ringbuf, TEST_BUFFER_SIZE_ODD);
+
+    simple_ringbuffer_span_t span[2];
+    uint32_t put_loop = 0;
+    uint32_t get_loop = 0;
+
+    for (int round = 0; round < 100; round++)
+    {
+        // write in place, part of the free space.
+        uint32_t free_len = simple_ringbuffer_reserve(&test_ringbuf, span);
+        ASSERT(free_len == simple_ringbuffer_reserve_size(&test_ringbuf));
+        ASSERT(span[0].len + span[1].len == free_len);
+        ASSERT(span[1].len == 0 || span[0].data + span[0].len ==
+                                           test_ringbuf.buffer + TEST_BUFFER_SIZE_ODD);
+        ASSERT(span[1].data == test_ringbuf.buffer);
+
+        uint32_t len = free_len - (round * 7) % (free_len + 1);
+        for (uint32_t i = 0; i < len; i++)
+        {
+            uint8_t *ptr = i < span[0].len ? span[0].data + i : span[1].data + i - span[0].len;
+            *ptr = (uint8_t)(put_loop + i);
+        }
+        // nothing visible before commit.
+        ASSERT(simple_ringbuffer_size(&test_ringbuf) == TEST_BUFFER_SIZE_ODD - free_len);
+        simple_ringbuffer_commit(&test_ringbuf, len);
+        put_loop += len;
+        ASSERT(simple_ringbuffer_size(&test_ringbuf) == TEST_BUFFER_SIZE_ODD - free_len + len);
+
+        // read in place, release less than peeked.
+        uint32_t used_len = simple_ringbuffer_peek(&test_ringbuf, span);
+        ASSERT(used_len == simple_ringbuffer_size(&test_ringbuf));
+        ASSERT(span[0].len + span[1].len == used_len);
+        for (uint32_t i = 0; i < used_len; i++)
+        {
+            uint8_t *ptr = i < span[0].len ? span[0].data + i : span[1].data + i - span[0].len;
+            ASSERT(*ptr == (uint8_t)(get_loop + i));
+        }
+
+        len = used_len - (round * 13) % (used_len + 1);
+        simple_ringbuffer_consume(&test_ringbuf, len);
+        get_loop += len;
+        ASSERT(simple_ringbuffer_size(&test_ringbuf) == used_len - len);
+    }
+
+    // mix with copy get.
+    uint8_t rdata[TEST_BUFFER_SIZE_ODD];
+    uint32_t len = simple_ringbuffer_get(&test_ringbuf, rdata, sizeof(rdata));
+    ASSERT(len == put_loop - get_loop);
+    for (uint32_t i = 0; i < len; i++)
+    {
+        ASSERT(rdata[i] == (uint8_t)(get_loop + i));
+    }
+    ASSERT(simple_ringbuffer_peek(&test_ringbuf, span) == 0);
+    ASSERT(span[0].len == 0 && span[1].len == 0);
+
+    SUITE_END();
+}
+
+static void test_work_overwrite_ringbuf(simple_ringbuffer_t *ringbuf)
+{
+    uint32_t total_size = simple_ringbuffer_total_size(ringbuf);
+    uint8_t data[TEST_BUFFER_SIZE_ODD * 2];
+    uint8_t rdata[TEST_BUFFER_SIZE_ODD * 2];
+    uint32_t put_pos = 0; // stream offset of the next byte put
+    uint32_t get_pos = 0; // stream offset of the oldest byte kept
+    uint32_t overwritten = 0;
+
+    for (int round = 0; round < 500; round++)
+    {
+        uint32_t len = (round * 89) % sizeof(data);
+        uint32_t keep = len < total_size ? len : total_size;
+        uint32_t used = put_pos - get_pos;
+        uint32_t dropped = (len - keep) + (used + keep > total_size ? used + keep - total_size : 0);
+
+        for (uint32_t i = 0; i < len; i++)
+        {
+            data[i] = (uint8_t)(put_pos + i);
+        }
+        ASSERT(simple_ringbuffer_put_overwrite(ringbuf, data, len) == dropped);
+        put_pos += len;
+        if (put_pos - get_pos > total_size)
+        {
+            get_pos = put_pos - total_size;
+        }
+        overwritten += dropped;
+        ASSERT(simple_ringbuffer_overwritten(ringbuf) == overwritten);
+        ASSERT(simple_ringbuffer_size(ringbuf) == put_pos - get_pos);
+
+        // the newest bytes, oldest first.
+        len = (round * 53) % sizeof(rdata);
+        uint32_t expect = len < put_pos - get_pos ? len : put_pos - get_pos;
+        ASSERT(simple_ringbuffer_get_overwrite(ringbuf, rdata, len) == expect);
+        for (uint32_t i = 0; i < expect; i++)
+        {
+            ASSERT(rdata[i] == (uint8_t)(get_pos + i));
+        }
+        get_pos += expect;
+    }
+}
+
+static void test_work_overwrite_odd(void)
+{
+    SUITE_START("test_work_overwrite_odd");
+
+    SIMPLE_RINGBUFFER_DEFINE(test_ringbuf, TEST_BUFFER_SIZE_ODD);
+    SIMPLE_RINGBUFFER_DEFINE(test_ringbuf_pow2, 256);
+    uint8_t data[TEST_BUFFER_SIZE_ODD];
+    uint8_t rdata[TEST_BUFFER_SIZE_ODD];
+
+    SIMPLE_RINGBUFFER_INIT(test_ringbuf, TEST_BUFFER_SIZE_ODD);
+    SIMPLE_RINGBUFFER_INIT(test_ringbuf_pow2, 256);
+
+    // a full RINGBUF keeps the newest bytes.
+    for (uint32_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = (uint8_t)i;
+    }
+    ASSERT(simple_ringbuffer_put_overwrite(&test_ringbuf, data, 200) == 0);
+    ASSERT(simple_ringbuffer_put_overwrite(&test_ringbuf, data + 200, 57) == 0);
+    ASSERT(simple_ringbuffer_is_full(&test_ringbuf) == 1);
+    ASSERT(simple_ringbuffer_put_overwrite(&test_ringbuf, data, 10) == 10);
+    ASSERT(simple_ringbuffer_is_full(&test_ringbuf) == 1);
+    ASSERT(simple_ringbuffer_overwritten(&test_ringbuf) == 10);
+    ASSERT(simple_ringbuffer_get_overwrite(&test_ringbuf, rdata, sizeof(rdata)) ==
+           TEST_BUFFER_SIZE_ODD);
+    ASSERT(memcmp(rdata, data + 10, TEST_BUFFER_SIZE_ODD - 10) == 0);
+    ASSERT(memcmp(rdata + TEST_BUFFER_SIZE_ODD - 10, data, 10) == 0);
+    ASSERT(simple_ringbuffer_is_empty(&test_ringbuf) == 1);
+
+    SIMPLE_RINGBUFFER_INIT(test_ringbuf, TEST_BUFFER_SIZE_ODD);
+    ASSERT(simple_ringbuffer_overwritten(&test_ringbuf) == 0);
+    test_work_overwrite_ringbuf(&test_ringbuf);
+    test_work_overwrite_ringbuf(&test_ringbuf_pow2);
+
+    SUITE_END();
+}
+
+#if SIMPLE_RINGBUFFER_STATS
+static void test_work_stats_odd(void)
+{
+    SUITE_START("test_work_stats_odd");
+
+    SIMPLE_RINGBUFFER_DEFINE(test_ringbuf, TEST_BUFFER_SIZE_ODD);
+
+    SIMPLE_RINGBUFFER_INIT(test_ringbuf, TEST_BUFFER_SIZE_ODD);
+
+    simple_ringbuffer_stats_t stats;
+    simple_ringbuffer_span_t span[2];
+    uint8_t data[TEST_BUFFER_SIZE_ODD] = {0};
+
+    ASSERT(simple_ringbuffer_get(&test_ringbuf, data, 10) == 0);
+    ASSERT(simple_ringbuffer_put(&test_ringbuf, data, 200) == 200);
+    // only 57 fit, up to the end of the storage.
+    ASSERT(simple_ringbuffer_put(&test_ringbuf, data, 100) == 57);
+    ASSERT(simple_ringbuffer_get(&test_ringbuf, data, 150) == 150);
+    ASSERT(simple_ringbuffer_put(&test_ringbuf, data, 100) == 100);
+    ASSERT(simple_ringbuffer_reserve(&test_ringbuf, span) == 50);
+    simple_ringbuffer_commit(&test_ringbuf, 50);
+    ASSERT(simple_ringbuffer_peek(&test_ringbuf, span) == TEST_BUFFER_SIZE_ODD);
+    simple_ringbuffer_consume(&test_ringbuf, TEST_BUFFER_SIZE_ODD);
+    ASSERT(simple_ringbuffer_peek(&test_ringbuf, span) == 0);
+
+    simple_ringbuffer_stats_snapshot(&test_ringbuf, &stats);
+    ASSERT(stats.put_items == 4);
+    ASSERT(stats.put_bytes == 407);
+    ASSERT(stats.put_full == 1);
+    ASSERT(stats.get_items == 2);
+    ASSERT(stats.get_bytes == 407);
+    ASSERT(stats.get_empty == 2);
+    ASSERT(stats.wraps == 1);
+    ASSERT(stats.high_water == TEST_BUFFER_SIZE_ODD);
+
+    // high water of a RINGBUF which never fills.
+    simple_ringbuffer_reset(&test_ringbuf);
+    for (int round = 0; round < 100; round++)
+    {
+        ASSERT(simple_ringbuffer_put(&test_ringbuf, data, 30) == 30);
+        ASSERT(simple_ringbuffer_get(&test_ringbuf, data, 20 + round % 20) == 20 + round % 20);
+    }
+    simple_ringbuffer_stats_snapshot(&test_ringbuf, &stats);
+    ASSERT(stats.put_bytes == 3000 && stats.get_bytes == 2950 && stats.put_full == 0);
+    ASSERT(stats.high_water == 125);
+    ASSERT(stats.wraps == 3000 / TEST_BUFFER_SIZE_ODD);
+
+    SUITE_END();
+}
+#endif
+
+// with 'make STREAM=64' the bigger copies go through the streaming path, unaligned on both sides.
+static void test_work_stream_odd(void)
+{
+    SUITE_START("test_work_stream_odd");
+
+    simple_ringbuffer_t test_ringbuf;
+    uint8_t test_buffer[TEST_BUFFER_SIZE_ODD + 1];
+    uint8_t data[TEST_BUFFER_SIZE_ODD + 16];
+    uint8_t rdata[TEST_BUFFER_SIZE_ODD + 16];
+    uint8_t seq = 0, rseq = 0;
+
+    simple_ringbuffer_init(&test_ringbuf, TEST_BUFFER_SIZE_ODD, test_buffer + 1);
+
+    for (int round = 0; round < 200; round++)
+    {
+        uint32_t n = (uint32_t)(round * 37) % TEST_BUFFER_SIZE_ODD + 1;
+        uint32_t offset = (uint32_t)round % 16;
+
+        for (uint32_t i = 0; i < n; i++)
+        {
+            data[offset + i] = seq + (uint8_t)i;
+        }
+        ASSERT(simple_ringbuffer_put(&test_ringbuf, data + offset, n) == n);
+        seq += (uint8_t)n;
+
+        memset(rdata, 0, sizeof(rdata));
+        ASSERT(simple_ringbuffer_get(&test_ringbuf, rdata + 15 - offset, n) == n);
+        for (uint32_t i = 0; i < n; i++)
+        {
+            ASSERT(rdata[15 - offset + i] == (uint8_t)(rseq + i));
+        }
+        // nothing written past the end of the get
+        ASSERT(15 - offset + n == sizeof(rdata) || rdata[15 - offset + n] == 0);
+        rseq += (uint8_t)n;
+        ASSERT(simple_ringbuffer_is_empty(&test_ringbuf) == 1);
+    }
+
+    SUITE_END();
+}
+
+static void test_work_iov_odd(void)
+{
+    SUITE_START("test_work_iov_odd");
+
+    SIMPLE_RINGBUFFER_DEFINE(test_ringbuf, TEST_BUFFER_SIZE_ODD);
+
+    SIMPLE_RINGBUFFER_INIT(test_ringbuf, TEST_BUFFER_SIZE_ODD);
+
+    uint8_t header[8], body[100], trailer[4];
+    uint8_t rheader[4], rbody[100], rtrailer[8];
+    simple_ringbuffer_span_t iov[3] = {{header, 8}, {body, 0}, {trailer, 4}};
+    simple_ringbuffer_span_t riov[3] = {{rheader, 4}, {rbody, 0}, {rtrailer, 8}};
+    uint8_t seq = 0, rseq = 0;
+
+    // messages of 12 to 111 bytes, read back with other piece boundaries, across the end.
+    for (int round = 0; round < 100; round++)
+    {
+        uint32_t n = (uint32_t)(round * 31) % 100;
+        uint8_t message[112];
+        uint32_t offset = 0;
+
+        iov[1].len = n;
+        riov[1].len = n;
+        for (int i = 0; i < 3; i++)
+        {
+            for (uint32_t j = 0; j < iov[i].len; j++)
+            {
+                iov[i].data[j] = seq++;
+            }
+        }
+        ASSERT(simple_ringbuffer_putv(&test_ringbuf, iov, 3) == n + 12);
+        ASSERT(simple_ringbuffer_size(&test_ringbuf) == n + 12);
+
+        ASSERT(simple_ringbuffer_getv(&test_ringbuf, riov, 3) == n + 12);
+        for (int i = 0; i < 3; i++)
+        {
+            memcpy(message + offset, riov[i].data, riov[i].len);
+            offset += riov[i].len;
+        }
+        for (uint32_t j = 0; j < n + 12; j++)
+        {
+            ASSERT(message[j] == rseq++);
+        }
+        ASSERT(simple_ringbuffer_is_empty(&test_ringbuf) == 1);
+    }
+
+    // all or nothing: a message which does not fit is not put at all.
+    uint8_t data[TEST_BUFFER_SIZE_ODD] = {0};
+    ASSERT(simple_ringbuffer_put(&test_ringbuf, data, TEST_BUFFER_SIZE_ODD - 100) ==
+           TEST_BUFFER_SIZE_ODD - 100);
+    iov[1].len = 89;
+    ASSERT(simple_ringbuffer_putv(&test_ringbuf, iov, 3) == 0);
+    ASSERT(simple_ringbuffer_size(&test_ringbuf) == TEST_BUFFER_SIZE_ODD - 100);
+    iov[1].len = 88;
+    ASSERT(simple_ringbuffer_putv(&test_ringbuf, iov, 3) == 100);
+    ASSERT(simple_ringbuffer_is_full(&test_ringbuf) == 1);
+
+    // and nothing is taken when the RINGBUF holds less than the buffers.
+    ASSERT(simple_ringbuffer_get(&test_ringbuf, data, TEST_BUFFER_SIZE_ODD - 10) ==
+           TEST_BUFFER_SIZE_ODD - 10);
+    riov[1].len = 0;
+    ASSERT(simple_ringbuffer_getv(&test_ringbuf, riov, 3) == 0);
+    ASSERT(simple_ringbuffer_size(&test_ringbuf) == 10);
+    riov[2].len = 6;
+    ASSERT(simple_ringbuffer_getv(&test_ringbuf, riov, 3) == 10);
+    ASSERT(simple_ringbuffer_is_empty(&test_ringbuf) == 1);
+
+    // lengths whose sum overflows a uint32_t.
+    simple_ringbuffer_span_t huge[2] = {{data, 0xffffff00}, {data, 0x200}};
+    ASSERT(simple_ringbuffer_putv(&test_ringbuf, huge, 2) == 0);
+    ASSERT(simple_ringbuffer_getv(&test_ringbuf, huge, 2) == 0);
+
+    SUITE_END();
+}
+
+#define TEST_BUFFER_SIZE_POW2 256
+
+static void test_work_pow2(void)
+{
+    SUITE_START("test_work_pow2");
+
+    SIMPLE_RINGBUFFER_DEFINE(test_ringbuf, TEST_BUFFER_SIZE_POW2);
+    SIMPLE_RINGBUFFER_DEFINE(test_ringbuf_odd, TEST_BUFFER_SIZE_ODD);
+
+    // the mask based wrap is only selected for a power of 2 size.
+    ASSERT(test_ringbuf.index_mask == (TEST_BUFFER_SIZE_POW2 << 1) - 1);
+    ASSERT(test_ringbuf_odd.index_mask == 0);
+
+    SIMPLE_RINGBUFFER_INIT(test_ringbuf, TEST_BUFFER_SIZE_POW2);
+    SIMPLE_RINGBUFFER_INIT(test_ringbuf_odd, TEST_BUFFER_SIZE_ODD);
+    ASSERT(test_ringbuf.index_mask == (TEST_BUFFER_SIZE_POW2 << 1) - 1);
+    ASSERT(test_ringbuf_odd.index_mask == 0);
+
+    uint8_t data[TEST_BUFFER_SIZE_ODD + 10];
+    uint8_t rdata[TEST_BUFFER_SIZE_ODD + 10];
+    uint32_t put_loop = 0;
+    uint32_t get_loop = 0;
+
+    // same traffic through both, the indices wrap many times.
+    for (int round = 0; round < 500; round++)
+    {
+        uint32_t len = (round * 37) % sizeof(data);
+        uint32_t size = simple_ringbuffer_size(&test_ringbuf);
+        uint32_t expect = len < TEST_BUFFER_SIZE_POW2 - size ? len : TEST_BUFFER_SIZE_POW2 - size;
+
+        for (uint32_t i = 0; i < len; i++)
+        {
+            data[i] = (uint8_t)(put_loop + i);
+        }
+        ASSERT(simple_ringbuffer_put(&test_ringbuf, data, len) == expect);
+        ASSERT(simple_ringbuffer_put(&test_ringbuf_odd, data, expect) == expect);
+        put_loop += expect;
+        ASSERT(simple_ringbuffer_size(&test_ringbuf) == size + expect);
+        ASSERT(simple_ringbuffer_size(&test_ringbuf_odd) == size + expect);
+        ASSERT(simple_ringbuffer_is_full(&test_ringbuf) ==
+               (size + expect == TEST_BUFFER_SIZE_POW2));
+
+        len = (round * 53) % sizeof(rdata);
+        size = simple_ringbuffer_size(&test_ringbuf);
+        expect = len < size ? len : size;
+        ASSERT(simple_ringbuffer_get(&test_ringbuf, rdata, len) == expect);
+        for (uint32_t i = 0; i < expect; i++)
+        {
+            ASSERT(rdata[i] == (uint8_t)(get_loop + i));
+        }
+        ASSERT(simple_ringbuffer_get(&test_ringbuf_odd, rdata, expect) == expect);
+        for (uint32_t i = 0; i < expect; i++)
+        {
+            ASSERT(rdata[i] == (uint8_t)(get_loop + i));
+        }
+        get_loop += expect;
+        ASSERT(simple_ringbuffer_size(&test_ringbuf) == size - expect);
+    }
+
+    // spans over the wrap point.
+    simple_ringbuffer_span_t span[2];
+    simple_ringbuffer_consume(&test_ringbuf, simple_ringbuffer_size(&test_ringbuf));
+    ASSERT(simple_ringbuffer_reserve(&test_ringbuf, span) == TEST_BUFFER_SIZE_POW2);
+    ASSERT(span[0].len + span[1].len == TEST_BUFFER_SIZE_POW2);
+    ASSERT(span[1].len == 0 || span[0].data + span[0].len ==
+                                       test_ringbuf.buffer + TEST_BUFFER_SIZE_POW2);
+    simple_ringbuffer_commit(&test_ringbuf, TEST_BUFFER_SIZE_POW2);
+    ASSERT(simple_ringbuffer_is_full(&test_ringbuf) == 1);
+    ASSERT(simple_ringbuffer_peek(&test_ringbuf, span) == TEST_BUFFER_SIZE_POW2);
+    simple_ringbuffer_consume(&test_ringbuf, TEST_BUFFER_SIZE_POW2);
+    ASSERT(simple_ringbuffer_is_empty(&test_ringbuf) == 1);
+
+    SUITE_END();
+}
+
+#if defined(__linux__)
+#define TEST_BUFFER_SIZE_MIRROR 5000
+static void test_work_mirror(void)
+{
+    SUITE_START("test_work_mirror");
+
+    simple_ringbuffer_t test_ringbuf;
+    static uint8_t data[TEST_BUFFER_SIZE_MIRROR];
+    static uint8_t rdata[TEST_BUFFER_SIZE_MIRROR];
+
+    ASSERT(simple_ringbuffer_init_mirror(&test_ringbuf, TEST_BUFFER_SIZE_MIRROR) == 0);
+    uint32_t total = simple_ringbuffer_total_size(&test_ringbuf);
+    ASSERT(total >= TEST_BUFFER_SIZE_MIRROR);
+    ASSERT(simple_ringbuffer_is_empty(&test_ringbuf) == 1);
+
+    // both halves are the same memory.
+    test_ringbuf.buffer[3] = 0x5A;
+    ASSERT(test_ringbuf.buffer[total + 3] == 0x5A);
+
+    uint32_t put_loop = 0;
+    uint32_t get_loop = 0;
+    for (int round = 0; round < 20; round++)
+    {
+        uint32_t len = TEST_BUFFER_SIZE_MIRROR - round * 97;
+        for (uint32_t i = 0; i < len; i++)
+        {
+            data[i] = (uint8_t)(put_loop + i);
+        }
+        ASSERT(simple_ringbuffer_put(&test_ringbuf, data, len) == len);
+        put_loop += len;
+
+        // the whole readable region is one pointer, even across the wrap point.
+        uint32_t peek_len;
+        uint8_t *peek = simple_ringbuffer_mirror_peek(&test_ringbuf, &peek_len);
+        ASSERT(peek_len == simple_ringbuffer_size(&test_ringbuf));
+        for (uint32_t i = 0; i < peek_len; i++)
+        {
+            ASSERT(peek[i] == (uint8_t)(get_loop + i));
+        }
+
+        // consume part in place, get the rest.
+        simple_ringbuffer_mirror_consume(&test_ringbuf, peek_len / 3);
+        get_loop += peek_len / 3;
+        len = simple_ringbuffer_get(&test_ringbuf, rdata, sizeof(rdata));
+        ASSERT(len == peek_len - peek_len / 3);
+        for (uint32_t i = 0; i < len; i++)
+        {
+            ASSERT(rdata[i] == (uint8_t)(get_loop + i));
+        }
+        get_loop += len;
+        ASSERT(simple_ringbuffer_is_empty(&test_ringbuf) == 1);
+
+        // write in place, across the wrap point.
+        uint32_t reserve_len;
+        uint8_t *reserve = simple_ringbuffer_mirror_reserve(&test_ringbuf, &reserve_len);
+        ASSERT(reserve_len == total);
+        for (uint32_t i = 0; i < reserve_len; i++)
+        {
+            reserve[i] = (uint8_t)(put_loop + i);
+        }
+        simple_ringbuffer_mirror_commit(&test_ringbuf, reserve_len);
+        put_loop += reserve_len;
+        ASSERT(simple_ringbuffer_is_full(&test_ringbuf) == 1);
+        reserve = simple_ringbuffer_mirror_reserve(&test_ringbuf, &reserve_len);
+        ASSERT(reserve_len == 0);
+
+        while ((len = simple_ringbuffer_get(&test_ringbuf, rdata, sizeof(rdata))) > 0)
+        {
+            for (uint32_t i = 0; i < len; i++)
+            {
+                ASSERT(rdata[i] == (uint8_t)(get_loop + i));
+            }
+            get_loop += len;
+        }
+        ASSERT(get_loop == put_loop);
+    }
+
+    simple_ringbuffer_deinit_mirror(&test_ringbuf);
+    ASSERT(test_ringbuf.buffer == NULL);
+
+    SUITE_END();
+}
+#endif
+
 void test_ringbuffer(void)
 {
     test_work();
@@ -989,4 +1457,17 @@ void test_ringbuffer(void)
     test_work_invalid_odd();
     test_work_full_odd();
     test_work_read_index_big_to_write_index_odd();
+    test_work_span_odd();
+
+    test_work_pow2();
+    test_work_overwrite_odd();
+    test_work_stream_odd();
+    test_work_iov_odd();
+#if SIMPLE_RINGBUFFER_STATS
+    test_work_stats_odd();
+#endif
+
+#if defined(__linux__)
+    test_work_mirror();
+#endif
 }
@@ -423,6 +423,406 @@ static void test_data_work_full_odd(void)
     SUITE_END();
 }
 
+static void test_data_work_n_odd(void)
+{
+    SUITE_START("test_data_work_n_odd");
+
+    static uint32_t test_buffer[TEST_BUFFER_SIZE_ODD];
+    static uint32_t data[TEST_BUFFER_SIZE_ODD + 10];
+    static uint32_t rdata[TEST_BUFFER_SIZE_ODD + 10];
+    simple_data_ringbuffer_t test_ringbuf;
+
+    simple_data_ringbuffer_init(&test_ringbuf, TEST_BUFFER_SIZE_ODD, sizeof(uint32_t),
+                                test_buffer);
+
+    uint32_t put_loop = 0;
+    uint32_t get_loop = 0;
+
+    ASSERT(simple_data_ringbuffer_get_n(&test_ringbuf, rdata, 10) == 0);
+    ASSERT(simple_data_ringbuffer_put_n(&test_ringbuf, data, 0) == 0);
+
+    for (int round = 0; round < 300; round++)
+    {
+        uint16_t n = (round * 37) % (TEST_BUFFER_SIZE_ODD + 10);
+        uint16_t size = simple_data_ringbuffer_size(&test_ringbuf);
+        uint16_t expect = n < TEST_BUFFER_SIZE_ODD - size ? n : TEST_BUFFER_SIZE_ODD - size;
+
+        for (uint16_t i = 0; i < n; i++)
+        {
+            data[i] = put_loop + i;
+        }
+        ASSERT(simple_data_ringbuffer_put_n(&test_ringbuf, data, n) == expect);
+        put_loop += expect;
+        ASSERT(simple_data_ringbuffer_size(&test_ringbuf) == size + expect);
+        ASSERT(simple_data_ringbuffer_is_full(&test_ringbuf) ==
+               (size + expect == TEST_BUFFER_SIZE_ODD));
+
+        n = (round * 53) % (TEST_BUFFER_SIZE_ODD + 10);
+        size = simple_data_ringbuffer_size(&test_ringbuf);
+        expect = n < size ? n : size;
+        ASSERT(simple_data_ringbuffer_get_n(&test_ringbuf, rdata, n) == expect);
+        for (uint16_t i = 0; i < expect; i++)
+        {
+            ASSERT(rdata[i] == get_loop + i);
+        }
+        get_loop += expect;
+        ASSERT(simple_data_ringbuffer_size(&test_ringbuf) == size - expect);
+    }
+
+    // mix with single item calls.
+    ASSERT(simple_data_ringbuffer_get_n(&test_ringbuf, NULL, TEST_BUFFER_SIZE_ODD) ==
+           put_loop - get_loop);
+    ASSERT(simple_data_ringbuffer_put_n(&test_ringbuf, data, 3) == 3);
+    ASSERT(simple_data_ringbuffer_get(&test_ringbuf, rdata) == 1);
+    ASSERT(rdata[0] == data[0]);
+    ASSERT(simple_data_ringbuffer_get_n(&test_ringbuf, rdata, 10) == 2);
+    ASSERT(rdata[0] == data[1] && rdata[1] == data[2]);
+    ASSERT(simple_data_ringbuffer_is_empty(&test_ringbuf) == 1);
+
+    SUITE_END();
+}
+
+static void test_data_work_enqueue_n_odd(void)
+{
+    SUITE_START("test_data_work_enqueue_n_odd");
+
+    static uint32_t test_buffer[TEST_BUFFER_SIZE_ODD];
+    simple_data_ringbuffer_t test_ringbuf;
+
+    simple_data_ringbuffer_init(&test_ringbuf, TEST_BUFFER_SIZE_ODD, sizeof(uint32_t),
+                                test_buffer);
+
+    uint32_t put_loop = 0;
+    uint32_t get_loop = 0;
+    uint32_t *mem;
+
+    ASSERT(simple_data_ringbuffer_dequeue_peek_n(&test_ringbuf, (void **)&mem, 10) == 0);
+    ASSERT(mem == NULL);
+
+    for (int round = 0; round < 300; round++)
+    {
+        // fill a run of slots in place, commit part of it.
+        uint16_t n = (round * 37) % (TEST_BUFFER_SIZE_ODD + 10);
+        uint16_t size = simple_data_ringbuffer_size(&test_ringbuf);
+        uint16_t cnt = simple_data_ringbuffer_enqueue_get_n(&test_ringbuf, (void **)&mem, n);
+        ASSERT(cnt <= n && cnt <= TEST_BUFFER_SIZE_ODD - size);
+        ASSERT(cnt == 0 || mem + cnt <= test_buffer + TEST_BUFFER_SIZE_ODD);
+        // only stops short at the end of the buffer.
+        ASSERT(cnt == n || cnt == TEST_BUFFER_SIZE_ODD - size ||
+               mem + cnt == test_buffer + TEST_BUFFER_SIZE_ODD);
+        for (uint16_t i = 0; i < cnt; i++)
+        {
+            mem[i] = put_loop + i;
+        }
+        ASSERT(simple_data_ringbuffer_size(&test_ringbuf) == size);
+        cnt -= cnt / 4;
+        simple_data_ringbuffer_enqueue_n(&test_ringbuf, cnt);
+        put_loop += cnt;
+        ASSERT(simple_data_ringbuffer_size(&test_ringbuf) == size + cnt);
+
+        // read a run of items in place, dequeue part of it.
+        n = (round * 53) % (TEST_BUFFER_SIZE_ODD + 10);
+        size = simple_data_ringbuffer_size(&test_ringbuf);
+        cnt = simple_data_ringbuffer_dequeue_peek_n(&test_ringbuf, (void **)&mem, n);
+        ASSERT(cnt <= n && cnt <= size);
+        ASSERT(cnt == n || cnt == size || mem + cnt == test_buffer + TEST_BUFFER_SIZE_ODD);
+        for (uint16_t i = 0; i < cnt; i++)
+        {
+            ASSERT(mem[i] == get_loop + i);
+        }
+        cnt -= cnt / 3;
+        simple_data_ringbuffer_dequeue_n(&test_ringbuf, cnt);
+        get_loop += cnt;
+        ASSERT(simple_data_ringbuffer_size(&test_ringbuf) == size - cnt);
+    }
+
+    // the rest comes out in order through the single item API.
+    while ((mem = simple_data_ringbuffer_dequeue_peek(&test_ringbuf)) != NULL)
+    {
+        ASSERT(*mem == get_loop);
+        get_loop++;
+        simple_data_ringbuffer_dequeue(&test_ringbuf);
+    }
+    ASSERT(get_loop == put_loop);
+
+    SUITE_END();
+}
+
+#define TEST_BUFFER_SIZE_POW2 64
+
+static void test_data_work_pow2(void)
+{
+    SUITE_START("test_data_work_pow2");
+
+    SIMPLE_DATA_RINGBUFFER_DEFINE(test_ringbuf, TEST_BUFFER_SIZE_POW2, sizeof(uint32_t));
+    SIMPLE_DATA_RINGBUFFER_DEFINE(test_ringbuf_odd, TEST_BUFFER_SIZE_ODD, sizeof(uint32_t));
+
+    // the mask based wrap is only selected for a power of 2 size.
+    ASSERT(test_ringbuf.index_mask == (TEST_BUFFER_SIZE_POW2 << 1) - 1);
+    ASSERT(test_ringbuf_odd.index_mask == 0);
+
+    SIMPLE_DATA_RINGBUFFER_INIT(test_ringbuf, TEST_BUFFER_SIZE_POW2, sizeof(uint32_t));
+    ASSERT(test_ringbuf.index_mask == (TEST_BUFFER_SIZE_POW2 << 1) - 1);
+
+    static uint32_t data[TEST_BUFFER_SIZE_POW2 + 10];
+    static uint32_t rdata[TEST_BUFFER_SIZE_POW2 + 10];
+    uint32_t put_loop = 0;
+    uint32_t get_loop = 0;
+
+    for (int round = 0; round < 500; round++)
+    {
+        uint16_t n = (round * 37) % (TEST_BUFFER_SIZE_POW2 + 10);
+        uint16_t size = simple_data_ringbuffer_size(&test_ringbuf);
+        uint16_t expect = n < TEST_BUFFER_SIZE_POW2 - size ? n : TEST_BUFFER_SIZE_POW2 - size;
+
+        // odd rounds go item by item, even rounds in a batch.
+        for (uint16_t i = 0; i < n; i++)
+        {
+            data[i] = put_loop + i;
+        }
+        if (round & 1)
+        {
+            for (uint16_t i = 0; i < n; i++)
+            {
+                ASSERT(simple_data_ringbuffer_put(&test_ringbuf, &data[i]) == (i < expect));
+            }
+        }
+        else
+        {
+            ASSERT(simple_data_ringbuffer_put_n(&test_ringbuf, data, n) == expect);
+        }
+        put_loop += expect;
+        ASSERT(simple_data_ringbuffer_size(&test_ringbuf) == size + expect);
+        ASSERT(simple_data_ringbuffer_is_full(&test_ringbuf) ==
+               (size + expect == TEST_BUFFER_SIZE_POW2));
+
+        n = (round * 53) % (TEST_BUFFER_SIZE_POW2 + 10);
+        size = simple_data_ringbuffer_size(&test_ringbuf);
+        expect = n < size ? n : size;
+        if (round & 1)
+        {
+            for (uint16_t i = 0; i < n; i++)
+            {
+                ASSERT(simple_data_ringbuffer_get(&test_ringbuf, &rdata[i]) == (i < expect));
+            }
+        }
+        else
+        {
+            ASSERT(simple_data_ringbuffer_get_n(&test_ringbuf, rdata, n) == expect);
+        }
+        for (uint16_t i = 0; i < expect; i++)
+        {
+            ASSERT(rdata[i] == get_loop + i);
+        }
+        get_loop += expect;
+        ASSERT(simple_data_ringbuffer_size(&test_ringbuf) == size - expect);
+    }
+
+    // in place slots over the wrap point.
+    void *mem;
+    simple_data_ringbuffer_get_n(&test_ringbuf, NULL, TEST_BUFFER_SIZE_POW2);
+    uint16_t n = simple_data_ringbuffer_enqueue_get_n(&test_ringbuf, &mem, TEST_BUFFER_SIZE_POW2);
+    ASSERT(n > 0 && n <= TEST_BUFFER_SIZE_POW2);
+    simple_data_ringbuffer_enqueue_n(&test_ringbuf, n);
+    uint16_t write_index = simple_data_ringbuffer_enqueue_get(&test_ringbuf, &mem);
+    if (n < TEST_BUFFER_SIZE_POW2)
+    {
+        ASSERT(mem == test_ringbuf.buffer);
+        simple_data_ringbuffer_enqueue(&test_ringbuf, write_index);
+        n++;
+    }
+    ASSERT(simple_data_ringbuffer_size(&test_ringbuf) == n);
+    ASSERT(simple_data_ringbuffer_dequeue_peek_n(&test_ringbuf, &mem, n) > 0);
+    simple_data_ringbuffer_dequeue_n(&test_ringbuf, n);
+    ASSERT(simple_data_ringbuffer_is_empty(&test_ringbuf) == 1);
+
+    SUITE_END();
+}
+
+static void test_data_work_overwrite_odd(void)
+{
+    SUITE_START("test_data_work_overwrite_odd");
+
+    SIMPLE_DATA_RINGBUFFER_DEFINE(test_ringbuf, TEST_BUFFER_SIZE_ODD, sizeof(uint32_t));
+    SIMPLE_DATA_RINGBUFFER_DEFINE(test_ringbuf_pow2, TEST_BUFFER_SIZE_POW2, sizeof(uint32_t));
+    simple_data_ringbuffer_t *ringbufs[] = {&test_ringbuf, &test_ringbuf_pow2};
+
+    SIMPLE_DATA_RINGBUFFER_INIT(test_ringbuf, TEST_BUFFER_SIZE_ODD, sizeof(uint32_t));
+    SIMPLE_DATA_RINGBUFFER_INIT(test_ringbuf_pow2, TEST_BUFFER_SIZE_POW2, sizeof(uint32_t));
+
+    for (size_t r = 0; r < sizeof(ringbufs) / sizeof(ringbufs[0]); r++)
+    {
+        simple_data_ringbuffer_t *ringbuf = ringbufs[r];
+        uint32_t total_size = simple_data_ringbuffer_total_size(ringbuf);
+        uint32_t put_seq = 0; // seq of the next item put
+        uint32_t get_seq = 0; // seq of the oldest item kept
+        uint32_t item;
+
+        for (int round = 0; round < 500; round++)
+        {
+            // bursts faster than the reader, which falls behind.
+            uint32_t n = (round * 7) % (total_size * 2);
+            for (uint32_t i = 0; i < n; i++)
+            {
+                item = put_seq++;
+                ASSERT(simple_data_ringbuffer_put_overwrite(ringbuf, &item) ==
+                       (put_seq - get_seq > total_size));
+                if (put_seq - get_seq > total_size)
+                {
+                    get_seq++;
+                }
+                ASSERT(simple_data_ringbuffer_size(ringbuf) == put_seq - get_seq);
+            }
+
+            n = (round * 5) % (total_size + 10);
+            for (uint32_t i = 0; i < n; i++)
+            {
+                int got = simple_data_ringbuffer_get_overwrite(ringbuf, &item);
+                ASSERT(got == (get_seq != put_seq));
+                if (got)
+                {
+                    ASSERT(item == get_seq);
+                    get_seq++;
+                }
+            }
+        }
+
+        // every item put was either get or overwritten.
+        while (simple_data_ringbuffer_get_overwrite(ringbuf, NULL) == 1)
+        {
+            get_seq++;
+        }
+        ASSERT(get_seq == put_seq);
+        ASSERT(simple_data_ringbuffer_overwritten(ringbuf) != 0);
+    }
+
+    SUITE_END();
+}
+
+#if SIMPLE_RINGBUFFER_STATS
+static void test_data_work_stats_odd(void)
+{
+    SUITE_START("test_data_work_stats_odd");
+
+    SIMPLE_DATA_RINGBUFFER_DEFINE(test_ringbuf, TEST_BUFFER_SIZE_ODD, sizeof(uint32_t));
+
+    SIMPLE_DATA_RINGBUFFER_INIT(test_ringbuf, TEST_BUFFER_SIZE_ODD, sizeof(uint32_t));
+
+    simple_ringbuffer_stats_t stats;
+    uint32_t item_size = simple_data_ringbuffer_item_size(&test_ringbuf);
+    uint32_t data[TEST_BUFFER_SIZE_ODD + 43] = {0};
+    void *mem;
+
+    ASSERT(simple_data_ringbuffer_get(&test_ringbuf, data) == 0);
+    for (uint32_t i = 0; i < TEST_BUFFER_SIZE_ODD; i++)
+    {
+        ASSERT(simple_data_ringbuffer_put(&test_ringbuf, data) == 1);
+    }
+    ASSERT(simple_data_ringbuffer_put(&test_ringbuf, data) == 0);
+    for (uint32_t i = 0; i < 7; i++)
+    {
+        ASSERT(simple_data_ringbuffer_dequeue_peek(&test_ringbuf) != NULL);
+        simple_data_ringbuffer_dequeue(&test_ringbuf);
+    }
+    // only 7 fit.
+    ASSERT(simple_data_ringbuffer_put_n(&test_ringbuf, data, 10) == 7);
+    ASSERT(simple_data_ringbuffer_get_n(&test_ringbuf, data, TEST_BUFFER_SIZE_ODD + 43) ==
+           TEST_BUFFER_SIZE_ODD);
+    int index = simple_data_ringbuffer_enqueue_get(&test_ringbuf, &mem);
+    ASSERT(mem != NULL);
+    simple_data_ringbuffer_enqueue(&test_ringbuf, index);
+    ASSERT(simple_data_ringbuffer_dequeue_peek_n(&test_ringbuf, &mem, 5) == 1);
+    simple_data_ringbuffer_dequeue_n(&test_ringbuf, 1);
+    ASSERT(simple_data_ringbuffer_dequeue_peek(&test_ringbuf) == NULL);
+
+    simple_data_ringbuffer_stats_snapshot(&test_ringbuf, &stats);
+    ASSERT(stats.put_items == TEST_BUFFER_SIZE_ODD + 8);
+    ASSERT(stats.put_bytes == (TEST_BUFFER_SIZE_ODD + 8) * item_size);
+    ASSERT(stats.put_full == 2);
+    ASSERT(stats.get_items == TEST_BUFFER_SIZE_ODD + 8);
+    ASSERT(stats.get_bytes == (TEST_BUFFER_SIZE_ODD + 8) * item_size);
+    ASSERT(stats.get_empty == 2);
+    ASSERT(stats.wraps == 1);
+    ASSERT(stats.high_water == TEST_BUFFER_SIZE_ODD);
+
+    simple_data_ringbuffer_reset(&test_ringbuf);
+    simple_data_ringbuffer_stats_snapshot(&test_ringbuf, &stats);
+    ASSERT(stats.put_items == 0 && stats.get_items == 0 && stats.high_water == 0);
+
+    SUITE_END();
+}
+#endif
+
+#if SIMPLE_DATA_RINGBUFFER_WIDE
+#define TEST_BUFFER_SIZE_WIDE      70001
+#define TEST_BUFFER_SIZE_WIDE_BIG  3
+#define TEST_USER_DATA_SIZE_WIDE   0x18000
+
+static void test_data_work_wide(void)
+{
+    SUITE_START("test_data_work_wide");
+
+    // more items than the compact layout can index.
+    static uint32_t test_buffer[TEST_BUFFER_SIZE_WIDE];
+    static uint32_t data[TEST_BUFFER_SIZE_WIDE];
+    simple_data_ringbuffer_t test_ringbuf;
+
+    simple_data_ringbuffer_init(&test_ringbuf, TEST_BUFFER_SIZE_WIDE, sizeof(uint32_t),
+                                test_buffer);
+
+    for (uint32_t round = 0; round < 3; round++)
+    {
+        for (uint32_t i = 0; i < TEST_BUFFER_SIZE_WIDE; i++)
+        {
+            data[i] = round * TEST_BUFFER_SIZE_WIDE + i;
+        }
+        // a part item by item, the rest in a batch, the wrap point moves every round.
+        for (uint32_t i = 0; i < 1000 * round; i++)
+        {
+            ASSERT(simple_data_ringbuffer_put(&test_ringbuf, &data[i]) == 1);
+        }
+        ASSERT(simple_data_ringbuffer_put_n(&test_ringbuf, &data[1000 * round],
+                                            TEST_BUFFER_SIZE_WIDE) ==
+               TEST_BUFFER_SIZE_WIDE - 1000 * round);
+        ASSERT(simple_data_ringbuffer_is_full(&test_ringbuf) == 1);
+        ASSERT(simple_data_ringbuffer_size(&test_ringbuf) == TEST_BUFFER_SIZE_WIDE);
+
+        memset(data, 0, sizeof(data));
+        ASSERT(simple_data_ringbuffer_get_n(&test_ringbuf, data, TEST_BUFFER_SIZE_WIDE - 7) ==
+               TEST_BUFFER_SIZE_WIDE - 7);
+        for (uint32_t i = TEST_BUFFER_SIZE_WIDE - 7; i < TEST_BUFFER_SIZE_WIDE; i++)
+        {
+            ASSERT(simple_data_ringbuffer_get(&test_ringbuf, &data[i]) == 1);
+        }
+        for (uint32_t i = 0; i < TEST_BUFFER_SIZE_WIDE; i++)
+        {
+            ASSERT(data[i] == round * TEST_BUFFER_SIZE_WIDE + i);
+        }
+        ASSERT(simple_data_ringbuffer_is_empty(&test_ringbuf) == 1);
+    }
+
+    // items bigger than 64 KB.
+    static uint8_t test_big_buffer[TEST_BUFFER_SIZE_WIDE_BIG][TEST_USER_DATA_SIZE_WIDE];
+    static uint8_t big[TEST_USER_DATA_SIZE_WIDE];
+
+    simple_data_ringbuffer_init(&test_ringbuf, TEST_BUFFER_SIZE_WIDE_BIG,
+                                TEST_USER_DATA_SIZE_WIDE, test_big_buffer);
+    ASSERT(simple_data_ringbuffer_item_size(&test_ringbuf) == TEST_USER_DATA_SIZE_WIDE);
+    for (uint32_t loop = 0; loop < 10; loop++)
+    {
+        memset(big, loop, sizeof(big));
+        big[TEST_USER_DATA_SIZE_WIDE - 1] = ~loop;
+        ASSERT(simple_data_ringbuffer_put(&test_ringbuf, big) == 1);
+        memset(big, 0, sizeof(big));
+        ASSERT(simple_data_ringbuffer_get(&test_ringbuf, big) == 1);
+        ASSERT(big[0] == (uint8_t)loop && big[0x10000] == (uint8_t)loop);
+        ASSERT(big[TEST_USER_DATA_SIZE_WIDE - 1] == (uint8_t)~loop);
+    }
+
+    SUITE_END();
+}
+#endif
+
 void test_data_ringbuffer(void)
 {
     test_data_work();
@@ -432,4 +832,16 @@ void test_data_ringbuffer(void)
 
     test_data_work_odd();
     test_data_work_full_odd();
+    test_data_work_n_odd();
+    test_data_work_enqueue_n_odd();
+
+    test_data_work_pow2();
+    test_data_work_overwrite_odd();
+#if SIMPLE_RINGBUFFER_STATS
+    test_data_work_stats_odd();
+#endif
+
+#if SIMPLE_DATA_RINGBUFFER_WIDE
+    test_data_work_wide();
+#endif
 }
@@ -0,0 +1,230 @@
+#include <stdio.h>
+#include <string.h>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "simple_shm_ringbuffer.h"
+
+//
+// Tests
+//
+static const char *suite_name;
+static char suite_pass;
+static int suites_run = 0, suites_failed = 0, suites_empty = 0;
+static int tests_in_suite = 0, tests_run = 0, tests_failed = 0;
+
+#define QUOTE(str) #str
+#define ASSERT(x)                                                                                  \
+    {                                                                                              \
+        tests_run++;                                                                               \
+        tests_in_suite++;                                                                          \
+        if (!(x))                                                                                  \
+        {                                                                                          \
+            printf("failed assert [%s:%i] %s\n", __FILE__, __LINE__, QUOTE(x));                    \
+            suite_pass = 0;                                                                        \
+            tests_failed++;                                                                        \
+            while (1)                                                                              \
+                ;                                                                                  \
+        }                                                                                          \
+    }
+
+static void SUITE_START(const char *name)
+{
+    suite_pass = 1;
+    suite_name = name;
+    suites_run++;
+    tests_in_suite = 0;
+}
+
+static void SUITE_END(void)
+{
+    printf("Testing %s ", suite_name);
+    size_t suite_i;
+    for (suite_i = strlen(suite_name); suite_i < 80 - 8 - 5; suite_i++)
+        printf(".");
+    printf("%s\n", suite_pass ? " pass" : " fail");
+    if (!suite_pass)
+        suites_failed++;
+    if (!tests_in_suite)
+        suites_empty++;
+}
+
+#if defined(__linux__)
+#define TEST_BUFFER_SIZE_ODD 257
+#define TEST_SHM_LOOP_CNT    100000
+
+static void test_shm_name(char *name, size_t size)
+{
+    snprintf(name, size, "/simple_ringbuffer_test_%ld", (long)getpid());
+}
+
+static void test_shm_work_odd(void)
+{
+    SUITE_START("test_shm_work_odd");
+
+    simple_shm_ringbuffer_t producer;
+    simple_shm_ringbuffer_t consumer;
+    simple_ringbuffer_span_t span[2];
+    uint8_t data[TEST_BUFFER_SIZE_ODD + 10];
+    uint8_t rdata[TEST_BUFFER_SIZE_ODD + 10];
+    char name[64];
+
+    for (uint32_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = (uint8_t)i;
+    }
+    test_shm_name(name, sizeof(name));
+
+    ASSERT(simple_shm_ringbuffer_attach(&consumer, name) == -1);
+    ASSERT(simple_shm_ringbuffer_create(&producer, name, 0) == -1);
+    ASSERT(simple_shm_ringbuffer_create(&producer, name, TEST_BUFFER_SIZE_ODD) == 0);
+    ASSERT(simple_shm_ringbuffer_create(&consumer, name, TEST_BUFFER_SIZE_ODD) == -1);
+
+    // a second mapping of the same object: another address, the same RINGBUF.
+    ASSERT(simple_shm_ringbuffer_attach(&consumer, name) == 0);
+    ASSERT(consumer.header != producer.header);
+    ASSERT(consumer.total_size == TEST_BUFFER_SIZE_ODD);
+    ASSERT(simple_shm_ringbuffer_is_empty(&consumer) == 1);
+
+    ASSERT(simple_shm_ringbuffer_put(&producer, data, 200) == 200);
+    ASSERT(simple_shm_ringbuffer_size(&consumer) == 200);
+    ASSERT(simple_shm_ringbuffer_get(&consumer, rdata, 150) == 150);
+    ASSERT(memcmp(rdata, data, 150) == 0);
+
+    // wraps around the end of storage.
+    ASSERT(simple_shm_ringbuffer_put(&producer, data, sizeof(data)) == TEST_BUFFER_SIZE_ODD - 50);
+    ASSERT(simple_shm_ringbuffer_put(&producer, data, 1) == 0);
+    ASSERT(simple_shm_ringbuffer_peek(&consumer, span) == TEST_BUFFER_SIZE_ODD);
+    ASSERT(span[0].len == TEST_BUFFER_SIZE_ODD - 150);
+    ASSERT(memcmp(span[0].data, data + 150, 50) == 0);
+    ASSERT(memcmp(span[0].data + 50, data, span[0].len - 50) == 0);
+    ASSERT(memcmp(span[1].data, data + span[0].len - 50, span[1].len) == 0);
+    simple_shm_ringbuffer_consume(&consumer, TEST_BUFFER_SIZE_ODD);
+    ASSERT(simple_shm_ringbuffer_is_empty(&producer) == 1);
+
+    // zero copy on the producer side.
+    ASSERT(simple_shm_ringbuffer_reserve(&producer, span) == TEST_BUFFER_SIZE_ODD);
+    memcpy(span[0].data, data, 10);
+    simple_shm_ringbuffer_commit(&producer, 10);
+    ASSERT(simple_shm_ringbuffer_get(&consumer, rdata, sizeof(rdata)) == 10);
+    ASSERT(memcmp(rdata, data, 10) == 0);
+
+#if SIMPLE_RINGBUFFER_STATS
+    // each handle only counted its own side.
+    simple_ringbuffer_stats_t stats;
+    simple_shm_ringbuffer_stats_snapshot(&producer, &stats);
+    ASSERT(stats.put_items == 3 && stats.put_bytes == 417);
+    ASSERT(stats.put_full == 2);
+    ASSERT(stats.wraps == 1);
+    ASSERT(stats.high_water == TEST_BUFFER_SIZE_ODD);
+    ASSERT(stats.get_items == 0 && stats.get_bytes == 0 && stats.get_empty == 0);
+    simple_shm_ringbuffer_stats_snapshot(&consumer, &stats);
+    ASSERT(stats.get_items == 3 && stats.get_bytes == 417);
+    ASSERT(stats.get_empty == 0);
+    ASSERT(stats.put_items == 0 && stats.put_full == 0 && stats.high_water == 0);
+#endif
+
+    // indices left out of range by a broken peer are not trusted.
+    uint32_t write_index = atomic_load(&producer.header->write_index);
+    atomic_store(&producer.header->write_index, TEST_BUFFER_SIZE_ODD * 2);
+    ASSERT(simple_shm_ringbuffer_get(&consumer, rdata, sizeof(rdata)) == 0);
+    ASSERT(simple_shm_ringbuffer_peek(&consumer, span) == 0);
+    ASSERT(span[0].len == 0 && span[1].len == 0);
+    ASSERT(simple_shm_ringbuffer_put(&producer, data, 10) == 0);
+    ASSERT(simple_shm_ringbuffer_reserve(&producer, span) == 0);
+    atomic_store(&producer.header->write_index,
+                 (write_index + TEST_BUFFER_SIZE_ODD + 1) % (TEST_BUFFER_SIZE_ODD * 2));
+    ASSERT(simple_shm_ringbuffer_get(&consumer, rdata, sizeof(rdata)) == 0);
+    ASSERT(simple_shm_ringbuffer_put(&producer, data, 10) == 0);
+    atomic_store(&producer.header->write_index, write_index);
+    ASSERT(simple_shm_ringbuffer_put(&producer, data, 10) == 10);
+    ASSERT(simple_shm_ringbuffer_get(&consumer, rdata, sizeof(rdata)) == 10);
+
+    simple_shm_ringbuffer_detach(&consumer);
+    simple_shm_ringbuffer_detach(&producer);
+    ASSERT(simple_shm_ringbuffer_unlink(name) == 0);
+    ASSERT(simple_shm_ringbuffer_attach(&consumer, name) == -1);
+
+    SUITE_END();
+}
+
+static void test_shm_work_fork(void)
+{
+    SUITE_START("test_shm_work_fork");
+
+    simple_shm_ringbuffer_t consumer;
+    char name[64];
+    int status;
+
+    test_shm_name(name, sizeof(name));
+    ASSERT(simple_shm_ringbuffer_create(&consumer, name, TEST_BUFFER_SIZE_ODD) == 0);
+
+    pid_t pid = fork();
+    ASSERT(pid >= 0);
+    if (pid == 0)
+    {
+        // child: an unrelated mapping of the object, found by name.
+        simple_shm_ringbuffer_t producer;
+        uint8_t data[64];
+        uint32_t seq = 0;
+
+        simple_shm_ringbuffer_detach(&consumer);
+        if (simple_shm_ringbuffer_attach(&producer, name) != 0)
+        {
+            _exit(1);
+        }
+        while (seq < TEST_SHM_LOOP_CNT)
+        {
+            uint32_t len = (seq % sizeof(data)) + 1;
+            if (len > TEST_SHM_LOOP_CNT - seq)
+            {
+                len = TEST_SHM_LOOP_CNT - seq;
+            }
+            for (uint32_t i = 0; i < len; i++)
+            {
+                data[i] = (uint8_t)(seq + i);
+            }
+            seq += simple_shm_ringbuffer_put(&producer, data, len);
+        }
+        simple_shm_ringbuffer_detach(&producer);
+        _exit(0);
+    }
+
+    int data_ok = 1;
+    uint32_t seq = 0;
+    while (seq < TEST_SHM_LOOP_CNT)
+    {
+        simple_ringbuffer_span_t span[2];
+        uint32_t len = simple_shm_ringbuffer_peek(&consumer, span);
+
+        for (uint32_t i = 0; i < span[0].len; i++)
+        {
+            data_ok &= (span[0].data[i] == (uint8_t)(seq + i));
+        }
+        for (uint32_t i = 0; i < span[1].len; i++)
+        {
+            data_ok &= (span[1].data[i] == (uint8_t)(seq + span[0].len + i));
+        }
+        simple_shm_ringbuffer_consume(&consumer, len);
+        seq += len;
+    }
+
+    ASSERT(waitpid(pid, &status, 0) == pid);
+    ASSERT(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    ASSERT(data_ok == 1);
+    ASSERT(simple_shm_ringbuffer_is_empty(&consumer) == 1);
+    simple_shm_ringbuffer_detach(&consumer);
+    ASSERT(simple_shm_ringbuffer_unlink(name) == 0);
+
+    SUITE_END();
+}
+#endif
+
+void test_shm_ringbuffer(void)
+{
+#if defined(__linux__)
+    test_shm_work_odd();
+    test_shm_work_fork();
+#endif
+}
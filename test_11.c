@@ -0,0 +1,251 @@
+#include <stdio.h>
+#include <signal.h>
+#include <string.h>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "simple_data_ringbuffer_file.h"
+
+//
+// Tests
+//
+static const char *suite_name;
+static char suite_pass;
+static int suites_run = 0, suites_failed = 0, suites_empty = 0;
+static int tests_in_suite = 0, tests_run = 0, tests_failed = 0;
+
+#define QUOTE(str) #str
+#define ASSERT(x)                                                                                  \
+    {                                                                                              \
+        tests_run++;                                                                               \
+        tests_in_suite++;                                                                          \
+        if (!(x))                                                                                  \
+        {                                                                                          \
+            printf("failed assert [%s:%i] %s\n", __FILE__, __LINE__, QUOTE(x));                    \
+            suite_pass = 0;                                                                        \
+            tests_failed++;                                                                        \
+            while (1)                                                                              \
+                ;                                                                                  \
+        }                                                                                          \
+    }
+
+static void SUITE_START(const char *name)
+{
+    suite_pass = 1;
+    suite_name = name;
+    suites_run++;
+    tests_in_suite = 0;
+}
+
+static void SUITE_END(void)
+{
+    printf("Testing %s ", suite_name);
+    size_t suite_i;
+    for (suite_i = strlen(suite_name); suite_i < 80 - 8 - 5; suite_i++)
+        printf(".");
+    printf("%s\n", suite_pass ? " pass" : " fail");
+    if (!suite_pass)
+        suites_failed++;
+    if (!tests_in_suite)
+        suites_empty++;
+}
+
+#if defined(__linux__)
+#define TEST_BUFFER_SIZE_ODD 257
+
+struct test_user_data
+{
+    uint32_t seq;
+    uint32_t check;
+};
+
+static void test_file_path(char *path, size_t size)
+{
+    snprintf(path, size, "/tmp/simple_ringbuffer_test_%ld.ring", (long)getpid());
+}
+
+static void test_file_work_odd(void)
+{
+    SUITE_START("test_file_work_odd");
+
+    static const simple_data_ringbuffer_flush_t flushes[] = {
+            SIMPLE_DATA_RINGBUFFER_FLUSH_NONE, SIMPLE_DATA_RINGBUFFER_FLUSH_ASYNC,
+            SIMPLE_DATA_RINGBUFFER_FLUSH_SYNC};
+    char path[64];
+
+    test_file_path(path, sizeof(path));
+    for (size_t f = 0; f < sizeof(flushes) / sizeof(flushes[0]); f++)
+    {
+        simple_data_ringbuffer_file_t file;
+        struct test_user_data item;
+        uint32_t seq;
+
+        remove(path);
+        ASSERT(simple_data_ringbuffer_file_open(&file, path, TEST_BUFFER_SIZE_ODD,
+                                                sizeof(struct test_user_data), flushes[f]) == 0);
+        ASSERT(simple_data_ringbuffer_is_empty(file.ringbuf) == 1);
+
+        // wrap the indices before the restart.
+        for (seq = 0; seq < TEST_BUFFER_SIZE_ODD + 100; seq++)
+        {
+            item.seq = seq;
+            item.check = ~seq;
+            ASSERT(simple_data_ringbuffer_put(file.ringbuf, &item) == 1);
+            if (seq % 2 == 0)
+            {
+                ASSERT(simple_data_ringbuffer_get(file.ringbuf, NULL) == 1);
+            }
+        }
+        ASSERT(simple_data_ringbuffer_file_sync(&file) == 0);
+        uint32_t size = simple_data_ringbuffer_size(file.ringbuf);
+        simple_data_ringbuffer_file_close(&file);
+
+        // the same items after the restart, in order.
+        ASSERT(simple_data_ringbuffer_file_open(&file, path, TEST_BUFFER_SIZE_ODD,
+                                                sizeof(struct test_user_data), flushes[f]) == 0);
+        ASSERT(simple_data_ringbuffer_size(file.ringbuf) == size);
+        for (seq = (TEST_BUFFER_SIZE_ODD + 100) - size; seq < TEST_BUFFER_SIZE_ODD + 100; seq++)
+        {
+            struct test_user_data *mem = simple_data_ringbuffer_dequeue_peek(file.ringbuf);
+            ASSERT(mem != NULL && mem->seq == seq && mem->check == ~seq);
+            simple_data_ringbuffer_dequeue(file.ringbuf);
+        }
+        ASSERT(simple_data_ringbuffer_is_empty(file.ringbuf) == 1);
+        simple_data_ringbuffer_file_close(&file);
+
+        // the file only fits the RINGBUF it was created for.
+        ASSERT(simple_data_ringbuffer_file_open(&file, path, TEST_BUFFER_SIZE_ODD + 1,
+                                                sizeof(struct test_user_data), flushes[f]) == -1);
+        ASSERT(simple_data_ringbuffer_file_open(&file, path, TEST_BUFFER_SIZE_ODD, 4,
+                                                flushes[f]) == -1);
+
+        // indices which hold more than total_size items are a corrupt file.
+        ASSERT(simple_data_ringbuffer_file_open(&file, path, TEST_BUFFER_SIZE_ODD,
+                                                sizeof(struct test_user_data), flushes[f]) == 0);
+        uint32_t read_index = SIMPLE_RINGBUFFER_LOAD_RELAXED(file.ringbuf->read_index);
+        SIMPLE_RINGBUFFER_STORE_RELAXED(file.ringbuf->write_index,
+                                        (read_index + TEST_BUFFER_SIZE_ODD + 1) %
+                                                (TEST_BUFFER_SIZE_ODD * 2));
+        simple_data_ringbuffer_file_close(&file);
+        ASSERT(simple_data_ringbuffer_file_open(&file, path, TEST_BUFFER_SIZE_ODD,
+                                                sizeof(struct test_user_data), flushes[f]) == -1);
+    }
+    remove(path);
+
+    SUITE_END();
+}
+
+static void test_file_work_crash(void)
+{
+    SUITE_START("test_file_work_crash");
+
+    simple_data_ringbuffer_file_t file;
+    char path[64];
+    int status;
+
+    test_file_path(path, sizeof(path));
+    remove(path);
+
+    pid_t pid = fork();
+    ASSERT(pid >= 0);
+    if (pid == 0)
+    {
+        // child: queue some items, leave one uncommitted, and die without closing.
+        struct test_user_data *mem;
+
+        if (simple_data_ringbuffer_file_open(&file, path, TEST_BUFFER_SIZE_ODD,
+                                             sizeof(struct test_user_data),
+                                             SIMPLE_DATA_RINGBUFFER_FLUSH_NONE) != 0)
+        {
+            _exit(1);
+        }
+        for (uint32_t seq = 0; seq < 100; seq++)
+        {
+            struct test_user_data item = {.seq = seq, .check = ~seq};
+            simple_data_ringbuffer_put(file.ringbuf, &item);
+        }
+        simple_data_ringbuffer_get(file.ringbuf, NULL);
+        simple_data_ringbuffer_enqueue_get(file.ringbuf, (void **)&mem);
+        mem->seq = 0xdead;
+        raise(SIGKILL);
+        _exit(1);
+    }
+
+    ASSERT(waitpid(pid, &status, 0) == pid);
+    ASSERT(WIFSIGNALED(status) && WTERMSIG(status) == SIGKILL);
+
+    // exactly the committed items, the one in limbo is not.
+    ASSERT(simple_data_ringbuffer_file_open(&file, path, TEST_BUFFER_SIZE_ODD,
+                                            sizeof(struct test_user_data),
+                                            SIMPLE_DATA_RINGBUFFER_FLUSH_NONE) == 0);
+    ASSERT(simple_data_ringbuffer_size(file.ringbuf) == 99);
+    int data_ok = 1;
+    for (uint32_t seq = 1; seq < 100; seq++)
+    {
+        struct test_user_data item;
+        data_ok &= simple_data_ringbuffer_get(file.ringbuf, &item);
+        data_ok &= (item.seq == seq) && (item.check == ~seq);
+    }
+    ASSERT(data_ok == 1);
+    ASSERT(simple_data_ringbuffer_is_empty(file.ringbuf) == 1);
+    simple_data_ringbuffer_file_close(&file);
+    remove(path);
+
+    SUITE_END();
+}
+
+static void test_file_work_flush(void)
+{
+    SUITE_START("test_file_work_flush");
+
+    simple_data_ringbuffer_file_t file;
+    struct test_user_data items[8] = {0};
+    struct test_user_data *mem;
+    char path[64];
+    int err;
+
+    test_file_path(path, sizeof(path));
+    remove(path);
+    ASSERT(simple_data_ringbuffer_file_open(&file, path, TEST_BUFFER_SIZE_ODD,
+                                            sizeof(struct test_user_data),
+                                            SIMPLE_DATA_RINGBUFFER_FLUSH_SYNC) == 0);
+
+    // every put syncs by default.
+    ASSERT(simple_data_ringbuffer_file_put(&file, &items[0]) == 1);
+    ASSERT(file.unflushed == 0);
+
+    // every 4 items, whatever call put them.
+    simple_data_ringbuffer_file_set_flush_interval(&file, 4);
+    ASSERT(simple_data_ringbuffer_file_put(&file, &items[0]) == 1);
+    ASSERT(simple_data_ringbuffer_file_put_n(&file, items, 2, &err) == 2 && err == 0);
+    ASSERT(file.unflushed == 3);
+    ASSERT(simple_data_ringbuffer_enqueue_get_n(file.ringbuf, (void **)&mem, 1) == 1);
+    ASSERT(simple_data_ringbuffer_file_enqueue_n(&file, 1) == 0);
+    ASSERT(file.unflushed == 0);
+    ASSERT(simple_data_ringbuffer_file_put_n(&file, items, 8, &err) == 8 && err == 0);
+    ASSERT(file.unflushed == 0);
+
+    // only explicit syncs.
+    simple_data_ringbuffer_file_set_flush_interval(&file, 0);
+    ASSERT(simple_data_ringbuffer_file_put(&file, &items[0]) == 1);
+    ASSERT(file.unflushed == 1);
+    ASSERT(simple_data_ringbuffer_file_sync(&file) == 0);
+    ASSERT(file.unflushed == 0);
+    ASSERT(simple_data_ringbuffer_size(file.ringbuf) == 14);
+
+    simple_data_ringbuffer_file_close(&file);
+    remove(path);
+
+    SUITE_END();
+}
+#endif
+
+void test_file_ringbuffer(void)
+{
+#if defined(__linux__)
+    test_file_work_odd();
+    test_file_work_crash();
+    test_file_work_flush();
+#endif
+}
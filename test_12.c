@@ -0,0 +1,193 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "simple_data_ringbuffer.h"
+#include "simple_ringbuffer.h"
+#include "simple_ringbuffer_copy.h"
+
+//
+// Tests
+//
+static const char *suite_name;
+static char suite_pass;
+static int suites_run = 0, suites_failed = 0, suites_empty = 0;
+static int tests_in_suite = 0, tests_run = 0, tests_failed = 0;
+
+#define QUOTE(str) #str
+#define ASSERT(x)                                                                                  \
+    {                                                                                              \
+        tests_run++;                                                                               \
+        tests_in_suite++;                                                                          \
+        if (!(x))                                                                                  \
+        {                                                                                          \
+            printf("failed assert [%s:%i] %s\n", __FILE__, __LINE__, QUOTE(x));                    \
+            suite_pass = 0;                                                                        \
+            tests_failed++;                                                                        \
+            while (1)                                                                              \
+                ;                                                                                  \
+        }                                                                                          \
+    }
+
+static void SUITE_START(const char *name)
+{
+    suite_pass = 1;
+    suite_name = name;
+    suites_run++;
+    tests_in_suite = 0;
+}
+
+static void SUITE_END(void)
+{
+    printf("Testing %s ", suite_name);
+    size_t suite_i;
+    for (suite_i = strlen(suite_name); suite_i < 80 - 8 - 5; suite_i++)
+        printf(".");
+    printf("%s\n", suite_pass ? " pass" : " fail");
+    if (!suite_pass)
+        suites_failed++;
+    if (!tests_in_suite)
+        suites_empty++;
+}
+
+#define TEST_COPY_MAX   600
+#define TEST_COPY_GUARD 64
+
+static const char *test_copy_kernels[] = {"avx512", "avx2", "sse2", "neon", "memcpy"};
+
+/**
+ * @brief  Every size up to TEST_COPY_MAX and every wrap point the kernel tests with, checks that
+ *         nothing outside the two destination segments is written.
+ */
+static int test_copy_sizes(void)
+{
+    static uint8_t src[TEST_COPY_MAX + 1];
+    static uint8_t dst[TEST_COPY_MAX + 2 * TEST_COPY_GUARD];
+    static uint8_t dst2[TEST_COPY_MAX + 2 * TEST_COPY_GUARD];
+    int ok = 1;
+
+    for (uint32_t i = 0; i < sizeof(src); i++)
+    {
+        src[i] = (uint8_t)(i * 7 + 1);
+    }
+    for (uint32_t len = 0; len <= TEST_COPY_MAX; len++)
+    {
+        // no wrap, wrap after 1 byte, in the middle, before the last byte
+        uint32_t splits[] = {len, len != 0, len / 2, len != 0 ? len - 1 : 0};
+
+        for (uint32_t s = 0; s < sizeof(splits) / sizeof(splits[0]); s++)
+        {
+            uint32_t l = splits[s];
+            // unaligned on both sides
+            uint8_t *d = dst + TEST_COPY_GUARD + (len % 7);
+            uint8_t *d2 = dst2 + TEST_COPY_GUARD;
+
+            memset(dst, 0, sizeof(dst));
+            memset(dst2, 0, sizeof(dst2));
+            simple_ringbuffer_copy(d, src + 1, d2, src + 1 + l, l, len);
+            ok &= memcmp(d, src + 1, l) == 0;
+            ok &= memcmp(d2, src + 1 + l, len - l) == 0;
+            for (uint8_t *p = dst; p < dst + sizeof(dst); p++)
+            {
+                ok &= (p >= d && p < d + l) || *p == 0;
+            }
+            for (uint8_t *p = dst2; p < dst2 + sizeof(dst2); p++)
+            {
+                ok &= (p >= d2 && p < d2 + len - l) || *p == 0;
+            }
+        }
+    }
+
+    return ok;
+}
+
+static void test_copy_work(void)
+{
+    SUITE_START("test_copy_work");
+
+    const char *selected = simple_ringbuffer_copy_name();
+
+    ASSERT(simple_ringbuffer_copy_select("memcpy") == 0);
+    ASSERT(strcmp(simple_ringbuffer_copy_name(), "memcpy") == 0);
+    ASSERT(simple_ringbuffer_copy_select("none") == -1);
+
+    for (size_t i = 0; i < sizeof(test_copy_kernels) / sizeof(test_copy_kernels[0]); i++)
+    {
+        if (simple_ringbuffer_copy_select(test_copy_kernels[i]) != 0)
+        {
+            continue;
+        }
+        ASSERT(strcmp(simple_ringbuffer_copy_name(), test_copy_kernels[i]) == 0);
+        ASSERT(test_copy_sizes() == 1);
+    }
+
+    // the default is the first kernel the CPU supports
+    ASSERT(simple_ringbuffer_copy_select(NULL) == 0);
+    ASSERT(strcmp(simple_ringbuffer_copy_name(), selected) == 0);
+
+    SUITE_END();
+}
+
+#define TEST_BUFFER_SIZE_ODD 257
+
+// the RINGBUFs through every kernel, items and puts across the end of the storage.
+static void test_copy_work_ringbuf_odd(void)
+{
+    SUITE_START("test_copy_work_ringbuf_odd");
+
+    for (size_t i = 0; i < sizeof(test_copy_kernels) / sizeof(test_copy_kernels[0]); i++)
+    {
+        simple_ringbuffer_t ringbuf;
+        simple_data_ringbuffer_t data_ringbuf;
+        uint8_t storage[TEST_BUFFER_SIZE_ODD * 24];
+        uint8_t in[TEST_BUFFER_SIZE_ODD * 3];
+        uint8_t out[TEST_BUFFER_SIZE_ODD * 3];
+        int ok = 1;
+
+        if (simple_ringbuffer_copy_select(test_copy_kernels[i]) != 0)
+        {
+            continue;
+        }
+
+        simple_ringbuffer_init(&ringbuf, TEST_BUFFER_SIZE_ODD, storage);
+        for (uint32_t round = 0; round < 300; round++)
+        {
+            uint32_t n = (round * 13) % TEST_BUFFER_SIZE_ODD + 1;
+
+            for (uint32_t j = 0; j < n; j++)
+            {
+                in[j] = (uint8_t)(round + j);
+            }
+            ok &= simple_ringbuffer_put(&ringbuf, in, n) == n;
+            memset(out, 0, sizeof(out));
+            ok &= simple_ringbuffer_get(&ringbuf, out, n) == n;
+            ok &= memcmp(in, out, n) == 0;
+        }
+        ASSERT(ok == 1);
+
+        // 24 byte items, 3 at a time
+        simple_data_ringbuffer_init(&data_ringbuf, TEST_BUFFER_SIZE_ODD, 24, storage);
+        for (uint32_t round = 0; round < 300; round++)
+        {
+            for (uint32_t j = 0; j < 3 * 24; j++)
+            {
+                in[j] = (uint8_t)(round * 3 + j);
+            }
+            ok &= simple_data_ringbuffer_put(&data_ringbuf, in) == 1;
+            ok &= simple_data_ringbuffer_put_n(&data_ringbuf, in + 24, 2) == 2;
+            memset(out, 0, sizeof(out));
+            ok &= simple_data_ringbuffer_get_n(&data_ringbuf, out, 2) == 2;
+            ok &= simple_data_ringbuffer_get(&data_ringbuf, out + 2 * 24) == 1;
+            ok &= memcmp(in, out, 3 * 24) == 0;
+        }
+        ASSERT(ok == 1);
+    }
+    ASSERT(simple_ringbuffer_copy_select(NULL) == 0);
+
+    SUITE_END();
+}
+
+void test_copy_ringbuffer(void)
+{
+    test_copy_work();
+    test_copy_work_ringbuf_odd();
+}
@@ -376,6 +376,47 @@ static void test_pool_work_full_odd(void)
     SUITE_END();
 }
 
+#if SIMPLE_DATA_RINGBUFFER_WIDE
+#define TEST_BUFFER_SIZE_WIDE    100003
+#define TEST_USER_DATA_SIZE_WIDE 8
+
+static void test_pool_work_wide(void)
+{
+    SUITE_START("test_pool_work_wide");
+
+    // more blocks than the compact layout can index.
+    SIMPLE_POOL_DEFINE(test_pool, TEST_BUFFER_SIZE_WIDE, TEST_USER_DATA_SIZE_WIDE);
+
+    SIMPLE_POOL_INIT(test_pool, TEST_BUFFER_SIZE_WIDE, TEST_USER_DATA_SIZE_WIDE);
+
+    static uint64_t *ptr_save[TEST_BUFFER_SIZE_WIDE];
+
+    ASSERT(SIMPLE_POOL_TOTAL_CNT(&test_pool) == TEST_BUFFER_SIZE_WIDE);
+    ASSERT(SIMPLE_POOL_IS_FULL(&test_pool) == 1);
+
+    for (uint32_t loop = 0; loop < TEST_BUFFER_SIZE_WIDE; loop++)
+    {
+        uint64_t *data;
+        ASSERT(SIMPLE_POOL_DEQUEUE(&test_pool, data) == 1);
+        *data = loop;
+        ptr_save[loop] = data;
+    }
+    ASSERT(SIMPLE_POOL_IS_EMPTY(&test_pool) == 1);
+
+    for (uint32_t loop = 0; loop < TEST_BUFFER_SIZE_WIDE; loop++)
+    {
+        uint64_t *data = ptr_save[loop];
+
+        // every block is distinct and kept its data
+        ASSERT(*data == loop);
+        ASSERT(SIMPLE_POOL_ENQUEUE(&test_pool, data) == 1);
+    }
+    ASSERT(SIMPLE_POOL_SIZE(&test_pool) == TEST_BUFFER_SIZE_WIDE);
+
+    SUITE_END();
+}
+#endif
+
 void test_pool_ringbuffer(void)
 {
     test_pool_work();
@@ -383,5 +424,9 @@ void test_pool_ringbuffer(void)
 
     test_pool_work_odd();
     test_pool_work_full_odd();
+
+#if SIMPLE_DATA_RINGBUFFER_WIDE
+    test_pool_work_wide();
+#endif
 }
 #endif
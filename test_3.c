@@ -0,0 +1,588 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "simple_ringbuffer.h"
+#include "simple_data_ringbuffer.h"
+#include "simple_data_ringbuffer_typed.h"
+#include "simple_msg_ringbuffer.h"
+#include "simple_ringbuffer_wait.h"
+#include "simple_ringbuffer_notify.h"
+
+#if SIMPLE_RINGBUFFER_SPSC
+#include <pthread.h>
+#include <sched.h>
+#if defined(__linux__)
+#include <poll.h>
+#endif
+
+//
+// Tests
+//
+static const char *suite_name;
+static char suite_pass;
+static int suites_run = 0, suites_failed = 0, suites_empty = 0;
+static int tests_in_suite = 0, tests_run = 0, tests_failed = 0;
+
+#define QUOTE(str) #str
+#define ASSERT(x)                                                                                  \
+    {                                                                                              \
+        tests_run++;                                                                               \
+        tests_in_suite++;                                                                          \
+        if (!(x))                                                                                  \
+        {                                                                                          \
+            printf("failed assert [%s:%i] %s\n", __FILE__, __LINE__, QUOTE(x));                    \
+            suite_pass = 0;                                                                        \
+            tests_failed++;                                                                        \
+            while (1)                                                                              \
+                ;                                                                                  \
+        }                                                                                          \
+    }
+
+static void SUITE_START(const char *name)
+{
+    suite_pass = 1;
+    suite_name = name;
+    suites_run++;
+    tests_in_suite = 0;
+}
+
+static void SUITE_END(void)
+{
+    printf("Testing %s ", suite_name);
+    size_t suite_i;
+    for (suite_i = strlen(suite_name); suite_i < 80 - 8 - 5; suite_i++)
+        printf(".");
+    printf("%s\n", suite_pass ? " pass" : " fail");
+    if (!suite_pass)
+        suites_failed++;
+    if (!tests_in_suite)
+        suites_empty++;
+}
+
+#define TEST_BUFFER_SIZE_ODD 251
+#define TEST_LOOP_CNT        200000
+
+struct test_user_data
+{
+    uint32_t seq;
+    uint32_t check;
+};
+
+static void *test_spsc_producer(void *arg)
+{
+    simple_ringbuffer_t *ringbuf = arg;
+    uint8_t data[64];
+    uint32_t seq = 0;
+    uint32_t chunk = 1;
+
+    while (seq < TEST_LOOP_CNT)
+    {
+        uint32_t len = chunk;
+        if (len > TEST_LOOP_CNT - seq)
+        {
+            len = TEST_LOOP_CNT - seq;
+        }
+        for (uint32_t i = 0; i < len; i++)
+        {
+            data[i] = (uint8_t)(seq + i);
+        }
+
+        uint32_t offset = 0;
+        while (offset < len)
+        {
+            uint32_t l = simple_ringbuffer_put(ringbuf, data + offset, len - offset);
+            if (l == 0)
+            {
+                sched_yield();
+            }
+            offset += l;
+        }
+
+        seq += len;
+        chunk = (chunk % sizeof(data)) + 1;
+    }
+
+    return NULL;
+}
+
+static void test_spsc_work_odd(void)
+{
+    SUITE_START("test_spsc_work_odd");
+
+    simple_ringbuffer_t test_ringbuf;
+    uint8_t test_buffer[TEST_BUFFER_SIZE_ODD];
+    pthread_t producer;
+
+    simple_ringbuffer_init(&test_ringbuf, TEST_BUFFER_SIZE_ODD, test_buffer);
+
+    ASSERT(pthread_create(&producer, NULL, test_spsc_producer, &test_ringbuf) == 0);
+
+    uint32_t seq = 0;
+    uint32_t chunk = 1;
+    int data_ok = 1;
+    while (seq < TEST_LOOP_CNT)
+    {
+        uint8_t rdata[97];
+        uint32_t len = simple_ringbuffer_get(&test_ringbuf, rdata, chunk);
+        if (len == 0)
+        {
+            sched_yield();
+        }
+
+        // check read data
+        for (uint32_t i = 0; i < len; i++)
+        {
+            data_ok &= (rdata[i] == (uint8_t)(seq + i));
+        }
+
+        seq += len;
+        chunk = (chunk % sizeof(rdata)) + 1;
+    }
+
+    ASSERT(pthread_join(producer, NULL) == 0);
+    ASSERT(data_ok == 1);
+    ASSERT(seq == TEST_LOOP_CNT);
+    ASSERT(simple_ringbuffer_is_empty(&test_ringbuf) == 1);
+
+    SUITE_END();
+}
+
+static void *test_spsc_data_producer(void *arg)
+{
+    simple_data_ringbuffer_t *ringbuf = arg;
+
+    for (uint32_t seq = 0; seq < TEST_LOOP_CNT; seq++)
+    {
+        if (seq & 1)
+        {
+            struct test_user_data data = {.seq = seq, .check = ~seq};
+            while (simple_data_ringbuffer_put(ringbuf, &data) == 0)
+            {
+                sched_yield();
+            }
+        }
+        else
+        {
+            struct test_user_data *data;
+            int index = simple_data_ringbuffer_enqueue_get(ringbuf, (void **)&data);
+            while (data == NULL)
+            {
+                sched_yield();
+                index = simple_data_ringbuffer_enqueue_get(ringbuf, (void **)&data);
+            }
+            data->seq = seq;
+            data->check = ~seq;
+            simple_data_ringbuffer_enqueue(ringbuf, index);
+        }
+    }
+
+    return NULL;
+}
+
+static void test_spsc_data_work_odd(void)
+{
+    SUITE_START("test_spsc_data_work_odd");
+
+    simple_data_ringbuffer_t test_ringbuf;
+    struct test_user_data test_buffer[TEST_BUFFER_SIZE_ODD];
+    pthread_t producer;
+
+    simple_data_ringbuffer_init(&test_ringbuf, TEST_BUFFER_SIZE_ODD, sizeof(struct test_user_data),
+                                test_buffer);
+
+    ASSERT(pthread_create(&producer, NULL, test_spsc_data_producer, &test_ringbuf) == 0);
+
+    int data_ok = 1;
+    for (uint32_t seq = 0; seq < TEST_LOOP_CNT; seq++)
+    {
+        if (seq & 1)
+        {
+            struct test_user_data data;
+            while (simple_data_ringbuffer_get(&test_ringbuf, &data) == 0)
+            {
+                sched_yield();
+            }
+            data_ok &= (data.seq == seq) && (data.check == ~seq);
+        }
+        else
+        {
+            struct test_user_data *data;
+            while ((data = simple_data_ringbuffer_dequeue_peek(&test_ringbuf)) == NULL)
+            {
+                sched_yield();
+            }
+            data_ok &= (data->seq == seq) && (data->check == ~seq);
+            simple_data_ringbuffer_dequeue(&test_ringbuf);
+        }
+    }
+
+    ASSERT(pthread_join(producer, NULL) == 0);
+    ASSERT(data_ok == 1);
+    ASSERT(simple_data_ringbuffer_is_empty(&test_ringbuf) == 1);
+#if SIMPLE_RINGBUFFER_STATS
+    // both sides counted every item, the failed attempts as full/empty.
+    simple_ringbuffer_stats_t stats;
+    simple_data_ringbuffer_stats_snapshot(&test_ringbuf, &stats);
+    ASSERT(stats.put_items == TEST_LOOP_CNT && stats.get_items == TEST_LOOP_CNT);
+    ASSERT(stats.wraps == TEST_LOOP_CNT / TEST_BUFFER_SIZE_ODD);
+    ASSERT(stats.high_water >= 1 && stats.high_water <= TEST_BUFFER_SIZE_ODD);
+#endif
+
+    SUITE_END();
+}
+SIMPLE_DATA_RINGBUFFER_DECLARE_TYPED(test_spsc_typed_ring, struct test_user_data,
+                                     TEST_BUFFER_SIZE_ODD)
+
+static void *test_spsc_typed_producer(void *arg)
+{
+    test_spsc_typed_ring_t *ringbuf = arg;
+
+    for (uint32_t seq = 0; seq < TEST_LOOP_CNT; seq++)
+    {
+        struct test_user_data data = {.seq = seq, .check = ~seq};
+        while (test_spsc_typed_ring_put(ringbuf, &data) == 0)
+        {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+static void test_spsc_typed_work_odd(void)
+{
+    SUITE_START("test_spsc_typed_work_odd");
+
+    static test_spsc_typed_ring_t test_ringbuf;
+    pthread_t producer;
+
+    test_spsc_typed_ring_init(&test_ringbuf);
+
+    ASSERT(pthread_create(&producer, NULL, test_spsc_typed_producer, &test_ringbuf) == 0);
+
+    int data_ok = 1;
+    for (uint32_t seq = 0; seq < TEST_LOOP_CNT; seq++)
+    {
+        struct test_user_data *data;
+        while ((data = test_spsc_typed_ring_peek(&test_ringbuf)) == NULL)
+        {
+            sched_yield();
+        }
+        data_ok &= (data->seq == seq) && (data->check == ~seq);
+        test_spsc_typed_ring_get(&test_ringbuf, NULL);
+    }
+
+    ASSERT(pthread_join(producer, NULL) == 0);
+    ASSERT(data_ok == 1);
+    ASSERT(test_spsc_typed_ring_is_empty(&test_ringbuf) == 1);
+
+    SUITE_END();
+}
+#define TEST_OVERWRITE_BUFFER_SIZE 7
+#define TEST_OVERWRITE_WORDS       16
+
+struct test_overwrite_data
+{
+    uint32_t word[TEST_OVERWRITE_WORDS]; /* All equal to the seq, a torn item is not */
+};
+
+static void *test_spsc_overwrite_producer(void *arg)
+{
+    simple_data_ringbuffer_t *ringbuf = arg;
+
+    /* never waits, a slow consumer is lapped */
+    for (uint32_t seq = 0; seq < TEST_LOOP_CNT; seq++)
+    {
+        struct test_overwrite_data data;
+        for (int i = 0; i < TEST_OVERWRITE_WORDS; i++)
+        {
+            data.word[i] = seq;
+        }
+        simple_data_ringbuffer_put_overwrite(ringbuf, &data);
+    }
+
+    return NULL;
+}
+
+static void test_spsc_overwrite_work_odd(void)
+{
+    SUITE_START("test_spsc_overwrite_work_odd");
+
+    simple_data_ringbuffer_t test_ringbuf;
+    struct test_overwrite_data test_buffer[TEST_OVERWRITE_BUFFER_SIZE];
+    pthread_t producer;
+
+    simple_data_ringbuffer_init(&test_ringbuf, TEST_OVERWRITE_BUFFER_SIZE,
+                                sizeof(struct test_overwrite_data), test_buffer);
+
+    ASSERT(pthread_create(&producer, NULL, test_spsc_overwrite_producer, &test_ringbuf) == 0);
+
+    /* the newest item is never overwritten, the last one put is always get */
+    int data_ok = 1;
+    uint32_t received = 0;
+    uint32_t last = 0;
+    while (received == 0 || last != TEST_LOOP_CNT - 1)
+    {
+        struct test_overwrite_data data;
+        if (simple_data_ringbuffer_get_overwrite(&test_ringbuf, &data) == 0)
+        {
+            sched_yield();
+            continue;
+        }
+        for (int i = 1; i < TEST_OVERWRITE_WORDS; i++)
+        {
+            data_ok &= (data.word[i] == data.word[0]);
+        }
+        data_ok &= (received == 0 || data.word[0] > last);
+        last = data.word[0];
+        received++;
+    }
+
+    ASSERT(pthread_join(producer, NULL) == 0);
+    ASSERT(data_ok == 1);
+    ASSERT(received + simple_data_ringbuffer_overwritten(&test_ringbuf) == TEST_LOOP_CNT);
+    ASSERT(simple_data_ringbuffer_is_empty(&test_ringbuf) == 1);
+
+    SUITE_END();
+}
+#define TEST_MSG_BUFFER_SIZE 1000
+#define TEST_MSG_MAX_SIZE    300
+
+static void *test_spsc_msg_producer(void *arg)
+{
+    simple_msg_ringbuffer_t *msgbuf = arg;
+
+    for (uint32_t seq = 0; seq < TEST_LOOP_CNT; seq++)
+    {
+        uint32_t len = (seq * 37) % TEST_MSG_MAX_SIZE;
+        uint8_t *payload;
+        while ((payload = simple_msg_ringbuffer_reserve(msgbuf, len)) == NULL)
+        {
+            sched_yield();
+        }
+        for (uint32_t i = 0; i < len; i++)
+        {
+            payload[i] = (uint8_t)(seq + i);
+        }
+        simple_msg_ringbuffer_commit(msgbuf, len);
+    }
+
+    return NULL;
+}
+
+static void test_spsc_msg_work(void)
+{
+    SUITE_START("test_spsc_msg_work");
+
+    static uint32_t test_buffer[TEST_MSG_BUFFER_SIZE / sizeof(uint32_t)];
+    static simple_msg_ringbuffer_t test_msgbuf;
+    pthread_t producer;
+
+    simple_msg_ringbuffer_init(&test_msgbuf, TEST_MSG_BUFFER_SIZE, (uint8_t *)test_buffer);
+
+    ASSERT(pthread_create(&producer, NULL, test_spsc_msg_producer, &test_msgbuf) == 0);
+
+    int data_ok = 1;
+    for (uint32_t seq = 0; seq < TEST_LOOP_CNT; seq++)
+    {
+        uint8_t *data;
+        uint32_t len;
+        while ((data = simple_msg_ringbuffer_peek(&test_msgbuf, &len)) == NULL)
+        {
+            sched_yield();
+        }
+        data_ok &= (len == (seq * 37) % TEST_MSG_MAX_SIZE);
+        for (uint32_t i = 0; data_ok && i < len; i++)
+        {
+            data_ok &= (data[i] == (uint8_t)(seq + i));
+        }
+        simple_msg_ringbuffer_consume(&test_msgbuf);
+    }
+
+    ASSERT(pthread_join(producer, NULL) == 0);
+    ASSERT(data_ok == 1);
+    ASSERT(simple_msg_ringbuffer_is_empty(&test_msgbuf) == 1);
+
+    SUITE_END();
+}
+#if defined(__linux__)
+#define TEST_WAIT_LOOP_CNT 20000
+
+typedef struct test_spsc_wait_ctx
+{
+    simple_ringbuffer_t ringbuf;
+    simple_data_ringbuffer_t data_ringbuf;
+    simple_ringbuffer_waiter_t waiter;
+    simple_ringbuffer_waiter_t data_waiter;
+} test_spsc_wait_ctx_t;
+
+static void *test_spsc_wait_producer(void *arg)
+{
+    test_spsc_wait_ctx_t *ctx = arg;
+    uint8_t data[64];
+    uint32_t seq = 0;
+
+    // bytes, in chunks which do not match the consumer ones.
+    while (seq < TEST_WAIT_LOOP_CNT)
+    {
+        uint32_t len = (seq % sizeof(data)) + 1;
+        if (len > TEST_WAIT_LOOP_CNT - seq)
+        {
+            len = TEST_WAIT_LOOP_CNT - seq;
+        }
+        for (uint32_t i = 0; i < len; i++)
+        {
+            data[i] = (uint8_t)(seq + i);
+        }
+        simple_ringbuffer_put_wait(&ctx->ringbuf, &ctx->waiter, data, len, -1);
+        seq += len;
+    }
+
+    // then items.
+    for (seq = 0; seq < TEST_WAIT_LOOP_CNT; seq++)
+    {
+        struct test_user_data item = {.seq = seq, .check = ~seq};
+        simple_data_ringbuffer_put_wait(&ctx->data_ringbuf, &ctx->data_waiter, &item, -1);
+    }
+
+    return NULL;
+}
+
+static void test_spsc_wait_work_odd(void)
+{
+    SUITE_START("test_spsc_wait_work_odd");
+
+    static const simple_ringbuffer_wait_strategy_t strategies[] = {
+            SIMPLE_RINGBUFFER_WAIT_SPIN, SIMPLE_RINGBUFFER_WAIT_YIELD,
+            SIMPLE_RINGBUFFER_WAIT_FUTEX};
+
+    for (size_t s = 0; s < sizeof(strategies) / sizeof(strategies[0]); s++)
+    {
+        static test_spsc_wait_ctx_t ctx;
+        static uint8_t test_buffer[TEST_BUFFER_SIZE_ODD];
+        static struct test_user_data test_data_buffer[TEST_BUFFER_SIZE_ODD];
+        pthread_t producer;
+
+        simple_ringbuffer_init(&ctx.ringbuf, TEST_BUFFER_SIZE_ODD, test_buffer);
+        simple_data_ringbuffer_init(&ctx.data_ringbuf, TEST_BUFFER_SIZE_ODD,
+                                    sizeof(struct test_user_data), test_data_buffer);
+        simple_ringbuffer_waiter_init(&ctx.waiter, strategies[s]);
+        simple_ringbuffer_waiter_init(&ctx.data_waiter, strategies[s]);
+
+        ASSERT(pthread_create(&producer, NULL, test_spsc_wait_producer, &ctx) == 0);
+
+        int data_ok = 1;
+        uint32_t seq = 0;
+        while (seq < TEST_WAIT_LOOP_CNT)
+        {
+            uint8_t rdata[97];
+            uint32_t len = simple_ringbuffer_get_wait(&ctx.ringbuf, &ctx.waiter, rdata,
+                                                      sizeof(rdata), -1);
+            data_ok &= (len != 0);
+            for (uint32_t i = 0; i < len; i++)
+            {
+                data_ok &= (rdata[i] == (uint8_t)(seq + i));
+            }
+            seq += len;
+        }
+        for (seq = 0; seq < TEST_WAIT_LOOP_CNT; seq++)
+        {
+            struct test_user_data item;
+            data_ok &= simple_data_ringbuffer_get_wait(&ctx.data_ringbuf, &ctx.data_waiter,
+                                                       &item, -1);
+            data_ok &= (item.seq == seq) && (item.check == ~seq);
+        }
+
+        ASSERT(pthread_join(producer, NULL) == 0);
+        ASSERT(data_ok == 1);
+        ASSERT(simple_ringbuffer_is_empty(&ctx.ringbuf) == 1);
+        ASSERT(simple_data_ringbuffer_is_empty(&ctx.data_ringbuf) == 1);
+        ASSERT(atomic_load(&ctx.waiter.not_empty.waiters) == 0);
+    }
+
+    SUITE_END();
+}
+
+typedef struct test_spsc_notify_ctx
+{
+    simple_data_ringbuffer_t data_ringbuf;
+    simple_ringbuffer_notifier_t notifier;
+} test_spsc_notify_ctx_t;
+
+static void test_spsc_notify_poll(int fd)
+{
+    struct pollfd pfd = {fd, POLLIN, 0};
+    while (poll(&pfd, 1, -1) != 1)
+    {
+    }
+}
+
+static void *test_spsc_notify_producer(void *arg)
+{
+    test_spsc_notify_ctx_t *ctx = arg;
+
+    for (uint32_t seq = 0; seq < TEST_WAIT_LOOP_CNT; seq++)
+    {
+        struct test_user_data item = {.seq = seq, .check = ~seq};
+        while (simple_data_ringbuffer_put_notify(&ctx->data_ringbuf, &ctx->notifier, &item) == 0)
+        {
+            test_spsc_notify_poll(ctx->notifier.writable.fd);
+        }
+    }
+
+    return NULL;
+}
+
+static void test_spsc_notify_work_odd(void)
+{
+    SUITE_START("test_spsc_notify_work_odd");
+
+    static test_spsc_notify_ctx_t ctx;
+    static struct test_user_data test_data_buffer[TEST_BUFFER_SIZE_ODD];
+    pthread_t producer;
+
+    simple_data_ringbuffer_init(&ctx.data_ringbuf, TEST_BUFFER_SIZE_ODD,
+                                sizeof(struct test_user_data), test_data_buffer);
+    ASSERT(simple_ringbuffer_notifier_init(&ctx.notifier) == 0);
+
+    ASSERT(pthread_create(&producer, NULL, test_spsc_notify_producer, &ctx) == 0);
+
+    // an event loop: wait for readiness, drain until the RINGBUF comes up empty.
+    int data_ok = 1;
+    uint32_t seq = 0;
+    while (seq < TEST_WAIT_LOOP_CNT)
+    {
+        struct test_user_data item;
+
+        test_spsc_notify_poll(ctx.notifier.readable.fd);
+        while (simple_data_ringbuffer_get_notify(&ctx.data_ringbuf, &ctx.notifier, &item) == 1)
+        {
+            data_ok &= (item.seq == seq) && (item.check == ~seq);
+            seq++;
+        }
+    }
+
+    ASSERT(pthread_join(producer, NULL) == 0);
+    ASSERT(data_ok == 1);
+    ASSERT(simple_data_ringbuffer_is_empty(&ctx.data_ringbuf) == 1);
+    simple_ringbuffer_notifier_deinit(&ctx.notifier);
+
+    SUITE_END();
+}
+#endif
+#endif /* SIMPLE_RINGBUFFER_SPSC */
+
+void test_spsc_ringbuffer(void)
+{
+#if SIMPLE_RINGBUFFER_SPSC
+    test_spsc_work_odd();
+    test_spsc_data_work_odd();
+    test_spsc_typed_work_odd();
+    test_spsc_overwrite_work_odd();
+    test_spsc_msg_work();
+#if defined(__linux__)
+    test_spsc_wait_work_odd();
+    test_spsc_notify_work_odd();
+#endif
+#endif
+}
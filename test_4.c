@@ -0,0 +1,480 @@
+#include <stdio.h>
+#include <string.h>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include "simple_mpmc_data_ringbuffer.h"
+
+//
+// Tests
+//
+static const char *suite_name;
+static char suite_pass;
+static int suites_run = 0, suites_failed = 0, suites_empty = 0;
+static int tests_in_suite = 0, tests_run = 0, tests_failed = 0;
+
+#define QUOTE(str) #str
+#define ASSERT(x)                                                                                  \
+    {                                                                                              \
+        tests_run++;                                                                               \
+        tests_in_suite++;                                                                          \
+        if (!(x))                                                                                  \
+        {                                                                                          \
+            printf("failed assert [%s:%i] %s\n", __FILE__, __LINE__, QUOTE(x));                    \
+            suite_pass = 0;                                                                        \
+            tests_failed++;                                                                        \
+            while (1)                                                                              \
+                ;                                                                                  \
+        }                                                                                          \
+    }
+
+static void SUITE_START(const char *name)
+{
+    suite_pass = 1;
+    suite_name = name;
+    suites_run++;
+    tests_in_suite = 0;
+}
+
+static void SUITE_END(void)
+{
+    printf("Testing %s ", suite_name);
+    size_t suite_i;
+    for (suite_i = strlen(suite_name); suite_i < 80 - 8 - 5; suite_i++)
+        printf(".");
+    printf("%s\n", suite_pass ? " pass" : " fail");
+    if (!suite_pass)
+        suites_failed++;
+    if (!tests_in_suite)
+        suites_empty++;
+}
+
+#define TEST_USER_DATA_SIZE 0x10
+struct test_user_data
+{
+    uint8_t data[TEST_USER_DATA_SIZE];
+};
+
+#define TEST_BUFFER_SIZE     256
+#define TEST_BUFFER_SIZE_ODD 255
+
+static void test_mpmc_work_size(uint16_t test_size)
+{
+    SIMPLE_MPMC_DATA_RINGBUFFER_DEFINE(test_ringbuf, TEST_BUFFER_SIZE, TEST_USER_DATA_SIZE);
+
+    SIMPLE_MPMC_DATA_RINGBUFFER_INIT(test_ringbuf, test_size, TEST_USER_DATA_SIZE);
+
+    ASSERT(simple_mpmc_data_ringbuffer_total_size(&test_ringbuf) == test_size);
+    ASSERT(simple_mpmc_data_ringbuffer_item_size(&test_ringbuf) == TEST_USER_DATA_SIZE);
+
+    int total_size = 0;
+    int put_loop = 0;
+    int get_loop = 0;
+
+    // run several laps, so the index and the lap counter wrap.
+    for (int round = 0; round < 5; round++)
+    {
+        while (simple_mpmc_data_ringbuffer_reserve_size(&test_ringbuf) > 0)
+        {
+            struct test_user_data data;
+            for (int i = 0; i < TEST_USER_DATA_SIZE; i++)
+            {
+                data.data[i] = i + put_loop;
+            }
+            put_loop++;
+
+            total_size++;
+            ASSERT(simple_mpmc_data_ringbuffer_put(&test_ringbuf, &data) == 1);
+            ASSERT(simple_mpmc_data_ringbuffer_size(&test_ringbuf) == total_size);
+            ASSERT(simple_mpmc_data_ringbuffer_is_empty(&test_ringbuf) == 0);
+            ASSERT(simple_mpmc_data_ringbuffer_is_full(&test_ringbuf) == (total_size == test_size));
+        }
+
+        struct test_user_data data;
+        ASSERT(total_size == test_size);
+        ASSERT(simple_mpmc_data_ringbuffer_put(&test_ringbuf, &data) == 0);
+
+        // drain a different amount every round.
+        int drain = test_size - round * (test_size / 5);
+        for (int loop = 0; loop < drain; loop++)
+        {
+            ASSERT(simple_mpmc_data_ringbuffer_get(&test_ringbuf, &data) == 1);
+
+            // check read data
+            for (int i = 0; i < TEST_USER_DATA_SIZE; i++)
+            {
+                ASSERT(data.data[i] == (uint8_t)(i + get_loop));
+            }
+            get_loop++;
+
+            total_size--;
+            ASSERT(simple_mpmc_data_ringbuffer_size(&test_ringbuf) == total_size);
+            ASSERT(simple_mpmc_data_ringbuffer_reserve_size(&test_ringbuf) ==
+                   test_size - total_size);
+        }
+    }
+
+    while (simple_mpmc_data_ringbuffer_get(&test_ringbuf, NULL))
+    {
+        total_size--;
+    }
+    ASSERT(total_size == 0);
+    ASSERT(simple_mpmc_data_ringbuffer_is_empty(&test_ringbuf) == 1);
+}
+
+static void test_mpmc_work(void)
+{
+    SUITE_START("test_mpmc_work");
+
+    test_mpmc_work_size(TEST_BUFFER_SIZE);
+
+    SUITE_END();
+}
+
+static void test_mpmc_work_odd(void)
+{
+    SUITE_START("test_mpmc_work_odd");
+
+    test_mpmc_work_size(TEST_BUFFER_SIZE_ODD);
+    test_mpmc_work_size(1);
+
+    SUITE_END();
+}
+
+#define TEST_THREAD_CNT 4
+#define TEST_LOOP_CNT   50000
+
+struct test_mpmc_item
+{
+    uint32_t producer;
+    uint32_t seq;
+};
+
+struct test_mpmc_thread
+{
+    simple_mpmc_data_ringbuffer_t *ringbuf;
+    uint32_t id;
+    uint32_t count[TEST_THREAD_CNT];
+    uint64_t sum[TEST_THREAD_CNT];
+};
+
+static void *test_mpmc_producer(void *arg)
+{
+    struct test_mpmc_thread *thread = arg;
+
+    for (uint32_t seq = 0; seq < TEST_LOOP_CNT; seq++)
+    {
+        struct test_mpmc_item item = {.producer = thread->id, .seq = seq};
+        while (simple_mpmc_data_ringbuffer_put(thread->ringbuf, &item) == 0)
+        {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+static void *test_mpmc_consumer(void *arg)
+{
+    struct test_mpmc_thread *thread = arg;
+
+    for (uint32_t loop = 0; loop < TEST_LOOP_CNT; loop++)
+    {
+        struct test_mpmc_item item;
+        while (simple_mpmc_data_ringbuffer_get(thread->ringbuf, &item) == 0)
+        {
+            sched_yield();
+        }
+        if (item.producer < TEST_THREAD_CNT)
+        {
+            thread->count[item.producer]++;
+            thread->sum[item.producer] += item.seq;
+        }
+    }
+
+    return NULL;
+}
+
+static void test_mpmc_work_thread(void)
+{
+    SUITE_START("test_mpmc_work_thread");
+
+    SIMPLE_MPMC_DATA_RINGBUFFER_DEFINE(test_ringbuf, 61, sizeof(struct test_mpmc_item));
+    SIMPLE_MPMC_DATA_RINGBUFFER_INIT(test_ringbuf, 61, sizeof(struct test_mpmc_item));
+
+    static struct test_mpmc_thread producers[TEST_THREAD_CNT], consumers[TEST_THREAD_CNT];
+    pthread_t producer_tid[TEST_THREAD_CNT], consumer_tid[TEST_THREAD_CNT];
+
+    memset(producers, 0, sizeof(producers));
+    memset(consumers, 0, sizeof(consumers));
+    for (int i = 0; i < TEST_THREAD_CNT; i++)
+    {
+        producers[i].ringbuf = &test_ringbuf;
+        producers[i].id = i;
+        consumers[i].ringbuf = &test_ringbuf;
+        ASSERT(pthread_create(&consumer_tid[i], NULL, test_mpmc_consumer, &consumers[i]) == 0);
+        ASSERT(pthread_create(&producer_tid[i], NULL, test_mpmc_producer, &producers[i]) == 0);
+    }
+    for (int i = 0; i < TEST_THREAD_CNT; i++)
+    {
+        ASSERT(pthread_join(producer_tid[i], NULL) == 0);
+        ASSERT(pthread_join(consumer_tid[i], NULL) == 0);
+    }
+
+    // every item of every producer is got exactly once.
+    for (int p = 0; p < TEST_THREAD_CNT; p++)
+    {
+        uint32_t count = 0;
+        uint64_t sum = 0;
+        for (int c = 0; c < TEST_THREAD_CNT; c++)
+        {
+            count += consumers[c].count[p];
+            sum += consumers[c].sum[p];
+        }
+        ASSERT(count == TEST_LOOP_CNT);
+        ASSERT(sum == (uint64_t)TEST_LOOP_CNT * (TEST_LOOP_CNT - 1) / 2);
+    }
+    ASSERT(simple_mpmc_data_ringbuffer_is_empty(&test_ringbuf) == 1);
+
+#if SIMPLE_RINGBUFFER_STATS
+    // every thread counted into the same counters, none lost.
+    simple_ringbuffer_stats_t stats;
+    simple_mpmc_data_ringbuffer_stats_snapshot(&test_ringbuf, &stats);
+    ASSERT(stats.put_items == TEST_THREAD_CNT * TEST_LOOP_CNT);
+    ASSERT(stats.get_items == TEST_THREAD_CNT * TEST_LOOP_CNT);
+    ASSERT(stats.put_bytes == stats.put_items * sizeof(struct test_mpmc_item));
+    ASSERT(stats.high_water >= 1 && stats.high_water <= 61);
+#endif
+
+    SUITE_END();
+}
+
+static void test_mpmc_work_enqueue(void)
+{
+    SUITE_START("test_mpmc_work_enqueue");
+
+    SIMPLE_MPMC_DATA_RINGBUFFER_DEFINE(test_ringbuf, 5, TEST_USER_DATA_SIZE);
+    SIMPLE_MPMC_DATA_RINGBUFFER_INIT(test_ringbuf, 5, TEST_USER_DATA_SIZE);
+
+    // several laps, reserve 3 slots, commit them in reverse order.
+    for (int round = 0; round < 7; round++)
+    {
+        struct test_user_data *data[3];
+        uint32_t commit[3];
+        for (int i = 0; i < 3; i++)
+        {
+            commit[i] = simple_mpmc_data_ringbuffer_enqueue_get(&test_ringbuf, (void **)&data[i]);
+            ASSERT(commit[i] != 0);
+            ASSERT(data[i] != NULL);
+            memset(data[i]->data, round * 3 + i, TEST_USER_DATA_SIZE);
+        }
+        ASSERT(simple_mpmc_data_ringbuffer_size(&test_ringbuf) == 3);
+
+        simple_mpmc_data_ringbuffer_enqueue(&test_ringbuf, commit[2]);
+        simple_mpmc_data_ringbuffer_enqueue(&test_ringbuf, commit[1]);
+        // only a committed prefix is visible.
+        ASSERT(simple_mpmc_data_ringbuffer_dequeue_peek(&test_ringbuf) == NULL);
+
+        simple_mpmc_data_ringbuffer_enqueue(&test_ringbuf, commit[0]);
+        for (int i = 0; i < 3; i++)
+        {
+            struct test_user_data *rdata = simple_mpmc_data_ringbuffer_dequeue_peek(&test_ringbuf);
+            ASSERT(rdata == data[i]);
+            ASSERT(rdata->data[0] == (uint8_t)(round * 3 + i));
+            simple_mpmc_data_ringbuffer_dequeue(&test_ringbuf);
+        }
+        ASSERT(simple_mpmc_data_ringbuffer_dequeue_peek(&test_ringbuf) == NULL);
+        ASSERT(simple_mpmc_data_ringbuffer_is_empty(&test_ringbuf) == 1);
+    }
+
+    // full.
+    struct test_user_data *data;
+    for (int i = 0; i < 5; i++)
+    {
+        uint32_t commit = simple_mpmc_data_ringbuffer_enqueue_get(&test_ringbuf, (void **)&data);
+        ASSERT(commit != 0);
+        simple_mpmc_data_ringbuffer_enqueue(&test_ringbuf, commit);
+    }
+    ASSERT(simple_mpmc_data_ringbuffer_enqueue_get(&test_ringbuf, (void **)&data) == 0);
+    ASSERT(data == NULL);
+
+    SUITE_END();
+}
+
+static void *test_mpsc_producer(void *arg)
+{
+    struct test_mpmc_thread *thread = arg;
+
+    for (uint32_t seq = 0; seq < TEST_LOOP_CNT; seq++)
+    {
+        struct test_mpmc_item *item;
+        uint32_t commit;
+        while ((commit = simple_mpmc_data_ringbuffer_enqueue_get(thread->ringbuf,
+                                                                 (void **)&item)) == 0)
+        {
+            sched_yield();
+        }
+        item->producer = thread->id;
+        item->seq = seq;
+        simple_mpmc_data_ringbuffer_enqueue(thread->ringbuf, commit);
+    }
+
+    return NULL;
+}
+
+static void test_mpmc_work_enqueue_thread(void)
+{
+    SUITE_START("test_mpmc_work_enqueue_thread");
+
+    SIMPLE_MPMC_DATA_RINGBUFFER_DEFINE(test_ringbuf, 61, sizeof(struct test_mpmc_item));
+    SIMPLE_MPMC_DATA_RINGBUFFER_INIT(test_ringbuf, 61, sizeof(struct test_mpmc_item));
+
+    static struct test_mpmc_thread producers[TEST_THREAD_CNT];
+    pthread_t producer_tid[TEST_THREAD_CNT];
+    uint32_t next_seq[TEST_THREAD_CNT] = {0};
+
+    memset(producers, 0, sizeof(producers));
+    for (int i = 0; i < TEST_THREAD_CNT; i++)
+    {
+        producers[i].ringbuf = &test_ringbuf;
+        producers[i].id = i;
+        ASSERT(pthread_create(&producer_tid[i], NULL, test_mpsc_producer, &producers[i]) == 0);
+    }
+
+    // single consumer, items of every producer come in order.
+    for (uint32_t loop = 0; loop < TEST_THREAD_CNT * TEST_LOOP_CNT; loop++)
+    {
+        struct test_mpmc_item *item;
+        while ((item = simple_mpmc_data_ringbuffer_dequeue_peek(&test_ringbuf)) == NULL)
+        {
+            sched_yield();
+        }
+        ASSERT(item->producer < TEST_THREAD_CNT);
+        ASSERT(item->seq == next_seq[item->producer]);
+        next_seq[item->producer]++;
+        simple_mpmc_data_ringbuffer_dequeue(&test_ringbuf);
+    }
+
+    for (int i = 0; i < TEST_THREAD_CNT; i++)
+    {
+        ASSERT(pthread_join(producer_tid[i], NULL) == 0);
+        ASSERT(next_seq[i] == TEST_LOOP_CNT);
+    }
+    ASSERT(simple_mpmc_data_ringbuffer_is_empty(&test_ringbuf) == 1);
+
+    SUITE_END();
+}
+
+static void test_mpmc_work_n(void)
+{
+    SUITE_START("test_mpmc_work_n");
+
+    SIMPLE_MPMC_DATA_RINGBUFFER_DEFINE(test_ringbuf, 7, sizeof(uint32_t));
+    SIMPLE_MPMC_DATA_RINGBUFFER_INIT(test_ringbuf, 7, sizeof(uint32_t));
+
+    uint32_t data[10];
+    uint32_t rdata[10];
+    uint32_t put_loop = 0;
+    uint32_t get_loop = 0;
+
+    ASSERT(simple_mpmc_data_ringbuffer_get_n(&test_ringbuf, rdata, 10) == 0);
+    ASSERT(simple_mpmc_data_ringbuffer_put_n(&test_ringbuf, data, 0) == 0);
+
+    // bursts of different length, so the claims wrap at every offset.
+    for (int round = 0; round < 50; round++)
+    {
+        uint32_t n = round % 10;
+        uint32_t size = simple_mpmc_data_ringbuffer_size(&test_ringbuf);
+        uint32_t expect = n < 7 - size ? n : 7 - size;
+
+        for (uint32_t i = 0; i < n; i++)
+        {
+            data[i] = put_loop + i;
+        }
+        ASSERT(simple_mpmc_data_ringbuffer_put_n(&test_ringbuf, data, n) == expect);
+        put_loop += expect;
+        ASSERT(simple_mpmc_data_ringbuffer_size(&test_ringbuf) == size + expect);
+
+        n = (round * 3) % 8;
+        size = simple_mpmc_data_ringbuffer_size(&test_ringbuf);
+        expect = n < size ? n : size;
+        ASSERT(simple_mpmc_data_ringbuffer_get_n(&test_ringbuf, rdata, n) == expect);
+        for (uint32_t i = 0; i < expect; i++)
+        {
+            ASSERT(rdata[i] == get_loop + i);
+        }
+        get_loop += expect;
+        ASSERT(simple_mpmc_data_ringbuffer_size(&test_ringbuf) == size - expect);
+    }
+
+    // mix with single item calls.
+    ASSERT(simple_mpmc_data_ringbuffer_get_n(&test_ringbuf, NULL, 7) ==
+           put_loop - get_loop);
+    ASSERT(simple_mpmc_data_ringbuffer_put_n(&test_ringbuf, data, 3) == 3);
+    ASSERT(simple_mpmc_data_ringbuffer_get(&test_ringbuf, rdata) == 1);
+    ASSERT(rdata[0] == data[0]);
+    ASSERT(simple_mpmc_data_ringbuffer_get_n(&test_ringbuf, rdata, 7) == 2);
+    ASSERT(rdata[0] == data[1] && rdata[1] == data[2]);
+    ASSERT(simple_mpmc_data_ringbuffer_is_empty(&test_ringbuf) == 1);
+
+    SUITE_END();
+}
+
+#if SIMPLE_RINGBUFFER_STATS
+static void test_mpmc_work_stats_odd(void)
+{
+    SUITE_START("test_mpmc_work_stats_odd");
+
+    SIMPLE_MPMC_DATA_RINGBUFFER_DEFINE(test_ringbuf, 7, sizeof(uint32_t));
+    SIMPLE_MPMC_DATA_RINGBUFFER_INIT(test_ringbuf, 7, sizeof(uint32_t));
+
+    simple_ringbuffer_stats_t stats;
+    uint32_t data[7] = {0};
+    void *mem;
+
+    ASSERT(simple_mpmc_data_ringbuffer_get(&test_ringbuf, data) == 0);
+    for (int i = 0; i < 7; i++)
+    {
+        ASSERT(simple_mpmc_data_ringbuffer_put(&test_ringbuf, data) == 1);
+    }
+    ASSERT(simple_mpmc_data_ringbuffer_put(&test_ringbuf, data) == 0);
+    ASSERT(simple_mpmc_data_ringbuffer_get_n(&test_ringbuf, data, 3) == 3);
+    // only 3 fit.
+    ASSERT(simple_mpmc_data_ringbuffer_put_n(&test_ringbuf, data, 5) == 3);
+    ASSERT(simple_mpmc_data_ringbuffer_enqueue_get(&test_ringbuf, &mem) == 0);
+    ASSERT(simple_mpmc_data_ringbuffer_get_n(&test_ringbuf, NULL, 7) == 7);
+    ASSERT(simple_mpmc_data_ringbuffer_dequeue_peek(&test_ringbuf) == NULL);
+    uint32_t commit = simple_mpmc_data_ringbuffer_enqueue_get(&test_ringbuf, &mem);
+    ASSERT(commit != 0);
+    simple_mpmc_data_ringbuffer_enqueue(&test_ringbuf, commit);
+    ASSERT(simple_mpmc_data_ringbuffer_dequeue_peek(&test_ringbuf) == mem);
+    simple_mpmc_data_ringbuffer_dequeue(&test_ringbuf);
+    ASSERT(simple_mpmc_data_ringbuffer_get_n(&test_ringbuf, data, 7) == 0);
+
+    simple_mpmc_data_ringbuffer_stats_snapshot(&test_ringbuf, &stats);
+    ASSERT(stats.put_items == 11);
+    ASSERT(stats.put_bytes == 11 * sizeof(uint32_t));
+    ASSERT(stats.put_full == 3);
+    ASSERT(stats.get_items == 11);
+    ASSERT(stats.get_bytes == 11 * sizeof(uint32_t));
+    ASSERT(stats.get_empty == 3);
+    ASSERT(stats.wraps == 1);
+    ASSERT(stats.high_water == 7);
+
+    SUITE_END();
+}
+#endif
+
+void test_mpmc_data_ringbuffer(void)
+{
+    test_mpmc_work();
+    test_mpmc_work_odd();
+    test_mpmc_work_thread();
+    test_mpmc_work_enqueue();
+    test_mpmc_work_enqueue_thread();
+    test_mpmc_work_n();
+#if SIMPLE_RINGBUFFER_STATS
+    test_mpmc_work_stats_odd();
+#endif
+}
@@ -0,0 +1,202 @@
+#include <stdio.h>
+#include <string.h>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include "simple_mpmc_pool.h"
+
+//
+// Tests
+//
+static const char *suite_name;
+static char suite_pass;
+static int suites_run = 0, suites_failed = 0, suites_empty = 0;
+static int tests_in_suite = 0, tests_run = 0, tests_failed = 0;
+
+#define QUOTE(str) #str
+#define ASSERT(x)                                                                                  \
+    {                                                                                              \
+        tests_run++;                                                                               \
+        tests_in_suite++;                                                                          \
+        if (!(x))                                                                                  \
+        {                                                                                          \
+            printf("failed assert [%s:%i] %s\n", __FILE__, __LINE__, QUOTE(x));                    \
+            suite_pass = 0;                                                                        \
+            tests_failed++;                                                                        \
+            while (1)                                                                              \
+                ;                                                                                  \
+        }                                                                                          \
+    }
+
+static void SUITE_START(const char *name)
+{
+    suite_pass = 1;
+    suite_name = name;
+    suites_run++;
+    tests_in_suite = 0;
+}
+
+static void SUITE_END(void)
+{
+    printf("Testing %s ", suite_name);
+    size_t suite_i;
+    for (suite_i = strlen(suite_name); suite_i < 80 - 8 - 5; suite_i++)
+        printf(".");
+    printf("%s\n", suite_pass ? " pass" : " fail");
+    if (!suite_pass)
+        suites_failed++;
+    if (!tests_in_suite)
+        suites_empty++;
+}
+
+#define TEST_USER_DATA_SIZE 0x40
+struct test_user_data
+{
+    uint32_t owner;
+    uint8_t data[TEST_USER_DATA_SIZE - 4];
+};
+
+#define TEST_BUFFER_SIZE_ODD 253
+
+static void test_mpmc_pool_work(void)
+{
+    SUITE_START("test_mpmc_pool_work");
+
+    SIMPLE_MPMC_POOL_DEFINE(test_pool, TEST_BUFFER_SIZE_ODD, sizeof(struct test_user_data));
+    SIMPLE_MPMC_POOL_INIT(test_pool, TEST_BUFFER_SIZE_ODD, sizeof(struct test_user_data));
+
+    static struct test_user_data *ptr_save[TEST_BUFFER_SIZE_ODD];
+    simple_mpmc_pool_cache_t cache;
+    simple_mpmc_pool_cache_init(&cache, &test_pool);
+
+    ASSERT(SIMPLE_MPMC_POOL_TOTAL_CNT(&test_pool) == TEST_BUFFER_SIZE_ODD);
+    ASSERT(SIMPLE_MPMC_POOL_ITEM_SIZE(&test_pool) == sizeof(struct test_user_data));
+    ASSERT(SIMPLE_MPMC_POOL_SIZE(&test_pool) == TEST_BUFFER_SIZE_ODD);
+
+    for (int round = 0; round < 3; round++)
+    {
+        // every block exactly once, then the pool is empty.
+        for (int loop = 0; loop < TEST_BUFFER_SIZE_ODD; loop++)
+        {
+            struct test_user_data *data = simple_mpmc_pool_alloc(&cache);
+            ASSERT(data != NULL);
+            ASSERT((uint8_t *)data >= (uint8_t *)test_pool_data_storage);
+            ASSERT((uint8_t *)data < (uint8_t *)test_pool_data_storage +
+                                             sizeof(test_pool_data_storage));
+            for (int i = 0; i < loop; i++)
+            {
+                ASSERT(ptr_save[i] != data);
+            }
+            memset(data->data, loop, sizeof(data->data));
+            ptr_save[loop] = data;
+        }
+        ASSERT(simple_mpmc_pool_alloc(&cache) == NULL);
+        ASSERT(SIMPLE_MPMC_POOL_SIZE(&test_pool) == 0);
+
+        for (int loop = 0; loop < TEST_BUFFER_SIZE_ODD; loop++)
+        {
+            ASSERT(ptr_save[loop]->data[0] == (uint8_t)loop);
+            simple_mpmc_pool_free(&cache, ptr_save[loop]);
+
+            // the cache never holds more than one magazine.
+            ASSERT(cache.count <= SIMPLE_MPMC_POOL_CACHE_SIZE);
+            ASSERT(SIMPLE_MPMC_POOL_SIZE(&test_pool) + cache.count == loop + 1);
+        }
+
+        simple_mpmc_pool_cache_flush(&cache);
+        ASSERT(cache.count == 0);
+        ASSERT(SIMPLE_MPMC_POOL_SIZE(&test_pool) == TEST_BUFFER_SIZE_ODD);
+    }
+
+#if SIMPLE_RINGBUFFER_STATS
+    // the initial blocks are not counted, every alloc went through a refill.
+    simple_ringbuffer_stats_t stats;
+    simple_mpmc_pool_stats_snapshot(&test_pool, &stats);
+    ASSERT(stats.get_items == 3 * TEST_BUFFER_SIZE_ODD);
+    ASSERT(stats.put_items == 3 * TEST_BUFFER_SIZE_ODD);
+    ASSERT(stats.get_empty == 3);
+    ASSERT(stats.high_water == TEST_BUFFER_SIZE_ODD);
+#endif
+
+    SUITE_END();
+}
+
+#define TEST_THREAD_CNT 4
+#define TEST_LOOP_CNT   20000
+#define TEST_BURST_CNT  40
+
+static simple_mpmc_pool_t *test_thread_pool;
+
+/*
+ * Each block is stamped with its owner and a per thread serial when it is allocated, and the
+ * stamp is checked just before it is freed: a block handed to two holders at once, or twice to
+ * the same one, loses its stamp during the hold. Runs outside the main thread, so failures are
+ * counted and returned instead of ASSERTed.
+ */
+static void *test_mpmc_pool_thread(void *arg)
+{
+    uint32_t owner = (uint32_t)(uintptr_t)arg;
+    struct test_user_data *burst[TEST_BURST_CNT];
+    uint32_t serial = 0;
+    uintptr_t errors = 0;
+    simple_mpmc_pool_cache_t cache;
+    simple_mpmc_pool_cache_init(&cache, test_thread_pool);
+
+    for (int loop = 0; loop < TEST_LOOP_CNT; loop++)
+    {
+        int cnt = 1 + loop % TEST_BURST_CNT;
+        for (int i = 0; i < cnt; i++)
+        {
+            while ((burst[i] = simple_mpmc_pool_alloc(&cache)) == NULL)
+            {
+                sched_yield();
+            }
+            burst[i]->owner = (owner << 24) | ((serial + i) & 0xffffff);
+        }
+        // nobody else may have taken a block during the whole hold.
+        for (int i = 0; i < cnt; i++)
+        {
+            errors += (burst[i]->owner != ((owner << 24) | ((serial + i) & 0xffffff)));
+            simple_mpmc_pool_free(&cache, burst[i]);
+        }
+        serial = (serial + cnt) & 0xffffff;
+    }
+    simple_mpmc_pool_cache_flush(&cache);
+
+    return (void *)errors;
+}
+
+static void test_mpmc_pool_work_thread(void)
+{
+    SUITE_START("test_mpmc_pool_work_thread");
+
+    SIMPLE_MPMC_POOL_DEFINE(test_pool, TEST_BUFFER_SIZE_ODD, sizeof(struct test_user_data));
+    SIMPLE_MPMC_POOL_INIT(test_pool, TEST_BUFFER_SIZE_ODD, sizeof(struct test_user_data));
+
+    pthread_t tid[TEST_THREAD_CNT];
+
+    test_thread_pool = &test_pool;
+    for (int i = 0; i < TEST_THREAD_CNT; i++)
+    {
+        ASSERT(pthread_create(&tid[i], NULL, test_mpmc_pool_thread, (void *)(uintptr_t)i) == 0);
+    }
+    for (int i = 0; i < TEST_THREAD_CNT; i++)
+    {
+        void *errors;
+
+        ASSERT(pthread_join(tid[i], &errors) == 0);
+        ASSERT(errors == NULL);
+    }
+
+    // all blocks are back.
+    ASSERT(SIMPLE_MPMC_POOL_SIZE(&test_pool) == TEST_BUFFER_SIZE_ODD);
+
+    SUITE_END();
+}
+
+void test_mpmc_pool(void)
+{
+    test_mpmc_pool_work();
+    test_mpmc_pool_work_thread();
+}
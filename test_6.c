@@ -0,0 +1,179 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "simple_data_ringbuffer_typed.h"
+
+//
+// Tests
+//
+static const char *suite_name;
+static char suite_pass;
+static int suites_run = 0, suites_failed = 0, suites_empty = 0;
+static int tests_in_suite = 0, tests_run = 0, tests_failed = 0;
+
+#define QUOTE(str) #str
+#define ASSERT(x)                                                                                  \
+    {                                                                                              \
+        tests_run++;                                                                               \
+        tests_in_suite++;                                                                          \
+        if (!(x))                                                                                  \
+        {                                                                                          \
+            printf("failed assert [%s:%i] %s\n", __FILE__, __LINE__, QUOTE(x));                    \
+            suite_pass = 0;                                                                        \
+            tests_failed++;                                                                        \
+            while (1)                                                                              \
+                ;                                                                                  \
+        }                                                                                          \
+    }
+
+static void SUITE_START(const char *name)
+{
+    suite_pass = 1;
+    suite_name = name;
+    suites_run++;
+    tests_in_suite = 0;
+}
+
+static void SUITE_END(void)
+{
+    printf("Testing %s ", suite_name);
+    size_t suite_i;
+    for (suite_i = strlen(suite_name); suite_i < 80 - 8 - 5; suite_i++)
+        printf(".");
+    printf("%s\n", suite_pass ? " pass" : " fail");
+    if (!suite_pass)
+        suites_failed++;
+    if (!tests_in_suite)
+        suites_empty++;
+}
+
+struct test_user_data
+{
+    uint32_t seq;
+    uint32_t check;
+    uint64_t stamp;
+};
+
+#define TEST_BUFFER_SIZE_POW2 64
+#define TEST_BUFFER_SIZE_ODD  61
+
+SIMPLE_DATA_RINGBUFFER_DECLARE_TYPED(test_typed_ring, struct test_user_data,
+                                     TEST_BUFFER_SIZE_POW2)
+SIMPLE_DATA_RINGBUFFER_DECLARE_TYPED(test_typed_ring_odd, struct test_user_data,
+                                     TEST_BUFFER_SIZE_ODD)
+
+static struct test_user_data test_item(uint32_t seq)
+{
+    struct test_user_data data = {.seq = seq, .check = ~seq, .stamp = (uint64_t)seq << 20};
+    return data;
+}
+
+static int test_item_ok(const struct test_user_data *data, uint32_t seq)
+{
+    return data->seq == seq && data->check == ~seq && data->stamp == (uint64_t)seq << 20;
+}
+
+static void test_typed_work(void)
+{
+    SUITE_START("test_typed_work");
+
+    static test_typed_ring_t test_ringbuf;
+    struct test_user_data data;
+    uint32_t put_loop = 0;
+    uint32_t get_loop = 0;
+
+    test_typed_ring_init(&test_ringbuf);
+    ASSERT(test_typed_ring_is_empty(&test_ringbuf) == 1);
+    ASSERT(test_typed_ring_peek(&test_ringbuf) == NULL);
+    ASSERT(test_typed_ring_get(&test_ringbuf, &data) == 0);
+
+    // the indices wrap many times.
+    for (int round = 0; round < 300; round++)
+    {
+        uint32_t n = (round * 37) % (TEST_BUFFER_SIZE_POW2 + 10);
+        uint32_t size = test_typed_ring_size(&test_ringbuf);
+        for (uint32_t i = 0; i < n; i++)
+        {
+            data = test_item(put_loop);
+            ASSERT(test_typed_ring_put(&test_ringbuf, &data) == (size + i < TEST_BUFFER_SIZE_POW2));
+            put_loop += (size + i < TEST_BUFFER_SIZE_POW2);
+        }
+        ASSERT(test_typed_ring_is_full(&test_ringbuf) == (size + n >= TEST_BUFFER_SIZE_POW2));
+
+        n = (round * 53) % (TEST_BUFFER_SIZE_POW2 + 10);
+        size = test_typed_ring_size(&test_ringbuf);
+        for (uint32_t i = 0; i < n; i++)
+        {
+            struct test_user_data *head = test_typed_ring_peek(&test_ringbuf);
+            ASSERT((head != NULL) == (i < size));
+            if (head == NULL)
+            {
+                break;
+            }
+            ASSERT(test_item_ok(head, get_loop));
+            // odd items are dropped after the peek.
+            ASSERT(test_typed_ring_get(&test_ringbuf, (i & 1) ? NULL : &data) == 1);
+            ASSERT((i & 1) || test_item_ok(&data, get_loop));
+            get_loop++;
+        }
+        ASSERT(test_typed_ring_size(&test_ringbuf) == put_loop - get_loop);
+    }
+
+    SUITE_END();
+}
+
+static void test_typed_work_odd(void)
+{
+    SUITE_START("test_typed_work_odd");
+
+    static test_typed_ring_odd_t test_ringbuf;
+    struct test_user_data data;
+    uint32_t put_loop = 0;
+    uint32_t get_loop = 0;
+
+    test_typed_ring_odd_init(&test_ringbuf);
+    ASSERT(test_typed_ring_odd_is_empty(&test_ringbuf) == 1);
+    ASSERT(test_typed_ring_odd_peek(&test_ringbuf) == NULL);
+    ASSERT(test_typed_ring_odd_get(&test_ringbuf, &data) == 0);
+
+    // the indices wrap many times.
+    for (int round = 0; round < 300; round++)
+    {
+        uint32_t n = (round * 37) % (TEST_BUFFER_SIZE_ODD + 10);
+        uint32_t size = test_typed_ring_odd_size(&test_ringbuf);
+        for (uint32_t i = 0; i < n; i++)
+        {
+            data = test_item(put_loop);
+            ASSERT(test_typed_ring_odd_put(&test_ringbuf, &data) ==
+                   (size + i < TEST_BUFFER_SIZE_ODD));
+            put_loop += (size + i < TEST_BUFFER_SIZE_ODD);
+        }
+        ASSERT(test_typed_ring_odd_is_full(&test_ringbuf) == (size + n >= TEST_BUFFER_SIZE_ODD));
+
+        n = (round * 53) % (TEST_BUFFER_SIZE_ODD + 10);
+        size = test_typed_ring_odd_size(&test_ringbuf);
+        for (uint32_t i = 0; i < n; i++)
+        {
+            struct test_user_data *head = test_typed_ring_odd_peek(&test_ringbuf);
+            ASSERT((head != NULL) == (i < size));
+            if (head == NULL)
+            {
+                break;
+            }
+            ASSERT(test_item_ok(head, get_loop));
+            // odd items are dropped after the peek.
+            ASSERT(test_typed_ring_odd_get(&test_ringbuf, (i & 1) ? NULL : &data) == 1);
+            ASSERT((i & 1) || test_item_ok(&data, get_loop));
+            get_loop++;
+        }
+        ASSERT(test_typed_ring_odd_size(&test_ringbuf) == put_loop - get_loop);
+    }
+
+    SUITE_END();
+}
+
+void test_typed_ringbuffer(void)
+{
+    test_typed_work();
+    test_typed_work_odd();
+}
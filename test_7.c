@@ -0,0 +1,184 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "simple_msg_ringbuffer.h"
+
+//
+// Tests
+//
+static const char *suite_name;
+static char suite_pass;
+static int suites_run = 0, suites_failed = 0, suites_empty = 0;
+static int tests_in_suite = 0, tests_run = 0, tests_failed = 0;
+
+#define QUOTE(str) #str
+#define ASSERT(x)                                                                                  \
+    {                                                                                              \
+        tests_run++;                                                                               \
+        tests_in_suite++;                                                                          \
+        if (!(x))                                                                                  \
+        {                                                                                          \
+            printf("failed assert [%s:%i] %s\n", __FILE__, __LINE__, QUOTE(x));                    \
+            suite_pass = 0;                                                                        \
+            tests_failed++;                                                                        \
+            while (1)                                                                              \
+                ;                                                                                  \
+        }                                                                                          \
+    }
+
+static void SUITE_START(const char *name)
+{
+    suite_pass = 1;
+    suite_name = name;
+    suites_run++;
+    tests_in_suite = 0;
+}
+
+static void SUITE_END(void)
+{
+    printf("Testing %s ", suite_name);
+    size_t suite_i;
+    for (suite_i = strlen(suite_name); suite_i < 80 - 8 - 5; suite_i++)
+        printf(".");
+    printf("%s\n", suite_pass ? " pass" : " fail");
+    if (!suite_pass)
+        suites_failed++;
+    if (!tests_in_suite)
+        suites_empty++;
+}
+
+#define TEST_BUFFER_SIZE     1000
+#define TEST_MSG_MAX_SIZE    300
+#define TEST_LOOP_CNT        5000
+
+static uint32_t test_msg_len(uint32_t seq)
+{
+    return (seq * 37 + seq / 7) % TEST_MSG_MAX_SIZE;
+}
+
+static void test_msg_fill(uint8_t *data, uint32_t seq)
+{
+    for (uint32_t i = 0; i < test_msg_len(seq); i++)
+    {
+        data[i] = (uint8_t)(seq + i);
+    }
+}
+
+static int test_msg_check(const uint8_t *data, uint32_t len, uint32_t seq)
+{
+    int ok = len == test_msg_len(seq);
+    for (uint32_t i = 0; ok && i < len; i++)
+    {
+        ok = data[i] == (uint8_t)(seq + i);
+    }
+    return ok;
+}
+
+static void test_msg_work(void)
+{
+    SUITE_START("test_msg_work");
+
+    SIMPLE_MSG_RINGBUFFER_DEFINE(test_msgbuf, TEST_BUFFER_SIZE);
+    SIMPLE_MSG_RINGBUFFER_INIT(test_msgbuf, TEST_BUFFER_SIZE);
+
+    uint32_t len;
+    ASSERT(simple_msg_ringbuffer_is_empty(&test_msgbuf) == 1);
+    ASSERT(simple_msg_ringbuffer_peek(&test_msgbuf, &len) == NULL);
+
+    // too big for the buffer, even empty.
+    ASSERT(simple_msg_ringbuffer_reserve(&test_msgbuf, TEST_BUFFER_SIZE - 3) == NULL);
+    ASSERT(simple_msg_ringbuffer_reserve(&test_msgbuf, 0xffffffff) == NULL);
+
+    uint32_t put_seq = 0;
+    uint32_t get_seq = 0;
+    for (int round = 0; round < TEST_LOOP_CNT; round++)
+    {
+        // fill until there is no contiguous room, in place or by copy.
+        uint8_t *payload;
+        while ((payload = simple_msg_ringbuffer_reserve(&test_msgbuf, test_msg_len(put_seq))))
+        {
+            ASSERT(((uintptr_t)payload & 3) == 0);
+            test_msg_fill(payload, put_seq);
+            simple_msg_ringbuffer_commit(&test_msgbuf, test_msg_len(put_seq));
+            put_seq++;
+            if (round & 1)
+            {
+                break;
+            }
+        }
+        ASSERT(simple_msg_ringbuffer_size(&test_msgbuf) <= TEST_BUFFER_SIZE);
+
+        // drain a part, messages come back in order and whole.
+        for (int i = 0; i < (round % 3) + 1; i++)
+        {
+            uint8_t *data = simple_msg_ringbuffer_peek(&test_msgbuf, &len);
+            ASSERT((data == NULL) == (get_seq == put_seq));
+            if (data == NULL)
+            {
+                break;
+            }
+            ASSERT(test_msg_check(data, len, get_seq));
+            simple_msg_ringbuffer_consume(&test_msgbuf);
+            get_seq++;
+        }
+    }
+    ASSERT(put_seq > TEST_LOOP_CNT);
+
+    while (simple_msg_ringbuffer_peek(&test_msgbuf, &len) != NULL)
+    {
+        simple_msg_ringbuffer_consume(&test_msgbuf);
+        get_seq++;
+    }
+    ASSERT(get_seq == put_seq);
+    ASSERT(simple_msg_ringbuffer_is_empty(&test_msgbuf) == 1);
+
+    SUITE_END();
+}
+
+static void test_msg_work_skip(void)
+{
+    SUITE_START("test_msg_work_skip");
+
+    SIMPLE_MSG_RINGBUFFER_DEFINE(test_msgbuf, TEST_BUFFER_SIZE);
+    SIMPLE_MSG_RINGBUFFER_INIT(test_msgbuf, TEST_BUFFER_SIZE);
+
+    uint8_t data[TEST_BUFFER_SIZE];
+    uint32_t len;
+    memset(data, 0x5a, sizeof(data));
+
+    // 600 + 4 bytes used, then move the read position behind it.
+    ASSERT(simple_msg_ringbuffer_put(&test_msgbuf, data, 600) == 1);
+    ASSERT(simple_msg_ringbuffer_peek(&test_msgbuf, &len) != NULL && len == 600);
+    simple_msg_ringbuffer_consume(&test_msgbuf);
+
+    // 396 bytes left before the end, the message goes to the beginning.
+    uint8_t *payload = simple_msg_ringbuffer_reserve(&test_msgbuf, 500);
+    ASSERT(payload == (uint8_t *)test_msgbuf_data_storage + sizeof(uint32_t));
+    // the skipped tail is published, the message is not yet.
+    ASSERT(simple_msg_ringbuffer_size(&test_msgbuf) == TEST_BUFFER_SIZE - 604);
+    ASSERT(simple_msg_ringbuffer_peek(&test_msgbuf, &len) == NULL);
+    ASSERT(simple_msg_ringbuffer_is_empty(&test_msgbuf) == 1);
+
+    // commit less than reserved.
+    memset(payload, 0xa5, 500);
+    simple_msg_ringbuffer_commit(&test_msgbuf, 123);
+    ASSERT(simple_msg_ringbuffer_size(&test_msgbuf) == SIMPLE_MSG_RINGBUFFER_RECORD_SIZE(123));
+    ASSERT(simple_msg_ringbuffer_peek(&test_msgbuf, &len) == payload && len == 123);
+
+    // the room behind it is contiguous up to the read position only.
+    ASSERT(simple_msg_ringbuffer_reserve(&test_msgbuf, TEST_BUFFER_SIZE - 128 - 4 + 1) == NULL);
+    ASSERT(simple_msg_ringbuffer_reserve(&test_msgbuf, TEST_BUFFER_SIZE - 128 - 4) != NULL);
+    simple_msg_ringbuffer_commit(&test_msgbuf, 0);
+    simple_msg_ringbuffer_consume(&test_msgbuf);
+    ASSERT(simple_msg_ringbuffer_peek(&test_msgbuf, &len) != NULL && len == 0);
+    simple_msg_ringbuffer_consume(&test_msgbuf);
+    ASSERT(simple_msg_ringbuffer_is_empty(&test_msgbuf) == 1);
+
+    SUITE_END();
+}
+
+void test_msg_ringbuffer(void)
+{
+    test_msg_work();
+    test_msg_work_skip();
+}
@@ -0,0 +1,132 @@
+#include <stdio.h>
+#include <string.h>
+
+#include <time.h>
+
+#include "simple_ringbuffer_wait.h"
+
+//
+// Tests
+//
+static const char *suite_name;
+static char suite_pass;
+static int suites_run = 0, suites_failed = 0, suites_empty = 0;
+static int tests_in_suite = 0, tests_run = 0, tests_failed = 0;
+
+#define QUOTE(str) #str
+#define ASSERT(x)                                                                                  \
+    {                                                                                              \
+        tests_run++;                                                                               \
+        tests_in_suite++;                                                                          \
+        if (!(x))                                                                                  \
+        {                                                                                          \
+            printf("failed assert [%s:%i] %s\n", __FILE__, __LINE__, QUOTE(x));                    \
+            suite_pass = 0;                                                                        \
+            tests_failed++;                                                                        \
+            while (1)                                                                              \
+                ;                                                                                  \
+        }                                                                                          \
+    }
+
+static void SUITE_START(const char *name)
+{
+    suite_pass = 1;
+    suite_name = name;
+    suites_run++;
+    tests_in_suite = 0;
+}
+
+static void SUITE_END(void)
+{
+    printf("Testing %s ", suite_name);
+    size_t suite_i;
+    for (suite_i = strlen(suite_name); suite_i < 80 - 8 - 5; suite_i++)
+        printf(".");
+    printf("%s\n", suite_pass ? " pass" : " fail");
+    if (!suite_pass)
+        suites_failed++;
+    if (!tests_in_suite)
+        suites_empty++;
+}
+
+#if defined(__linux__)
+#define TEST_BUFFER_SIZE_ODD 257
+#define TEST_TIMEOUT_MS      20
+
+static uint64_t test_now_ms(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static void test_wait_timeout(void)
+{
+    SUITE_START("test_wait_timeout");
+
+    static const simple_ringbuffer_wait_strategy_t strategies[] = {
+            SIMPLE_RINGBUFFER_WAIT_SPIN, SIMPLE_RINGBUFFER_WAIT_YIELD,
+            SIMPLE_RINGBUFFER_WAIT_FUTEX};
+
+    for (size_t s = 0; s < sizeof(strategies) / sizeof(strategies[0]); s++)
+    {
+        static uint8_t test_buffer[TEST_BUFFER_SIZE_ODD];
+        static uint32_t test_data_buffer[TEST_BUFFER_SIZE_ODD];
+        simple_ringbuffer_t test_ringbuf;
+        simple_data_ringbuffer_t test_data_ringbuf;
+        simple_ringbuffer_waiter_t waiter;
+        uint8_t data[TEST_BUFFER_SIZE_ODD + 10];
+        uint32_t item = 0;
+
+        simple_ringbuffer_init(&test_ringbuf, TEST_BUFFER_SIZE_ODD, test_buffer);
+        simple_data_ringbuffer_init(&test_data_ringbuf, TEST_BUFFER_SIZE_ODD, sizeof(uint32_t),
+                                    test_data_buffer);
+        simple_ringbuffer_waiter_init(&waiter, strategies[s]);
+
+        // empty: no wait, then a bounded wait.
+        ASSERT(simple_ringbuffer_get_wait(&test_ringbuf, &waiter, data, 10, 0) == 0);
+        uint64_t begin = test_now_ms();
+        ASSERT(simple_ringbuffer_get_wait(&test_ringbuf, &waiter, data, 10, TEST_TIMEOUT_MS) ==
+               0);
+        ASSERT(test_now_ms() - begin >= TEST_TIMEOUT_MS - 1);
+        ASSERT(simple_data_ringbuffer_get_wait(&test_data_ringbuf, &waiter, &item,
+                                               TEST_TIMEOUT_MS) == 0);
+
+        // full: a put of more than the room puts what fits before the timeout.
+        ASSERT(simple_ringbuffer_put_wait(&test_ringbuf, &waiter, data, sizeof(data),
+                                          TEST_TIMEOUT_MS) == TEST_BUFFER_SIZE_ODD);
+        ASSERT(simple_ringbuffer_is_full(&test_ringbuf) == 1);
+        begin = test_now_ms();
+        ASSERT(simple_ringbuffer_put_wait(&test_ringbuf, &waiter, data, 1, TEST_TIMEOUT_MS) == 0);
+        ASSERT(test_now_ms() - begin >= TEST_TIMEOUT_MS - 1);
+
+        // ready: no wait at all.
+        ASSERT(simple_ringbuffer_get_wait(&test_ringbuf, &waiter, data, sizeof(data), -1) ==
+               TEST_BUFFER_SIZE_ODD);
+        for (item = 0; item < TEST_BUFFER_SIZE_ODD; item++)
+        {
+            ASSERT(simple_data_ringbuffer_put_wait(&test_data_ringbuf, &waiter, &item, -1) == 1);
+        }
+        ASSERT(simple_data_ringbuffer_put_wait(&test_data_ringbuf, &waiter, &item, 0) == 0);
+        for (uint32_t i = 0; i < TEST_BUFFER_SIZE_ODD; i++)
+        {
+            ASSERT(simple_data_ringbuffer_get_wait(&test_data_ringbuf, &waiter, &item, -1) == 1);
+            ASSERT(item == i);
+        }
+        ASSERT(simple_data_ringbuffer_is_empty(&test_data_ringbuf) == 1);
+
+        // nobody parked, nothing to wake.
+        ASSERT(atomic_load(&waiter.not_empty.seq) == 0);
+        ASSERT(atomic_load(&waiter.not_full.seq) == 0);
+    }
+
+    SUITE_END();
+}
+#endif
+
+void test_wait_ringbuffer(void)
+{
+#if defined(__linux__)
+    test_wait_timeout();
+#endif
+}
@@ -0,0 +1,174 @@
+#include <stdio.h>
+#include <string.h>
+
+#include <poll.h>
+#include <unistd.h>
+
+#include "simple_ringbuffer_notify.h"
+
+//
+// Tests
+//
+static const char *suite_name;
+static char suite_pass;
+static int suites_run = 0, suites_failed = 0, suites_empty = 0;
+static int tests_in_suite = 0, tests_run = 0, tests_failed = 0;
+
+#define QUOTE(str) #str
+#define ASSERT(x)                                                                                  \
+    {                                                                                              \
+        tests_run++;                                                                               \
+        tests_in_suite++;                                                                          \
+        if (!(x))                                                                                  \
+        {                                                                                          \
+            printf("failed assert [%s:%i] %s\n", __FILE__, __LINE__, QUOTE(x));                    \
+            suite_pass = 0;                                                                        \
+            tests_failed++;                                                                        \
+            while (1)                                                                              \
+                ;                                                                                  \
+        }                                                                                          \
+    }
+
+static void SUITE_START(const char *name)
+{
+    suite_pass = 1;
+    suite_name = name;
+    suites_run++;
+    tests_in_suite = 0;
+}
+
+static void SUITE_END(void)
+{
+    printf("Testing %s ", suite_name);
+    size_t suite_i;
+    for (suite_i = strlen(suite_name); suite_i < 80 - 8 - 5; suite_i++)
+        printf(".");
+    printf("%s\n", suite_pass ? " pass" : " fail");
+    if (!suite_pass)
+        suites_failed++;
+    if (!tests_in_suite)
+        suites_empty++;
+}
+
+#if defined(__linux__)
+#define TEST_BUFFER_SIZE_ODD 257
+
+static int test_ready(int fd)
+{
+    struct pollfd pfd = {fd, POLLIN, 0};
+    return poll(&pfd, 1, 0) == 1 && (pfd.revents & POLLIN) != 0;
+}
+
+static uint64_t test_read(int fd)
+{
+    uint64_t cnt = 0;
+    if (read(fd, &cnt, sizeof(cnt)) != sizeof(cnt))
+    {
+        return 0;
+    }
+    return cnt;
+}
+
+static void test_notify_data_work_odd(void)
+{
+    SUITE_START("test_notify_data_work_odd");
+
+    static uint32_t test_data_buffer[TEST_BUFFER_SIZE_ODD];
+    simple_data_ringbuffer_t test_data_ringbuf;
+    simple_ringbuffer_notifier_t notifier;
+    uint32_t item;
+
+    simple_data_ringbuffer_init(&test_data_ringbuf, TEST_BUFFER_SIZE_ODD, sizeof(uint32_t),
+                                test_data_buffer);
+    ASSERT(simple_ringbuffer_notifier_init(&notifier) == 0);
+    ASSERT(test_ready(notifier.readable.fd) == 0);
+    ASSERT(test_ready(notifier.writable.fd) == 0);
+
+    // empty to non-empty: one eventfd write for a burst of puts.
+    for (item = 0; item < 10; item++)
+    {
+        ASSERT(simple_data_ringbuffer_put_notify(&test_data_ringbuf, &notifier, &item) == 1);
+    }
+    ASSERT(test_ready(notifier.readable.fd) == 1);
+    ASSERT(test_read(notifier.readable.fd) == 1);
+    ASSERT(simple_data_ringbuffer_put_notify(&test_data_ringbuf, &notifier, &item) == 1);
+    ASSERT(test_ready(notifier.readable.fd) == 0);
+
+    // drained: the failed get arms the edge again.
+    for (uint32_t i = 0; i <= 10; i++)
+    {
+        ASSERT(simple_data_ringbuffer_get_notify(&test_data_ringbuf, &notifier, &item) == 1);
+        ASSERT(item == i);
+    }
+    ASSERT(simple_data_ringbuffer_get_notify(&test_data_ringbuf, &notifier, &item) == 0);
+    ASSERT(test_ready(notifier.readable.fd) == 0);
+    ASSERT(simple_data_ringbuffer_put_notify(&test_data_ringbuf, &notifier, &item) == 1);
+    ASSERT(simple_data_ringbuffer_put_notify(&test_data_ringbuf, &notifier, &item) == 1);
+    ASSERT(test_read(notifier.readable.fd) == 1);
+
+    // full to not full.
+    while (simple_data_ringbuffer_put_notify(&test_data_ringbuf, &notifier, &item) == 1)
+    {
+    }
+    ASSERT(simple_data_ringbuffer_is_full(&test_data_ringbuf) == 1);
+    ASSERT(test_ready(notifier.writable.fd) == 0);
+    ASSERT(simple_data_ringbuffer_get_notify(&test_data_ringbuf, &notifier, NULL) == 1);
+    ASSERT(simple_data_ringbuffer_get_notify(&test_data_ringbuf, &notifier, NULL) == 1);
+    ASSERT(test_ready(notifier.writable.fd) == 1);
+    ASSERT(test_read(notifier.writable.fd) == 1);
+    ASSERT(test_ready(notifier.readable.fd) == 0);
+
+    simple_ringbuffer_notifier_deinit(&notifier);
+
+    SUITE_END();
+}
+
+static void test_notify_work_odd(void)
+{
+    SUITE_START("test_notify_work_odd");
+
+    static uint8_t test_buffer[TEST_BUFFER_SIZE_ODD];
+    simple_ringbuffer_t test_ringbuf;
+    simple_ringbuffer_notifier_t notifier;
+    uint8_t data[TEST_BUFFER_SIZE_ODD + 10];
+
+    for (uint32_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = (uint8_t)i;
+    }
+    simple_ringbuffer_init(&test_ringbuf, TEST_BUFFER_SIZE_ODD, test_buffer);
+    ASSERT(simple_ringbuffer_notifier_init(&notifier) == 0);
+
+    ASSERT(simple_ringbuffer_put_notify(&test_ringbuf, &notifier, data, 100) == 100);
+    ASSERT(simple_ringbuffer_put_notify(&test_ringbuf, &notifier, data + 100, 100) == 100);
+    ASSERT(test_read(notifier.readable.fd) == 1);
+
+    // a put of more than the room is short and arms the writable edge.
+    ASSERT(simple_ringbuffer_put_notify(&test_ringbuf, &notifier, data + 200, 100) ==
+           TEST_BUFFER_SIZE_ODD - 200);
+    ASSERT(test_ready(notifier.readable.fd) == 0);
+    ASSERT(test_ready(notifier.writable.fd) == 0);
+
+    // a short get drains the RINGBUF, signals the producer and arms the readable edge.
+    uint8_t rdata[TEST_BUFFER_SIZE_ODD + 10];
+    ASSERT(simple_ringbuffer_get_notify(&test_ringbuf, &notifier, rdata, sizeof(rdata)) ==
+           TEST_BUFFER_SIZE_ODD);
+    ASSERT(memcmp(rdata, data, TEST_BUFFER_SIZE_ODD) == 0);
+    ASSERT(test_read(notifier.writable.fd) == 1);
+    ASSERT(test_ready(notifier.readable.fd) == 0);
+    ASSERT(simple_ringbuffer_put_notify(&test_ringbuf, &notifier, data, 1) == 1);
+    ASSERT(test_read(notifier.readable.fd) == 1);
+
+    simple_ringbuffer_notifier_deinit(&notifier);
+
+    SUITE_END();
+}
+#endif
+
+void test_notify_ringbuffer(void)
+{
+#if defined(__linux__)
+    test_notify_work_odd();
+    test_notify_data_work_odd();
+#endif
+}